@@ -6,11 +6,40 @@
 #include <string>
 
 namespace API {
+  enum OverflowMode {
+    WRAP_OVERFLOW,      // two's complement wrapping
+    TRAP_OVERFLOW,      // checked arithmetic, traps on overflow
+    UNDEFINED_OVERFLOW  // signed overflow is undefined behaviour
+  };
+
+  // llvm fast-math flags put on floating point instructions
+  enum FastMathFlag : std::uint32_t {
+    FAST_MATH_NONE     = 0,
+    FAST_MATH_REASSOC  = 1 << 0,
+    FAST_MATH_NNAN     = 1 << 1,
+    FAST_MATH_NINF     = 1 << 2,
+    FAST_MATH_NSZ      = 1 << 3,
+    FAST_MATH_ARCP     = 1 << 4,
+    FAST_MATH_CONTRACT = 1 << 5,
+    FAST_MATH_AFN      = 1 << 6,
+    FAST_MATH_ALL      = (1 << 7) - 1
+  };
+
   extern bool DEBUG_SEGFAULT_IDENTIFY_PHASE;
   extern bool DUMP_DEBUG_INFO_FOR_STRUCS;
   extern bool ECHO_SYSTEM_COMMANDS;
+  extern bool STRICT_ALIASING;
+  extern bool STRIP_UNREACHABLE;
+  extern std::uintmax_t JOBS;
+  extern bool STREAM_FUNCTIONS;
+  extern OverflowMode OVERFLOW_MODE;
+  extern std::uint32_t FAST_MATH_FLAGS;
+  extern bool SET_MATH_ERRNO;
   constexpr std::uintmax_t CPU_BIT_SIZE = sizeof(void*) * 8;
   constexpr std::uintmax_t STRUCT_PASSED_AS_INLINE_SIZE_LIMIT = 128;
+  // budget of a compile-time function evaluation: loop iterations and calls, nested calls
+  constexpr std::uintmax_t CONSTANT_EVALUATION_STEP_LIMIT = 1 << 22;
+  constexpr std::uintmax_t CONSTANT_EVALUATION_DEPTH_LIMIT = 512;
   extern std::vector<std::string> INCLUDE_DIRECTORIES;
 }
 #endif//LARTC_API_CONFIG
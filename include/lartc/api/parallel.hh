@@ -0,0 +1,11 @@
+#ifndef LARTC_API_PARALLEL
+#define LARTC_API_PARALLEL
+#include <cstdint>
+#include <functional>
+
+namespace API {
+  // runs task(index) for each index in [0, count) on up to JOBS threads, taking the next index when
+  // a task is done, diagnostics are buffered per task and printed in index order
+  bool run_in_parallel(std::uintmax_t count, const std::function<bool(std::uintmax_t)>& task);
+}
+#endif//LARTC_API_PARALLEL
@@ -4,6 +4,7 @@
 #include <lartc/ast/type.hh>
 #include <lartc/ast/statement.hh>
 #include <vector>
+#include <utility>
 #include <cstdint>
 
 enum modifier_t {
@@ -12,6 +13,35 @@ enum modifier_t {
   MODIFIER_GLOBAL
 };
 
+// function attributes, stored as a bitmask inside of Declaration::attributes
+enum attribute_t : std::uint32_t {
+  ATTRIBUTE_NONE          = 0,
+  ATTRIBUTE_INLINE        = 1 << 0,
+  ATTRIBUTE_ALWAYS_INLINE = 1 << 1,
+  ATTRIBUTE_NOINLINE      = 1 << 2,
+  ATTRIBUTE_HOT           = 1 << 3,
+  ATTRIBUTE_COLD          = 1 << 4,
+  ATTRIBUTE_PURE          = 1 << 5,
+  ATTRIBUTE_NORETURN      = 1 << 6,
+  ATTRIBUTE_FAST_MATH     = 1 << 7
+};
+
+const char* attribute_name(attribute_t attribute);
+bool find_attribute(const std::string& name, attribute_t& attribute);
+// calls visitor with each pair of attributes that cannot be used together
+template<typename ConflictVisitor>
+inline void for_each_attribute_conflict(std::uint32_t attributes, ConflictVisitor visitor) {
+  const std::pair<attribute_t, attribute_t> conflicts[] = {
+    {ATTRIBUTE_INLINE, ATTRIBUTE_NOINLINE},
+    {ATTRIBUTE_ALWAYS_INLINE, ATTRIBUTE_NOINLINE},
+    {ATTRIBUTE_HOT, ATTRIBUTE_COLD},
+  };
+  for (const std::pair<attribute_t, attribute_t>& conflict : conflicts) {
+    if ((attributes & conflict.first) && (attributes & conflict.second))
+      visitor(conflict.first, conflict.second);
+  }
+}
+
 struct Declaration {
   declaration_t kind;
   std::vector<Declaration*> children;
@@ -23,6 +53,8 @@ struct Declaration {
   bool is_variadic;
   Expression* value;
   modifier_t modifier;
+  bool is_const;
+  std::uint32_t attributes;
 
   static Declaration* New(declaration_t kind);
   static std::ostream& Print(std::ostream& out, const Declaration* decl, std::uintmax_t tabulation = 0);
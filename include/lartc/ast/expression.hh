@@ -9,14 +9,18 @@
 
 struct Expression {
   expression_t kind;
+  operator_t operator_;
+  // a node carries at most one literal, the one of its kind
+  union {
+    bool boolean_literal;
+    std::intmax_t integer_literal;
+    double_t decimal_literal;
+  };
   Symbol symbol;
-  std::string string_literal;
-  bool boolean_literal;
-  std::intmax_t integer_literal;
-  double_t decimal_literal;
+  // only string literals own one, the other kinds do not pay for it inline
+  std::string* string_literal;
   Expression* callable;
   std::vector<Expression*> arguments;
-  operator_t operator_;
   Type* type;
   Expression* left;
   Expression* right;
@@ -25,6 +29,8 @@ struct Expression {
   static Expression* New(expression_t kind);
   static std::ostream& Print(std::ostream& out, const Expression* decl, bool parenthesized = false);
   static void Delete(Expression*& decl);
+  // frees the node alone, its children are left to the walk that reached it
+  static void DeleteNode(Expression* expr);
   static Expression* Clone(Expression* expr);
 };
 #endif//LARTC_AST_EXPRESSION
@@ -17,7 +17,11 @@
   X(SIZEOF_EXPR), \
   X(CAST_EXPR), \
   X(BITCAST_EXPR), \
-  X(VANEXT_EXPR)
+  X(VANEXT_EXPR), \
+  X(VECTOR_LOAD_EXPR), \
+  X(VECTOR_STORE_EXPR), \
+  X(VECTOR_SHUFFLE_EXPR), \
+  X(AGGREGATE_LITERAL_EXPR)
   
 enum expression_t {
 #define X(_) _
@@ -2,6 +2,7 @@
 #define LARTC_AST_FILE_DB
 #include <cstdint>
 #include <map>
+#include <vector>
 #include <lartc/ast/symbol.hh>
 #include <lartc/ast/expression.hh>
 #include <lartc/ast/type.hh>
@@ -12,19 +13,28 @@ struct FileDB {
   struct File {
     std::string filepath;
     char* source_code;
+    // first offset of the file in the location space shared by all files
+    std::uint32_t offset;
+    std::uint32_t size;
+    std::vector<std::uint32_t> line_starts;
 
     static std::ostream& Print(std::ostream& out, const File& file);
   };
+  // offset in the location space shared by all files, expanded to a Location only for diagnostics
   struct Point {
+    std::uint32_t offset;
+    std::uint32_t length;
+
+    static std::ostream& Print(std::ostream& out, const FileDB& file_db, const Point& point);
+    
+    static Point From(const FileDB* file_db, TSNode& ts_node);
+  };
+  struct Location {
     std::uintmax_t file;
     std::uintmax_t row;
     std::uintmax_t column;
     std::uintmax_t byte_start;
     std::uintmax_t byte_end;
-
-    static std::ostream& Print(std::ostream& out, const FileDB& file_db, const Point& point);
-    
-    static Point From(const FileDB* file_db, TSNode& ts_node);
   };
   
   std::map<Symbol*, Point> symbol_points;
@@ -34,6 +44,7 @@ struct FileDB {
   std::map<Statement*, Point> var_decl_points;
   std::map<Statement*, Point> return_points;
   std::vector<File> files;
+  Point unknown_point = {0, 0};
 
   File* add_file(const char* filepath);
   void add_symbol(Symbol* symbol, TSNode& node);
@@ -42,6 +53,12 @@ struct FileDB {
   void add_declaration(Declaration* declaration, TSNode& node);
   void add_var(Statement* var_decl, TSNode& node);
   void add_return(Statement* var_decl, TSNode& node);
+  Location locate(const Point& point) const;
+  // lookups never insert, so workers can share the maps; nodes built by the compiler may have no point
+  const Point& expression_point(Expression* expression) const;
+  const Point& symbol_point(Symbol* symbol) const;
+  const Point& type_point(Type* type) const;
+  const Point& return_point(Statement* return_stmt) const;
   inline std::uintmax_t current_file_index() const {
     return files.size() - 1;
   }
@@ -8,13 +8,14 @@
 
 struct Type {
   type_t kind;
-  std::uintmax_t size;
   bool is_signed;
+  bool is_variadic;
+  bool is_restrict;
+  std::uintmax_t size;
   Type* subtype;
   Symbol symbol;
   std::vector<std::pair<std::string, Type*>> fields;
   std::vector<std::pair<std::string, Type*>> parameters;
-  bool is_variadic;
 
   static Type* New(type_t kind);
   static Type* Clone(const Type* other);
@@ -10,7 +10,8 @@
   X(VOID_TYPE), \
   X(STRUCT_TYPE), \
   X(FUNCTION_TYPE), \
-  X(ARRAY_TYPE)
+  X(ARRAY_TYPE), \
+  X(VECTOR_TYPE)
 enum type_t {
   #define X(_) _
     TYPE_VARIANTS
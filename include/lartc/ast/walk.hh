@@ -0,0 +1,74 @@
+#ifndef LARTC_AST_WALK
+#define LARTC_AST_WALK
+#include <lartc/ast/expression.hh>
+#include <lartc/ast/statement.hh>
+#include <vector>
+
+/* Walks keep the pending nodes on an explicit stack instead of the call stack,
+ * so deeply nested machine generated code is bounded by memory and not by stack size.
+ * Nodes are visited in source order, each one after its children are pushed:
+ * the visitor may release the node it is given.
+ * */
+
+inline void push_expression_children(std::vector<Expression*>& stack, Expression* expr) {
+  if (expr->value != nullptr)
+    stack.push_back(expr->value);
+  if (expr->right != nullptr)
+    stack.push_back(expr->right);
+  if (expr->left != nullptr)
+    stack.push_back(expr->left);
+  for (auto it = expr->arguments.rbegin(); it != expr->arguments.rend(); ++it) {
+    if (*it != nullptr)
+      stack.push_back(*it);
+  }
+  if (expr->callable != nullptr)
+    stack.push_back(expr->callable);
+}
+
+template<typename ExpressionVisitor>
+inline void walk_expression(Expression* root, ExpressionVisitor visit_expression) {
+  if (root == nullptr) {
+    return;
+  }
+  std::vector<Expression*> stack = {root};
+  while (!stack.empty()) {
+    Expression* expr = stack.back();
+    stack.pop_back();
+    push_expression_children(stack, expr);
+    visit_expression(expr);
+  }
+}
+
+inline void push_statement_children(std::vector<Statement*>& stack, Statement* stmt) {
+  for (auto it = stmt->children.rbegin(); it != stmt->children.rend(); ++it) {
+    if (*it != nullptr)
+      stack.push_back(*it);
+  }
+  if (stmt->body != nullptr)
+    stack.push_back(stmt->body);
+  if (stmt->else_ != nullptr)
+    stack.push_back(stmt->else_);
+  if (stmt->then != nullptr)
+    stack.push_back(stmt->then);
+  if (stmt->init != nullptr)
+    stack.push_back(stmt->init);
+}
+
+// the expressions of a statement are walked before its child statements
+template<typename StatementVisitor, typename ExpressionVisitor>
+inline void walk_statement(Statement* root, StatementVisitor visit_statement, ExpressionVisitor visit_expression) {
+  if (root == nullptr) {
+    return;
+  }
+  std::vector<Statement*> stack = {root};
+  while (!stack.empty()) {
+    Statement* stmt = stack.back();
+    stack.pop_back();
+    push_statement_children(stack, stmt);
+    walk_expression(stmt->expr, visit_expression);
+    walk_expression(stmt->condition, visit_expression);
+    walk_expression(stmt->step, visit_expression);
+    visit_statement(stmt);
+  }
+}
+#endif//LARTC_AST_WALK
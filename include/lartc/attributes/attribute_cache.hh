@@ -0,0 +1,30 @@
+#ifndef LARTC_ATTRIBUTES_ATTRIBUTE_CACHE
+#define LARTC_ATTRIBUTES_ATTRIBUTE_CACHE
+#include <lartc/ast/declaration.hh>
+#include <map>
+#include <vector>
+
+// ordered from the strongest to the weakest guarantee
+enum memory_effect_t {
+  MEMORY_EFFECT_NONE,
+  MEMORY_EFFECT_READ,
+  MEMORY_EFFECT_WRITE
+};
+
+struct FunctionSummary {
+  bool nounwind;
+  bool norecurse;
+  bool willreturn;
+  memory_effect_t memory;
+  // one entry for each parameter, meaningful only for pointers
+  std::vector<bool> nocapture;
+};
+
+struct AttributeCache {
+  std::map<Declaration*, FunctionSummary> summaries;
+
+  const FunctionSummary* get_summary(Declaration* function) const;
+
+  static std::ostream& Print(std::ostream& out, AttributeCache& attribute_cache);
+};
+#endif//LARTC_ATTRIBUTES_ATTRIBUTE_CACHE
@@ -0,0 +1,12 @@
+#ifndef LARTC_ATTRIBUTES_INFER_ATTRIBUTES
+#define LARTC_ATTRIBUTES_INFER_ATTRIBUTES
+#include <lartc/ast/declaration.hh>
+#include <lartc/resolve/symbol_cache.hh>
+#include <lartc/typecheck/type_cache.hh>
+#include <lartc/attributes/attribute_cache.hh>
+
+bool infer_attributes(SymbolCache& symbol_cache, TypeCache& type_cache, AttributeCache& attribute_cache, Declaration* decl_tree);
+// summarizes a single function from the summaries of the callees inferred before it,
+// callees without a summary are treated as unknown calls
+bool infer_function_attributes(SymbolCache& symbol_cache, TypeCache& type_cache, AttributeCache& attribute_cache, Declaration* function);
+#endif//LARTC_ATTRIBUTES_INFER_ATTRIBUTES
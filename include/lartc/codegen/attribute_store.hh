@@ -0,0 +1,13 @@
+#ifndef LARTC__CODEGEN__ATTRIBUTE_STORE
+#define LARTC__CODEGEN__ATTRIBUTE_STORE
+#include <cstdint>
+#include <string>
+#include <map>
+
+struct AttributeStore {
+  // functions sharing the same attributes share the same attribute group
+  std::map<std::string, std::uintmax_t> groups;
+
+  std::uintmax_t get_attribute_group(const std::string& attributes);
+};
+#endif//LARTC__CODEGEN__ATTRIBUTE_STORE
@@ -5,7 +5,11 @@
 #include <lartc/typecheck/type_cache.hh>
 #include <lartc/typecheck/size_cache.hh>
 #include <lartc/constants/constant_cache.hh>
+#include <lartc/attributes/attribute_cache.hh>
 #include <lartc/codegen/literal_store.hh>
+#include <lartc/codegen/intrinsic_store.hh>
+#include <lartc/codegen/attribute_store.hh>
+#include <lartc/codegen/metadata_store.hh>
 
 struct CGContext {
   FileDB& file_db;
@@ -13,6 +17,10 @@ struct CGContext {
   TypeCache& type_cache;
   SizeCache& size_cache;
   ConstantCache& constant_cache;
+  AttributeCache& attribute_cache;
   LiteralStore& literal_store;
+  IntrinsicStore& intrinsic_store;
+  AttributeStore& attribute_store;
+  MetadataStore& metadata_store;
 };
 #endif//LARTC__CODEGEN__CG_CONTEXT
@@ -5,4 +5,8 @@
 #include <lartc/ast/declaration.hh>
 
 void emit_llvm(std::ostream& out, CGContext& context, Declaration* decl_tree);
+// the same output in steps, so that definitions can be emitted one at a time in between
+void emit_llvm_prologue(std::ostream& out, CGContext& context, Declaration* decl_tree);
+std::ostream& emit_function_definition(std::ostream& out, CGContext& context, Declaration* decl);
+void emit_llvm_epilogue(std::ostream& out, CGContext& context);
 #endif//LARTC__CODEGEN__EMIT_LLVM
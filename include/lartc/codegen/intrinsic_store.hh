@@ -0,0 +1,12 @@
+#ifndef LARTC__CODEGEN__INTRINSIC_STORE
+#define LARTC__CODEGEN__INTRINSIC_STORE
+#include <string>
+#include <set>
+
+struct IntrinsicStore {
+  // ordered, so that declarations are emitted deterministically
+  std::set<std::string> declarations;
+
+  std::string get_intrinsic(const std::string& return_type, const std::string& name, const std::string& parameter_types);
+};
+#endif//LARTC__CODEGEN__INTRINSIC_STORE
@@ -0,0 +1,29 @@
+#ifndef LARTC__CODEGEN__IR_WRITER
+#define LARTC__CODEGEN__IR_WRITER
+#include <cstdio>
+#include <memory>
+#include <streambuf>
+#include <string>
+
+// IR is appended to a large in-memory block, which reaches the file one whole block at a time
+struct IRWriter : public std::streambuf {
+  static constexpr std::size_t BLOCK_SIZE = 1 << 20;
+
+  std::FILE* file = nullptr;
+  std::unique_ptr<char[]> block;
+  bool ok = true;
+
+  bool open(const std::string& filepath);
+  // writes what is left in the block, true if every write succeeded
+  bool close();
+  ~IRWriter();
+
+protected:
+  int_type overflow(int_type ch) override;
+  std::streamsize xsputn(const char* data, std::streamsize size) override;
+  int sync() override;
+
+private:
+  void write_block();
+};
+#endif//LARTC__CODEGEN__IR_WRITER
@@ -1,5 +1,6 @@
 #ifndef LARTC__CODEGEN__LITERAL_STORE
 #define LARTC__CODEGEN__LITERAL_STORE
+#include <charconv>
 #include <string>
 #include <unordered_map>
 #include <cstdint>
@@ -12,11 +13,13 @@ struct LiteralStore {
   std::uintmax_t count = 1;
 
   inline std::string serialize(std::uintmax_t marker) {
-    return "@.l" + std::to_string(marker);
+    char buffer[24] = {'@', '.', 'l'};
+    char* end = std::to_chars(buffer + 3, buffer + sizeof(buffer), marker).ptr;
+    return std::string(buffer, end);
   }
 
   std::string get_string_literal(const std::string& literal);
   std::string get_int_literal(std::intmax_t literal);
-  std::string get_float_literal(double_t literal);
+  std::string get_float_literal(double_t literal, std::uintmax_t size = 64);
 };
 #endif//LARTC__CODEGEN__LITERAL_STORE
@@ -1,5 +1,6 @@
 #ifndef LARTC__CODEGEN__MARKERS
 #define LARTC__CODEGEN__MARKERS
+#include <charconv>
 #include <cstdint>
 #include <string>
 #include <unordered_map>
@@ -14,9 +15,14 @@ struct Markers {
   std::unordered_map<marker_key, std::uintmax_t> keyd;
   std::unordered_map<Statement*, std::uintmax_t> vars;
   std::unordered_map<std::pair<std::string, Type*>*, std::uintmax_t> params;
+  // stack slots needed by the body, emitted in the entry block ahead of it
+  std::string entry_allocas;
 
+  // short enough to stay in the inline storage of std::string
   inline std::string serialize(std::uintmax_t marker) {
-    return "%_" + std::to_string(marker);
+    char buffer[24] = {'%', '_'};
+    char* end = std::to_chars(buffer + 2, buffer + sizeof(buffer), marker).ptr;
+    return std::string(buffer, end);
   }
 
   std::string last_marker();
@@ -34,5 +40,7 @@ struct Markers {
   void add_param(std::pair<std::string, Type*>* param);
   std::string get_param(std::pair<std::string, Type*>* param);
   void clear_params();
+
+  std::string new_entry_slot(const std::string& type_specifier, std::uintmax_t alignment);
 };
 #endif//LARTC__CODEGEN__MARKERS
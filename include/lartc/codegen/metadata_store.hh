@@ -0,0 +1,23 @@
+#ifndef LARTC__CODEGEN__METADATA_STORE
+#define LARTC__CODEGEN__METADATA_STORE
+#include <lartc/ast/type.hh>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <map>
+
+struct MetadataStore {
+  // node N is emitted as `!N = nodes[N]`
+  std::vector<std::string> nodes;
+  // for every restrict parameter: its !alias.scope and its !noalias lists
+  std::map<std::pair<std::string, Type*>*, std::pair<std::uintmax_t, std::uintmax_t>> restrict_scopes;
+
+  // nodes that can be shared, indexed by their content
+  std::map<std::string, std::uintmax_t> unique_nodes;
+
+  std::uintmax_t add_node(const std::string& node);
+  std::uintmax_t add_unique_node(const std::string& node);
+  // emits `distinct !{!N<rest>}`, a node referencing itself
+  std::uintmax_t add_distinct_node(const std::string& rest);
+};
+#endif//LARTC__CODEGEN__METADATA_STORE
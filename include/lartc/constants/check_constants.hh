@@ -6,6 +6,16 @@
 #include <lartc/typecheck/size_cache.hh>
 #include <lartc/typecheck/type_cache.hh>
 #include <lartc/constants/constant_cache.hh>
+#include <cmath>
 
 bool check_constants(FileDB& file_db, SymbolCache& symbol_cache, SizeCache& size_cache, TypeCache& type_cache, ConstantCache& constant_cache, Declaration* decl_tree);
+// called by type checking once expr and its operands are typed, only the decision is fused:
+// the folding itself still runs in the constant phase, and emission in its own pass
+void mark_foldable_in_body(SymbolCache& symbol_cache, TypeCache& type_cache, Declaration* function, Expression* expr);
+// a float converts to an integer only when its truncation fits the integer type
+bool decimal_fits_in_integer(double_t decimal, std::uintmax_t size, bool is_signed);
+// bits of the truncation of a float that fits a 64 bit integer, zero otherwise
+std::intmax_t truncate_decimal_to_integer(double_t decimal);
+// folds a single function body, for the streaming pipeline
+void fold_function_constants(FileDB& file_db, SymbolCache& symbol_cache, SizeCache& size_cache, TypeCache& type_cache, ConstantCache& constant_cache, Declaration* function);
 #endif//LARTC_CONSTANTS_CHECK_CONSTANTS
@@ -4,10 +4,23 @@
 #include <lartc/ast/declaration.hh>
 #include <lartc/resolve/symbol_cache.hh>
 #include <map>
+#include <vector>
+
+// locals of a function evaluated at compile time
+struct ConstantFrame {
+  Declaration* function;
+  std::map<Statement*, Expression*> variables;
+  std::map<std::pair<std::string, Type*>*, Expression*> parameters;
+  Expression* return_value;
+};
 
 struct ConstantCache {
   std::map<Declaration*, Expression*> constants;
   std::map<Declaration*, bool> staging;
+  // maximal constant subexpressions of function bodies, folded to literals
+  std::map<Expression*, Expression*> folded;
+  std::vector<ConstantFrame> frames;
+  std::uintmax_t evaluation_steps = 0;
 
   static std::ostream& Print(std::ostream& out, ConstantCache& constant_cache);
   static void Delete(ConstantCache& constant_cache);
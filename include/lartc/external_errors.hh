@@ -13,57 +13,84 @@
 #include <lartc/ast/declaration.hh>
 #include <lartc/ast/file_db.hh>
 #include <lartc/ast/symbol.hh>
+#include <lartc/resolve/builtin.hh>
+#include <ostream>
+
+// Diagnostics are written to std::cerr unless the current thread buffers them
+std::ostream& diagnostic_stream();
+void redirect_diagnostics(std::ostream* stream);
 
 // Cst Checking
 void throw_syntax_error(const char* filepath, TSPoint& point, const char* node_symbol_name, const char* source_code, std::uintmax_t byte_start);
 void throw_parsed_integer_is_too_large(const char* filepath, TSPoint& point, const char* source_code, std::uintmax_t byte_start);
 void throw_extern_static_variables_cannot_have_a_defined_value(const char* filepath, TSPoint& point, const char* source_code, std::uintmax_t byte_start);
+void throw_unknown_function_attribute(const char* filepath, TSPoint& point, const std::string& name, const char* source_code, std::uintmax_t byte_start);
+void throw_conflicting_function_attributes(const char* filepath, TSPoint& point, const char* first, const char* second, const char* source_code, std::uintmax_t byte_start);
+void throw_vector_should_have_at_least_one_lane(const char* filepath, TSPoint& point, const char* source_code, std::uintmax_t byte_start);
 
 // Ast Formation
-void throw_duplicate_declaration_matches_name_but_not_kind(FileDB& file_db, FileDB::Point& older_point, FileDB::Point& latest_point);
-void throw_duplicate_type_definition_doesnt_match(FileDB& file_db, FileDB::Point& older_point, FileDB::Point& latest_point);
-void throw_duplicate_static_variable_definition(FileDB& file_db, FileDB::Point& older_point, FileDB::Point& latest_point);
-void throw_duplicate_function_definition(FileDB& file_db, FileDB::Point& older_point, FileDB::Point& latest_point);
-void throw_duplicate_function_declaration_return_type_doesnt_match(FileDB& file_db, FileDB::Point& older_point, FileDB::Point& latest_point);
-void throw_duplicate_function_declaration_parameter_types_dont_match(FileDB& file_db, FileDB::Point& older_point, FileDB::Point& latest_point);
-void throw_duplicate_function_declaration_wrong_parameter_number(FileDB& file_db, FileDB::Point& older_point, FileDB::Point& latest_point);
+void throw_duplicate_declaration_matches_name_but_not_kind(FileDB& file_db, const FileDB::Point& older_point, const FileDB::Point& latest_point);
+void throw_duplicate_type_definition_doesnt_match(FileDB& file_db, const FileDB::Point& older_point, const FileDB::Point& latest_point);
+void throw_duplicate_static_variable_definition(FileDB& file_db, const FileDB::Point& older_point, const FileDB::Point& latest_point);
+void throw_duplicate_function_definition(FileDB& file_db, const FileDB::Point& older_point, const FileDB::Point& latest_point);
+void throw_duplicate_function_declaration_return_type_doesnt_match(FileDB& file_db, const FileDB::Point& older_point, const FileDB::Point& latest_point);
+void throw_duplicate_function_declaration_parameter_types_dont_match(FileDB& file_db, const FileDB::Point& older_point, const FileDB::Point& latest_point);
+void throw_duplicate_function_declaration_wrong_parameter_number(FileDB& file_db, const FileDB::Point& older_point, const FileDB::Point& latest_point);
+void throw_duplicate_function_declaration_attributes_conflict(FileDB& file_db, const FileDB::Point& older_point, const FileDB::Point& latest_point, const char* first, const char* second);
 
 // Include Machanism
 void throw_unable_to_resolve_include_filepath(FileDB& file_db, const FileDB::Point& point, const std::string& filepath);
 
 // Name Resolution
-void throw_name_resolution_error(FileDB& file_db, FileDB::Point& point, Declaration* context, Symbol& symbol);
+void throw_name_resolution_error(FileDB& file_db, const FileDB::Point& point, Declaration* context, Symbol& symbol);
 
 // Decl Type Checking
-void throw_cyclic_dependency_between_types_is_not_protected_by_usage_of_pointers(FileDB& file_db, FileDB::Point& point, Declaration* type_decl, Declaration* requested_type_decl);
-void throw_a_type_definition_cannot_reference_a_non_type_declaration(FileDB& file_db, FileDB::Point& point, Declaration* type_decl, Declaration* non_type_decl);
+void throw_cyclic_dependency_between_types_is_not_protected_by_usage_of_pointers(FileDB& file_db, const FileDB::Point& point, Declaration* type_decl, Declaration* requested_type_decl);
+void throw_a_type_definition_cannot_reference_a_non_type_declaration(FileDB& file_db, const FileDB::Point& point, Declaration* type_decl, Declaration* non_type_decl);
+void throw_vector_element_type_should_be_a_scalar(FileDB& file_db, const FileDB::Point& point, Declaration* type_decl, Type* element_type);
 
 // Type Checking
-void throw_type_is_not_dereferenceable_error(FileDB& file_db, FileDB::Point& point, Declaration* context, Type* type);
-void throw_module_has_no_type_error(FileDB& file_db, FileDB::Point& point, Declaration* context, Symbol& symbol);
-void throw_type_cannot_be_algebraically_manipulated_error(FileDB& file_db, FileDB::Point& point, Declaration* context, Type* type);
-void throw_type_is_not_callable_error(FileDB& file_db, FileDB::Point& point, Declaration* context, Type* non_callable_type);
-void throw_wrong_parameter_number_error(FileDB& file_db, FileDB::Point& point, Declaration* context, Type* fn_type);
-void throw_type_is_not_implicitly_castable_to(FileDB& file_db, FileDB::Point& point, Declaration* context, Type* src_type, Type* dst_type);
-void throw_return_type_is_not_implicitly_castable_to(FileDB& file_db, FileDB::Point& point, Declaration* context, Type* src_type, Type* dst_type);
-void throw_right_operand_of_dot_operator_should_be_a_symbol(FileDB& file_db, FileDB::Point& point, Declaration* context);
-void throw_right_operand_of_arrow_operator_should_be_a_symbol(FileDB& file_db, FileDB::Point& point, Declaration* context);
-void throw_left_operand_of_array_access_should_be_a_pointer_or_an_array(FileDB& file_db, FileDB::Point& point, Declaration* context, Type* invalid_type);
-void throw_right_operand_of_array_access_should_be_an_integer(FileDB& file_db, FileDB::Point& point, Declaration* context, Type* invalid_type);
-void throw_left_operand_of_dot_operator_should_be_a_struct(FileDB& file_db, FileDB::Point& point, Declaration* context, Type* non_struct_type);
-void throw_struct_has_not_named_field(FileDB& file_db, FileDB::Point& point, Declaration* context, Type* struct_type, Symbol& field_name);
-void throw_left_operand_of_arrow_operator_should_be_a_pointer(FileDB& file_db, FileDB::Point& point, Declaration* context, Type* non_struct_type);
-void throw_pointed_left_operand_of_arrow_operator_should_be_a_struct(FileDB& file_db, FileDB::Point& point, Declaration* context, Type* non_struct_type);
-void throw_types_cannot_be_algebraically_manipulated_error(FileDB& file_db, FileDB::Point& point, Declaration* context, Type* left_type, Type* right_type);
-void throw_types_cannot_be_logically_manipulated_error(FileDB& file_db, FileDB::Point& point, Declaration* context, Type* left_type, Type* right_type);
-void throw_type_cannot_be_logically_manipulated_error(FileDB& file_db, FileDB::Point& point, Declaration* context, Type* type);
+void throw_type_is_not_dereferenceable_error(FileDB& file_db, const FileDB::Point& point, Declaration* context, Type* type);
+void throw_module_has_no_type_error(FileDB& file_db, const FileDB::Point& point, Declaration* context, Symbol& symbol);
+void throw_type_cannot_be_algebraically_manipulated_error(FileDB& file_db, const FileDB::Point& point, Declaration* context, Type* type);
+void throw_type_is_not_callable_error(FileDB& file_db, const FileDB::Point& point, Declaration* context, Type* non_callable_type);
+void throw_wrong_parameter_number_error(FileDB& file_db, const FileDB::Point& point, Declaration* context, Type* fn_type);
+void throw_type_is_not_implicitly_castable_to(FileDB& file_db, const FileDB::Point& point, Declaration* context, Type* src_type, Type* dst_type);
+void throw_return_type_is_not_implicitly_castable_to(FileDB& file_db, const FileDB::Point& point, Declaration* context, Type* src_type, Type* dst_type);
+void throw_right_operand_of_dot_operator_should_be_a_symbol(FileDB& file_db, const FileDB::Point& point, Declaration* context);
+void throw_right_operand_of_arrow_operator_should_be_a_symbol(FileDB& file_db, const FileDB::Point& point, Declaration* context);
+void throw_left_operand_of_array_access_should_be_a_pointer_or_an_array(FileDB& file_db, const FileDB::Point& point, Declaration* context, Type* invalid_type);
+void throw_right_operand_of_array_access_should_be_an_integer(FileDB& file_db, const FileDB::Point& point, Declaration* context, Type* invalid_type);
+void throw_left_operand_of_dot_operator_should_be_a_struct(FileDB& file_db, const FileDB::Point& point, Declaration* context, Type* non_struct_type);
+void throw_struct_has_not_named_field(FileDB& file_db, const FileDB::Point& point, Declaration* context, Type* struct_type, Symbol& field_name);
+void throw_left_operand_of_arrow_operator_should_be_a_pointer(FileDB& file_db, const FileDB::Point& point, Declaration* context, Type* non_struct_type);
+void throw_pointed_left_operand_of_arrow_operator_should_be_a_struct(FileDB& file_db, const FileDB::Point& point, Declaration* context, Type* non_struct_type);
+void throw_types_cannot_be_algebraically_manipulated_error(FileDB& file_db, const FileDB::Point& point, Declaration* context, Type* left_type, Type* right_type);
+void throw_types_cannot_be_logically_manipulated_error(FileDB& file_db, const FileDB::Point& point, Declaration* context, Type* left_type, Type* right_type);
+void throw_type_cannot_be_logically_manipulated_error(FileDB& file_db, const FileDB::Point& point, Declaration* context, Type* type);
+void throw_operand_should_be_a_vector(FileDB& file_db, const FileDB::Point& point, Declaration* context, Type* non_vector_type);
+void throw_vector_operands_should_have_the_same_type(FileDB& file_db, const FileDB::Point& point, Declaration* context, Type* left_type, Type* right_type);
+void throw_shuffle_mask_should_contain_constant_lane_indexes(FileDB& file_db, const FileDB::Point& point, Declaration* context, std::uintmax_t lanes);
+void throw_shuffle_mask_should_not_be_empty(FileDB& file_db, const FileDB::Point& point, Declaration* context);
+void throw_vector_pointer_should_point_to_the_element_type(FileDB& file_db, const FileDB::Point& point, Declaration* context, Type* pointer_type, Type* element_type);
+void throw_lane_of_boolean_vector_is_not_addressable(FileDB& file_db, const FileDB::Point& point, Declaration* context);
+void throw_wrong_builtin_argument_number(FileDB& file_db, const FileDB::Point& point, Declaration* context, builtin_t builtin);
+void throw_builtin_argument_has_wrong_type(FileDB& file_db, const FileDB::Point& point, Declaration* context, builtin_t builtin, Type* type, const char* expected);
+void throw_builtin_argument_should_be_an_integer_literal(FileDB& file_db, const FileDB::Point& point, Declaration* context, builtin_t builtin, std::intmax_t min, std::intmax_t max);
+void throw_aggregate_literal_type_should_be_an_array_or_a_struct(FileDB& file_db, const FileDB::Point& point, Declaration* context, Type* type);
+void throw_aggregate_literal_has_too_many_elements(FileDB& file_db, const FileDB::Point& point, Declaration* context, Type* type, std::uintmax_t capacity);
+void throw_constant_static_variable_cannot_be_assigned(FileDB& file_db, const FileDB::Point& point, Declaration* context, Declaration* constant);
+void throw_constant_static_variable_cannot_be_addressed(FileDB& file_db, const FileDB::Point& point, Declaration* context, Declaration* constant);
 
 // Constant checking
-void throw_expression_is_used_in_constant_context_but_is_not_constant(FileDB& file_db, FileDB::Point& point, Declaration* decl);
-void throw_cyclic_dependency_between_static_variables_is_not_protected_by_usage_of_pointers(FileDB& file_db, FileDB::Point& point, Declaration* static_var_decl, Declaration* requested_static_var_decl);
-void throw_constant_expression_is_not_implemented(FileDB& file_db, FileDB::Point& point, Declaration* decl);
-void throw_was_not_able_to_deduce_binexp_types(FileDB& file_db, FileDB::Point& point, Declaration* decl, Expression* left, Expression* right);
-void throw_was_not_able_to_deduce_monexp_types(FileDB& file_db, FileDB::Point& point, Declaration* decl, Expression* value);
+void throw_expression_is_used_in_constant_context_but_is_not_constant(FileDB& file_db, const FileDB::Point& point, Declaration* decl);
+void throw_cyclic_dependency_between_static_variables_is_not_protected_by_usage_of_pointers(FileDB& file_db, const FileDB::Point& point, Declaration* static_var_decl, Declaration* requested_static_var_decl);
+void throw_constant_expression_is_not_implemented(FileDB& file_db, const FileDB::Point& point, Declaration* decl);
+void throw_was_not_able_to_deduce_binexp_types(FileDB& file_db, const FileDB::Point& point, Declaration* decl, Expression* left, Expression* right);
+void throw_integer_overflow_in_constant_expression(FileDB& file_db, const FileDB::Point& point, Declaration* decl);
+void throw_float_does_not_fit_integer_in_constant_expression(FileDB& file_db, const FileDB::Point& point, Declaration* decl);
+void throw_was_not_able_to_deduce_monexp_types(FileDB& file_db, const FileDB::Point& point, Declaration* decl, Expression* value);
+void throw_constant_evaluation_exceeded_its_budget(FileDB& file_db, const FileDB::Point& point, Declaration* function);
 
-void throw_uncaught_type_checker_error(FileDB& file_db, FileDB::Point& point, Declaration* context, Expression* expr);
+void throw_uncaught_type_checker_error(FileDB& file_db, const FileDB::Point& point, Declaration* context, Expression* expr);
 #endif//LARTC_EXTERNAL_ERROR
@@ -19,7 +19,8 @@
   X(ATTEMPT_TO_CLONE_NULLPTR_AS_TYPE), \
   X(ATTEMPT_TO_CLONE_NULLPTR_AS_EXPRESSION), \
   X(ATTEMPT_TO_USE_OTHER_DECLARATION_AS_TYPEDEF), \
-  X(INCLUDE_DIRECTORY_SHOULD_HAVE_LOCAL_OR_GLOBAL_PATH)
+  X(INCLUDE_DIRECTORY_SHOULD_HAVE_LOCAL_OR_GLOBAL_PATH), \
+  X(SOURCE_FILES_EXCEED_LOCATION_SPACE)
 
 enum internal_error_t {
 #define X(_) _
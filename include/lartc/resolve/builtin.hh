@@ -0,0 +1,30 @@
+#ifndef LARTC_RESOLVE_BUILTIN
+#define LARTC_RESOLVE_BUILTIN
+#include <cstdint>
+#include <ostream>
+#include <lartc/ast/symbol.hh>
+#define BUILTIN_VARIANTS \
+    X(EXPECT_BUILTIN), \
+    X(PREFETCH_BUILTIN), \
+    X(ASSUME_BUILTIN), \
+    X(POPCOUNT_BUILTIN), \
+    X(CLZ_BUILTIN), \
+    X(CTZ_BUILTIN), \
+    X(ROTL_BUILTIN), \
+    X(ROTR_BUILTIN), \
+    X(FSHL_BUILTIN), \
+    X(FSHR_BUILTIN), \
+    X(MEMCPY_BUILTIN), \
+    X(MEMSET_BUILTIN)
+
+enum builtin_t {
+  #define X(_) _
+    BUILTIN_VARIANTS
+  #undef X
+};
+
+// builtins are reserved names, they are never shadowed by declarations
+bool find_builtin(const Symbol& symbol, builtin_t& builtin);
+std::ostream& operator<<(std::ostream& out, builtin_t builtin);
+std::uintmax_t get_builtin_arity(builtin_t builtin);
+#endif//LARTC_RESOLVE_BUILTIN
@@ -2,6 +2,8 @@
 #define LARTC_RESOLVE_RESOLVE_SYMBOLS
 #include <lartc/resolve/symbol_cache.hh>
 #include <lartc/ast/file_db.hh>
+#include <vector>
 
 bool resolve_symbols(FileDB& file_db, SymbolCache& symbol_cache, Declaration* decl);
+bool resolve_function_bodies(FileDB& file_db, SymbolCache& symbol_cache, const std::vector<Declaration*>& functions);
 #endif//LARTC_RESOLVE_RESOLVE_SYMBOLS
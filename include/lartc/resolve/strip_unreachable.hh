@@ -0,0 +1,11 @@
+#ifndef LARTC_RESOLVE_STRIP_UNREACHABLE
+#define LARTC_RESOLVE_STRIP_UNREACHABLE
+#include <lartc/resolve/symbol_cache.hh>
+#include <lartc/ast/file_db.hh>
+#include <vector>
+
+// resolves the bodies of the functions reached from global declarations or main, and
+// detaches the functions and statics without modifier that are never reached
+// the detached declarations are owned by the caller
+bool strip_unreachable(FileDB& file_db, SymbolCache& symbol_cache, Declaration* decl_tree, std::vector<Declaration*>& stripped);
+#endif//LARTC_RESOLVE_STRIP_UNREACHABLE
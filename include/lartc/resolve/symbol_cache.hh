@@ -4,13 +4,18 @@
 #include <lartc/ast/statement.hh>
 #include <lartc/ast/symbol.hh>
 #include <lartc/resolve/symbol_stack.hh>
+#include <lartc/resolve/builtin.hh>
 #include <lartc/ast/file_db.hh>
 #include <map>
+#include <shared_mutex>
 
 struct SymbolCache {
   std::map<Declaration*, std::map<Symbol, Declaration*>> globals;
   std::map<Expression*, Statement*> locals;
   std::map<Expression*, std::pair<std::string, Type*>*> parameters;
+  std::map<Expression*, builtin_t> builtins;
+  // guards globals, as type checking threads may still find declarations
+  mutable std::shared_mutex globals_mutex;
 
   Declaration* find_by_going_up(Declaration* context, Symbol& symbol, std::uintmax_t progress = 0);
   Declaration* find_by_going_down(Declaration* context, Symbol& symbol, std::uintmax_t progress = 0);
@@ -26,6 +31,12 @@ struct SymbolCache {
   // Here context is the symbol
   std::pair<std::string, Type*>* get_parameter(Expression* context) const;
 
+  const builtin_t* get_or_find_builtin(Expression* expression, Symbol& symbol);
+  // Here context is the callable
+  const builtin_t* get_builtin(Expression* context) const;
+
   static std::ostream& Print(std::ostream& out, FileDB& file_db, SymbolCache& symbol_cache);
+  // moves the resolutions of a shard into symbol_cache
+  static void Merge(SymbolCache& symbol_cache, SymbolCache& shard);
 };
 #endif//LARTC_RESOLVE_SYMBOL_CACHE
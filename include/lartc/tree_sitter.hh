@@ -3,20 +3,130 @@
 #include <tree_sitter/api.h>
 #include <lartc/internal_errors.hh>
 #include <lartc/ast/file_db.hh>
+#include <cstdint>
 #include <cstring>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 inline std::string ts_node_source_code(TSNode& node, const char* source_code) {
   return std::string(source_code + ts_node_start_byte(node), ts_node_end_byte(node) - ts_node_start_byte(node));
 }
 
-inline TSNode ts_node_child_by_field_name(TSNode self, const char *name) {
-  return ts_node_child_by_field_name(self, name, std::strlen(name));
+// fields of the lart and C grammars, as member and grammar name
+#define TS_FIELD_VARIANTS \
+  X(arguments, "arguments") \
+  X(attributes, "attributes") \
+  X(body, "body") \
+  X(callable, "callable") \
+  X(condition, "condition") \
+  X(const_, "const") \
+  X(declarator, "declarator") \
+  X(elements, "elements") \
+  X(else_, "else") \
+  X(fields, "fields") \
+  X(globalpath, "globalpath") \
+  X(init, "init") \
+  X(left, "left") \
+  X(length, "length") \
+  X(localpath, "localpath") \
+  X(mask, "mask") \
+  X(modifier, "modifier") \
+  X(name, "name") \
+  X(offset, "offset") \
+  X(operator_, "operator") \
+  X(parameters, "parameters") \
+  X(pointer, "pointer") \
+  X(restrict, "restrict") \
+  X(right, "right") \
+  X(signed_, "signed") \
+  X(size, "size") \
+  X(step, "step") \
+  X(then, "then") \
+  X(type, "type") \
+  X(value, "value")
+
+// field ids are looked up once per language instead of by name on each access
+struct TSFieldIds {
+#define X(member, _) TSFieldId member;
+  TS_FIELD_VARIANTS
+#undef X
+};
+
+inline TSFieldIds ts_resolve_field_ids(const TSLanguage* language) {
+  TSFieldIds fields;
+#define X(member, name) fields.member = ts_language_field_id_for_name(language, name, std::strlen(name));
+  TS_FIELD_VARIANTS
+#undef X
+  return fields;
+}
+
+// grammar symbols of the lart language compared outside of the dispatch tables
+#define TS_SYMBOL_VARIANTS \
+  X(error, "ERROR") \
+  X(line_comment, "line_comment") \
+  X(block_comment, "block_comment") \
+  X(source_file, "source_file") \
+  X(include, "include") \
+  X(variadic_parameter, "variadic_parameter") \
+  X(extern_modifier, "extern_modifier") \
+  X(global_modifier, "global_modifier") \
+  X(binary_expression, "binary_expression") \
+  X(callable_binary_expression, "callable_binary_expression")
+
+struct TSSymbolIds {
+#define X(member, _) TSSymbol member;
+  TS_SYMBOL_VARIANTS
+#undef X
+};
+
+inline TSSymbolIds ts_resolve_symbol_ids(const TSLanguage* language) {
+  TSSymbolIds symbols;
+#define X(member, name) symbols.member = ts_language_symbol_for_name(language, name, std::strlen(name), true);
+  TS_SYMBOL_VARIANTS
+#undef X
+  return symbols;
+}
+
+// dense table indexed by grammar symbol, resolved once from a table of handlers by symbol name
+template<typename Handler>
+inline std::vector<Handler> ts_build_dispatch_table(const TSLanguage* language, const std::unordered_map<std::string, Handler>& handlers) {
+  std::vector<Handler> table(ts_language_symbol_count(language), nullptr);
+  for (TSSymbol symbol = 0; symbol < table.size(); ++symbol) {
+    auto it = handlers.find(ts_language_symbol_name(language, symbol));
+    if (it != handlers.end()) {
+      table[symbol] = it->second;
+    }
+  }
+  return table;
+}
+
+template<typename Handler>
+inline Handler ts_dispatch(const std::vector<Handler>& table, TSSymbol symbol) {
+  return symbol < table.size() ? table[symbol] : nullptr;
+}
+
+// visits the named children of node, walking the siblings once instead of indexing each of them
+template<typename Visitor>
+inline void ts_for_each_named_child(TSNode node, Visitor visitor, std::uintmax_t from_index = 0) {
+  if (node.id == nullptr) {
+    return;
+  }
+  TSTreeCursor cursor = ts_tree_cursor_new(node);
+  std::uintmax_t named_index = 0;
+  if (ts_tree_cursor_goto_first_child(&cursor)) {
+    do {
+      TSNode child = ts_tree_cursor_current_node(&cursor);
+      if (ts_node_is_named(child) && named_index++ >= from_index) {
+        visitor(child);
+      }
+    } while (ts_tree_cursor_goto_next_sibling(&cursor));
+  }
+  ts_tree_cursor_delete(&cursor);
 }
 
-inline bool ts_can_ignore(const char* symbol_name) {
-  return (std::strcmp(symbol_name, "line_comment") == 0
-       || std::strcmp(symbol_name, "block_comment") == 0);
+inline bool ts_can_ignore(const TSSymbolIds& symbols, TSSymbol symbol) {
+  return symbol == symbols.line_comment || symbol == symbols.block_comment;
 }
 
 inline void ts_validate_parsing(const TSLanguage* language, TSNode& node, const char* context, void* parsed) {
@@ -35,6 +145,8 @@ inline void ts_validate_parsing(const TSLanguage* language, TSNode& node, const
 
 struct TSContext {
   const TSLanguage* language;
+  TSFieldIds fields;
+  TSSymbolIds symbols;
   const char* source_code;
   const char* filepath;
   FileDB* file_db;
@@ -6,5 +6,7 @@
 #include <lartc/ast/declaration.hh>
 
 bool check_types(FileDB& file_db, SymbolCache& symbol_cache, TypeCache& type_cache, Declaration* decl_tree);
+// checks a single function body once, for the streaming pipeline
+bool check_function_types(FileDB& file_db, SymbolCache& symbol_cache, TypeCache& type_cache, Declaration* function);
 #endif//LARTC_AST_TYPECHECK_CHECK_TYPES
 
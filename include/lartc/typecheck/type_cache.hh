@@ -2,13 +2,21 @@
 #define LARTC_TYPECHECK_TYPE_CACHE
 #include <lartc/ast/expression.hh>
 #include <lartc/ast/type.hh>
+#include <lartc/ast/declaration.hh>
 #include <map>
+#include <set>
 
 struct TypeCache {
   std::map<Expression*, Type*> expression_types;
+  // outcome of the bodies checked one at a time
+  std::map<Declaration*, bool> checked_functions;
+  // body expressions whose value is known at compile time, decided while typing them
+  std::set<Expression*> foldable;
 
   static std::ostream& Print(std::ostream& out, TypeCache& type_cache);
   static void Delete(TypeCache& type_cache);
+  // moves the types of a shard into type_cache
+  static void Merge(TypeCache& type_cache, TypeCache& shard);
 };
 #endif//LARTC_TYPECHECK_TYPE_CACHE
 
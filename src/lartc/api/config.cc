@@ -1,6 +1,15 @@
 #include <lartc/api/config.hh>
+#include <algorithm>
+#include <thread>
 
 bool API::DEBUG_SEGFAULT_IDENTIFY_PHASE = false;
 bool API::DUMP_DEBUG_INFO_FOR_STRUCS = false;
 bool API::ECHO_SYSTEM_COMMANDS = false;
+bool API::STRICT_ALIASING = false;
+bool API::STRIP_UNREACHABLE = true;
+bool API::STREAM_FUNCTIONS = false;
+std::uintmax_t API::JOBS = std::max(1u, std::thread::hardware_concurrency());
+API::OverflowMode API::OVERFLOW_MODE = API::WRAP_OVERFLOW;
+std::uint32_t API::FAST_MATH_FLAGS = API::FAST_MATH_NONE;
+bool API::SET_MATH_ERRNO = true;
 std::vector<std::string> API::INCLUDE_DIRECTORIES = {"/usr/include/", "/usr/local/include/"};
@@ -40,6 +40,8 @@ void crash_on_line(const std::string& line, const std::string& msg) {
 
 void explore(const TSLanguage* language, const char* source_code, Declaration* scope, TSNode& node);
 
+TSFieldIds c_fields;
+
 std::string remove_piece(const std::string& line, const char* piece) {
   std::uintmax_t len = strlen(piece);
   std::uintmax_t i = len;
@@ -132,28 +134,26 @@ Type* interpret_as_struct_specifier(const TSLanguage* language, const char* sour
               (field_declaration type: (primitive_type) declarator: (field_identifier))))
    * */
   Type* struct_type = Type::New(STRUCT_TYPE);
-  TSNode body = ts_node_child_by_field_name(node, "body");
+  TSNode body = ts_node_child_by_field_id(node, c_fields.body);
   if (body.id != nullptr) {
-    std::uintmax_t length = ts_node_named_child_count(body);
-    for (std::uintmax_t i = 0; i < length; ++i) {
-      TSNode field_node = ts_node_named_child(body, i);
-      TSNode type_node = ts_node_child_by_field_name(field_node, "type");
+    ts_for_each_named_child(body, [&](TSNode field_node) {
+      TSNode type_node = ts_node_child_by_field_id(field_node, c_fields.type);
       assert(type_node.id != nullptr);
-      TSNode declarator_node = ts_node_child_by_field_name(field_node, "declarator");
+      TSNode declarator_node = ts_node_child_by_field_id(field_node, c_fields.declarator);
       assert(declarator_node.id != nullptr);
       Type* type = interpret_as_type(language, source_code, scope, type_node);
       while (strcmp(ts_language_symbol_name(language, ts_node_symbol(declarator_node)), "pointer_declarator") == 0) {
         Type* ptr = Type::New(POINTER_TYPE);
         ptr->subtype = type;
         type = ptr;
-        declarator_node = ts_node_child_by_field_name(declarator_node, "declarator");
+        declarator_node = ts_node_child_by_field_id(declarator_node, c_fields.declarator);
       }
       std::string name = ts_node_source_code(declarator_node, source_code);
       struct_type->fields.push_back({name, type});
-    }
+    });
   }
   
-  TSNode name = ts_node_child_by_field_name(node, "name");
+  TSNode name = ts_node_child_by_field_id(node, c_fields.name);
   if (name.id != nullptr) {
     Declaration* type_decl = Declaration::New(TYPE_DECL);
     type_decl->type = struct_type;
@@ -169,7 +169,7 @@ Type* interpret_as_struct_specifier(const TSLanguage* language, const char* sour
 
 Type* interpret_as_enum_specifier(const TSLanguage* /*language*/, const char* source_code, Declaration* scope, TSNode& node) {
   Type* enum_type = interpret_as_primitive_type("int");
-  TSNode name = ts_node_child_by_field_name(node, "name");
+  TSNode name = ts_node_child_by_field_id(node, c_fields.name);
   if (name.id != nullptr) {
     Declaration* type_decl = Declaration::New(TYPE_DECL);
     type_decl->type = enum_type;
@@ -208,16 +208,16 @@ Type* interpret_as_type(const TSLanguage* language, const char* source_code, Dec
 }
 
 void explore_as_type_definition(const TSLanguage* language, const char* source_code, Declaration* scope, TSNode& node) {
-  TSNode type_node = ts_node_child_by_field_name(node, "type");
+  TSNode type_node = ts_node_child_by_field_id(node, c_fields.type);
   assert(type_node.id != nullptr);
-  TSNode declarator_node = ts_node_child_by_field_name(node, "declarator");
+  TSNode declarator_node = ts_node_child_by_field_id(node, c_fields.declarator);
   assert(declarator_node.id != nullptr);
   Type* type = interpret_as_type(language, source_code, scope, type_node);
   while (strcmp(ts_language_symbol_name(language, ts_node_symbol(declarator_node)), "pointer_declarator") == 0) {
     Type* ptr = Type::New(POINTER_TYPE);
     ptr->subtype = type;
     type = ptr;
-    declarator_node = ts_node_child_by_field_name(declarator_node, "declarator");
+    declarator_node = ts_node_child_by_field_id(declarator_node, c_fields.declarator);
   }
   std::string name = ts_node_source_code(declarator_node, source_code);
   Declaration* type_decl = Declaration::New(TYPE_DECL);
@@ -227,11 +227,11 @@ void explore_as_type_definition(const TSLanguage* language, const char* source_c
 }
 
 void explore_as_function_declaration(const TSLanguage* language, const char* source_code, Declaration* scope, TSNode& node) {
-  TSNode type_node = ts_node_child_by_field_name(node, "type");
+  TSNode type_node = ts_node_child_by_field_id(node, c_fields.type);
   assert(type_node.id != nullptr);
-  TSNode function_declarator_node = ts_node_child_by_field_name(node, "declarator");
+  TSNode function_declarator_node = ts_node_child_by_field_id(node, c_fields.declarator);
   assert(function_declarator_node.id != nullptr);
-  TSNode declarator_node = ts_node_child_by_field_name(function_declarator_node, "declarator");
+  TSNode declarator_node = ts_node_child_by_field_id(function_declarator_node, c_fields.declarator);
   assert(declarator_node.id != nullptr);
 
   Type* type = interpret_as_type(language, source_code, scope, type_node);
@@ -242,20 +242,18 @@ void explore_as_function_declaration(const TSLanguage* language, const char* sou
     Type* ptr = Type::New(POINTER_TYPE);
     ptr->subtype = func_decl->type;
     func_decl->type = ptr;
-    function_declarator_node = ts_node_child_by_field_name(function_declarator_node, "declarator");
-    declarator_node = ts_node_child_by_field_name(function_declarator_node, "declarator");
+    function_declarator_node = ts_node_child_by_field_id(function_declarator_node, c_fields.declarator);
+    declarator_node = ts_node_child_by_field_id(function_declarator_node, c_fields.declarator);
   }
   std::string name = ts_node_source_code(declarator_node, source_code);
   func_decl->name = name;
 
-  TSNode parameters = ts_node_child_by_field_name(function_declarator_node, "parameters");
+  TSNode parameters = ts_node_child_by_field_id(function_declarator_node, c_fields.parameters);
   if (parameters.id != nullptr) {
-    std::uintmax_t length = ts_node_named_child_count(parameters);
-    for (std::uintmax_t i = 0; i < length; ++i) {
-      TSNode parameter_node = ts_node_named_child(parameters, i);
-      TSNode type_node = ts_node_child_by_field_name(parameter_node, "type");
+    ts_for_each_named_child(parameters, [&](TSNode parameter_node) {
+      TSNode type_node = ts_node_child_by_field_id(parameter_node, c_fields.type);
       assert(type_node.id != nullptr);
-      TSNode declarator_node = ts_node_child_by_field_name(parameter_node, "declarator");
+      TSNode declarator_node = ts_node_child_by_field_id(parameter_node, c_fields.declarator);
       Type* type = interpret_as_type(language, source_code, scope, type_node);
       std::string name = "_";
       if (declarator_node.id != nullptr) {
@@ -268,13 +266,13 @@ void explore_as_function_declaration(const TSLanguage* language, const char* sou
             Type* ptr = Type::New(POINTER_TYPE);
             ptr->subtype = type;
             type = ptr;
-            declarator_node = ts_node_child_by_field_name(declarator_node, "declarator");
+            declarator_node = ts_node_child_by_field_id(declarator_node, c_fields.declarator);
           }
           name = ts_node_source_code(declarator_node, source_code);
         }
       }
       func_decl->parameters.push_back({name, type});
-    }
+    });
     scope->children.push_back(func_decl);
   } else {
     std::string symbol_name = ts_language_symbol_name(language, ts_node_symbol(node));
@@ -283,11 +281,9 @@ void explore_as_function_declaration(const TSLanguage* language, const char* sou
 }
  
 void explore_as_scope(const TSLanguage* language, const char* source_code, Declaration* scope, TSNode& node) {
-  std::uintmax_t n_of_children = ts_node_named_child_count(node);
-  for (std::uintmax_t i = 0; i < n_of_children; ++i) {
-    TSNode child = ts_node_named_child(node, i);
+  ts_for_each_named_child(node, [&](TSNode child) {
     explore(language, source_code, scope, child);
-  }
+  });
 }
 
 void explore_as_struct_specifier(const TSLanguage* language, const char* source_code, Declaration* scope, TSNode& node) {
@@ -313,11 +309,12 @@ std::unordered_map<std::string, explorer> explorers = {
 
 void explore(const TSLanguage* language, const char* source_code, Declaration* scope, TSNode& node) {
   assert(node.id != nullptr);
-  std::string symbol_name = ts_language_symbol_name(language, ts_node_grammar_symbol(node));
-  auto it = explorers.find(symbol_name);
-  if (it != explorers.end()) {
-    it->second(language, source_code, scope, node);
+  static const std::vector<explorer> dispatch_table = ts_build_dispatch_table(language, explorers);
+  explorer explore_node = ts_dispatch(dispatch_table, ts_node_grammar_symbol(node));
+  if (explore_node != nullptr) {
+    explore_node(language, source_code, scope, node);
   } else {
+    std::string symbol_name = ts_language_symbol_name(language, ts_node_grammar_symbol(node));
     crash_on_node(node, source_code, symbol_name, "unable to explore");
   }
 }
@@ -336,6 +333,7 @@ API::Result API::cpp(const std::vector<std::string>& c_files) {
   TSParser* parser = ts_parser_new();
   const TSLanguage* language = tree_sitter_c();
   ts_parser_set_language(parser, language);
+  c_fields = ts_resolve_field_ids(language);
 
   for (std::string filepath : c_files) {
     char* source_code = read_source_code(filepath.c_str());
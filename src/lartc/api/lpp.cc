@@ -5,7 +5,9 @@
 #include <lartc/ast/declaration.hh>
 #include <lartc/ast/declaration/parse.hh>
 #include <lartc/ast/check.hh>
+#include <lartc/ast/walk.hh>
 #include <lartc/resolve/resolve_symbols.hh>
+#include <lartc/resolve/strip_unreachable.hh>
 #include <lartc/tree_sitter.hh>
 #include <lartc/terminal.hh>
 #include <lartc/ast/file_db.hh>
@@ -15,8 +17,11 @@
 #include <lartc/typecheck/check_declared_types.hh>
 #include <lartc/constants/check_constants.hh>
 #include <lartc/constants/constant_cache.hh>
+#include <lartc/attributes/infer_attributes.hh>
+#include <lartc/attributes/attribute_cache.hh>
 #include <lartc/codegen/cg_context.hh>
 #include <lartc/codegen/emit_llvm.hh>
+#include <lartc/codegen/ir_writer.hh>
 
 #include <iostream>
 #include <assert.h>
@@ -28,6 +33,7 @@
 #include <cstdlib>
 #include <fstream>
 #include <filesystem>
+#include <set>
 
 extern "C" const TSLanguage *tree_sitter_lart(void);
 
@@ -51,12 +57,16 @@ bool parse_filepath(Declaration* decl_tree, TSParser* parser, TSContext& context
 
   TSTree *tree = ts_parser_parse_string(parser, NULL, context.source_code, strlen(context.source_code));
   TSNode root_node = ts_tree_root_node(tree);
-  if (API::DEBUG_SEGFAULT_IDENTIFY_PHASE) {
-    printf("Checking ts_tree for errors ... \n");
-  }
-  bool ast_ok = check_ts_tree_for_errors(context, root_node);
-  if (API::DEBUG_SEGFAULT_IDENTIFY_PHASE) {
-    printf("Checking ts_tree for errors ... OK\n");
+  // error free trees, almost all of them, are lowered without a validation walk
+  bool ast_ok = true;
+  if (ts_node_has_error(root_node)) {
+    if (API::DEBUG_SEGFAULT_IDENTIFY_PHASE) {
+      printf("Checking ts_tree for errors ... \n");
+    }
+    ast_ok = check_ts_tree_for_errors(context, root_node);
+    if (API::DEBUG_SEGFAULT_IDENTIFY_PHASE) {
+      printf("Checking ts_tree for errors ... OK\n");
+    }
   }
 
   if (ast_ok) {
@@ -75,6 +85,109 @@ bool parse_filepath(Declaration* decl_tree, TSParser* parser, TSContext& context
   return ast_ok;
 }
 
+// callees come before their callers, so that their summaries are known when a caller is inferred
+void collect_functions_in_callee_order(SymbolCache& symbol_cache, Declaration* decl, std::set<Declaration*>& visited, std::vector<Declaration*>& functions) {
+  switch (decl->kind) {
+    case declaration_t::MODULE_DECL:
+      for (Declaration* child : decl->children) {
+        collect_functions_in_callee_order(symbol_cache, child, visited, functions);
+      }
+      break;
+    case declaration_t::FUNCTION_DECL:
+      if (decl->body != nullptr && visited.insert(decl).second) {
+        auto it = symbol_cache.globals.find(decl);
+        if (it != symbol_cache.globals.end()) {
+          for (auto& solved : it->second) {
+            if (solved.second != nullptr && solved.second->kind == declaration_t::FUNCTION_DECL)
+              collect_functions_in_callee_order(symbol_cache, solved.second, visited, functions);
+          }
+        }
+        functions.push_back(decl);
+      }
+      break;
+    case declaration_t::TYPE_DECL:
+    case declaration_t::STATIC_VARIABLE_DECL:
+      break;
+  }
+}
+
+// a parsed type registers a point for itself and each of its nested types
+void release_type(CGContext& context, Type* root) {
+  if (root == nullptr) {
+    return;
+  }
+  std::vector<Type*> stack = {root};
+  while (!stack.empty()) {
+    Type* type = stack.back();
+    stack.pop_back();
+    context.file_db.type_points.erase(type);
+    context.file_db.symbol_points.erase(&type->symbol);
+    if (type->subtype != nullptr)
+      stack.push_back(type->subtype);
+    for (auto& field : type->fields)
+      stack.push_back(field.second);
+    for (auto& param : type->parameters)
+      stack.push_back(param.second);
+  }
+}
+
+void release_expression(CGContext& context, Expression* expr) {
+  auto typed = context.type_cache.expression_types.find(expr);
+  if (typed != context.type_cache.expression_types.end()) {
+    Type::Delete(typed->second);
+    context.type_cache.expression_types.erase(typed);
+  }
+  context.type_cache.foldable.erase(expr);
+  auto folded = context.constant_cache.folded.find(expr);
+  if (folded != context.constant_cache.folded.end()) {
+    Expression::Delete(folded->second);
+    context.constant_cache.folded.erase(folded);
+  }
+  context.file_db.expression_points.erase(expr);
+  context.file_db.symbol_points.erase(&expr->symbol);
+  release_type(context, expr->type);
+  context.symbol_cache.locals.erase(expr);
+  context.symbol_cache.parameters.erase(expr);
+  context.symbol_cache.builtins.erase(expr);
+}
+
+void release_statement(CGContext& context, Statement* stmt) {
+  context.file_db.var_decl_points.erase(stmt);
+  context.file_db.return_points.erase(stmt);
+  release_type(context, stmt->type);
+}
+
+// bodies are parsed and resolved with the whole program, then each function goes through
+// type checking, folding, inference and emission on its own,
+// then its body and every cache entry keyed by its nodes are released:
+// the peak still holds every unemitted body and the resolved symbols of every declaration
+bool stream_function_definitions(std::ostream& out, CGContext& context, Declaration* decl_tree) {
+  std::set<Declaration*> visited;
+  std::vector<Declaration*> functions;
+  collect_functions_in_callee_order(context.symbol_cache, decl_tree, visited, functions);
+
+  bool no_errors_occurred = true;
+  emit_llvm_prologue(out, context, decl_tree);
+  for (Declaration* function : functions) {
+    no_errors_occurred &= check_function_types(context.file_db, context.symbol_cache, context.type_cache, function);
+    if (no_errors_occurred) {
+      fold_function_constants(context.file_db, context.symbol_cache, context.size_cache, context.type_cache, context.constant_cache, function);
+      infer_function_attributes(context.symbol_cache, context.type_cache, context.attribute_cache, function);
+      emit_function_definition(out, context, function);
+    }
+    walk_statement(function->body, [&](Statement* stmt) {
+      release_statement(context, stmt);
+    }, [&](Expression* expr) {
+      release_expression(context, expr);
+    });
+    Statement::Delete(function->body);
+    // an empty body keeps it a definition for the callers that come after
+    function->body = Statement::New(statement_t::BLOCK_STMT);
+  }
+  emit_llvm_epilogue(out, context);
+  return no_errors_occurred;
+}
+
 API::Result API::lpp(const std::vector<std::string>& lart_files, std::string& output_file) {
   std::string ll_file;
   if (output_file.ends_with(".bc")) {
@@ -96,6 +209,8 @@ API::Result API::lpp(const std::vector<std::string>& lart_files, std::string& ou
   /* AST-PHASE */
   TSContext context = {
     .language = language,
+    .fields = ts_resolve_field_ids(language),
+    .symbols = ts_resolve_symbol_ids(language),
     .source_code = nullptr,
     .filepath = nullptr,
     .file_db = &file_db,
@@ -148,6 +263,22 @@ API::Result API::lpp(const std::vector<std::string>& lart_files, std::string& ou
     return Result::SYMBOL_RESOLUTION_ERROR;
   }
 
+  /* REACHABILITY-PHASE */
+  std::vector<Declaration*> stripped_decls;
+  if (API::STRIP_UNREACHABLE) {
+    if (API::DEBUG_SEGFAULT_IDENTIFY_PHASE) {
+      printf("Resolving reachable function bodies ... \n");
+    }
+    no_errors_occurred &= strip_unreachable(file_db, symbol_cache, decl_tree, stripped_decls);
+    if (API::DEBUG_SEGFAULT_IDENTIFY_PHASE) {
+      printf("Resolving reachable function bodies ... OK\n");
+    }
+  }
+
+  if (!no_errors_occurred) {
+    return Result::SYMBOL_RESOLUTION_ERROR;
+  }
+
   /* DECL-TYPE-CHECK-PHASE */
   SizeCache size_cache;
   if (API::DEBUG_SEGFAULT_IDENTIFY_PHASE) {
@@ -190,6 +321,18 @@ API::Result API::lpp(const std::vector<std::string>& lart_files, std::string& ou
     return Result::CONSTANT_CHECKING_ERROR;
   }
 
+  /* ATTRIBUTE-INFERENCE-PHASE */
+  AttributeCache attribute_cache;
+  if (API::DEBUG_SEGFAULT_IDENTIFY_PHASE) {
+    printf("Inferring attributes ... \n");
+  }
+  if (!API::STREAM_FUNCTIONS) {
+    infer_attributes(symbol_cache, type_cache, attribute_cache, decl_tree);
+  }
+  if (API::DEBUG_SEGFAULT_IDENTIFY_PHASE) {
+    printf("Inferring attributes ... OK\n");
+  }
+
   /* END-PHASE */
   if (API::DUMP_DEBUG_INFO_FOR_STRUCS) {
     std::filesystem::create_directories("tmp");
@@ -198,29 +341,52 @@ API::Result API::lpp(const std::vector<std::string>& lart_files, std::string& ou
     print_to_file(file_db, "tmp/file_db.txt");
     print_to_file(type_cache, "tmp/type_cache.txt");
     print_to_file(size_cache, "tmp/size_cache.txt");
+    print_to_file(attribute_cache, "tmp/attribute_cache.txt");
   }
 
   /* CODE-GEN-PHASE */
   LiteralStore literal_store;
+  IntrinsicStore intrinsic_store;
+  AttributeStore attribute_store;
+  MetadataStore metadata_store;
   CGContext codegen_context = {
     .file_db = file_db,
     .symbol_cache = symbol_cache,
     .type_cache = type_cache,
     .size_cache = size_cache,
     .constant_cache = constant_cache,
-    .literal_store = literal_store
+    .attribute_cache = attribute_cache,
+    .literal_store = literal_store,
+    .intrinsic_store = intrinsic_store,
+    .attribute_store = attribute_store,
+    .metadata_store = metadata_store
   };
-  std::ofstream bucket (ll_file);
+  IRWriter writer;
+  if (!writer.open(ll_file)) {
+    std::cerr << RED_TEXT << "error" << NORMAL_TEXT << ": unable to open '" << ll_file << "' for writing" << std::endl;
+    return Result::LLVM_IR_GENERATION_ERROR;
+  }
+  std::ostream bucket (&writer);
   if (API::DEBUG_SEGFAULT_IDENTIFY_PHASE) {
     printf("Emitting LLVM to %s ... \n", output_file.c_str());
   }
-  emit_llvm(bucket, codegen_context, decl_tree);
+  if (API::STREAM_FUNCTIONS) {
+    // when streaming, bodies are type checked while emitting
+    no_errors_occurred &= stream_function_definitions(bucket, codegen_context, decl_tree);
+  } else {
+    emit_llvm(bucket, codegen_context, decl_tree);
+  }
   if (API::DEBUG_SEGFAULT_IDENTIFY_PHASE) {
     printf("Emitting LLVM to %s ... OK\n", output_file.c_str());
   }
-  bucket.close();
+  bool ir_written = writer.close();
 
   if (!no_errors_occurred) {
+    return Result::TYPE_CHECKING_ERROR;
+  }
+
+  if (!ir_written) {
+    std::cerr << RED_TEXT << "error" << NORMAL_TEXT << ": unable to write '" << ll_file << "'" << std::endl;
     return Result::LLVM_IR_GENERATION_ERROR;
   }
 
@@ -245,6 +411,9 @@ API::Result API::lpp(const std::vector<std::string>& lart_files, std::string& ou
   TypeCache::Delete(type_cache);
   ConstantCache::Delete(constant_cache);
   Declaration::Delete(decl_tree);
+  for (Declaration*& decl : stripped_decls) {
+    Declaration::Delete(decl);
+  }
   FileDB::Delete(file_db);
 
   return Result::OK;
@@ -0,0 +1,47 @@
+#include <lartc/api/parallel.hh>
+#include <lartc/api/config.hh>
+#include <lartc/external_errors.hh>
+#include <algorithm>
+#include <atomic>
+#include <iostream>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+bool API::run_in_parallel(std::uintmax_t count, const std::function<bool(std::uintmax_t)>& task) {
+  std::uintmax_t n_of_threads = std::min<std::uintmax_t>(API::JOBS, count);
+  if (n_of_threads <= 1) {
+    bool ok = true;
+    for (std::uintmax_t index = 0; index < count; ++index) {
+      ok &= task(index);
+    }
+    return ok;
+  }
+
+  std::vector<std::ostringstream> diagnostics (count);
+  std::vector<char> results (count, true);
+  std::atomic<std::uintmax_t> next_index = 0;
+  auto worker = [&]() {
+    for (std::uintmax_t index = next_index++; index < count; index = next_index++) {
+      redirect_diagnostics(&diagnostics[index]);
+      results[index] = task(index);
+    }
+    redirect_diagnostics(nullptr);
+  };
+
+  std::vector<std::thread> threads;
+  for (std::uintmax_t i = 1; i < n_of_threads; ++i) {
+    threads.emplace_back(worker);
+  }
+  worker();
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+
+  bool ok = true;
+  for (std::uintmax_t index = 0; index < count; ++index) {
+    diagnostic_stream() << diagnostics[index].str();
+    ok &= (bool)results[index];
+  }
+  return ok;
+}
@@ -1,27 +1,35 @@
 #include <lartc/ast/check.hh>
 #include <lartc/external_errors.hh>
 #include <tree_sitter/api.h>
-#include <cstring>
+#include <utility>
+#include <vector>
 
 bool check_ts_tree_for_errors(TSContext& context, TSNode& node) {
   bool ok = true;
-  const char* node_symbol_name = ts_language_symbol_name(context.language, ts_node_symbol(node));
-  std::uintmax_t child_count = ts_node_named_child_count(node);
-  for (std::uintmax_t child_index = 0; child_index < child_count; ++child_index) {
-    TSNode child_node = ts_node_named_child(node, child_index);
-    const char* child_node_symbol_name = ts_language_symbol_name(context.language, ts_node_symbol(child_node));
-    if (std::strcmp(child_node_symbol_name, "ERROR") == 0) {
-      TSPoint child_start = ts_node_start_point(child_node);
-      throw_syntax_error(context.filepath, child_start, node_symbol_name, context.source_code, ts_node_start_byte(child_node));
-      ok = false;
-      check_ts_tree_for_errors(context, child_node);
-    } else if (ts_node_is_missing(child_node)) {
+  // pending children with their parent, popped in source order
+  std::vector<std::pair<TSNode, TSNode>> stack;
+  std::vector<TSNode> children;
+  auto push_children = [&](TSNode parent) {
+    children.clear();
+    ts_for_each_named_child(parent, [&](TSNode child_node) {
+      children.push_back(child_node);
+    });
+    for (auto it = children.rbegin(); it != children.rend(); ++it) {
+      stack.push_back({*it, parent});
+    }
+  };
+  push_children(node);
+  while (!stack.empty()) {
+    auto [child_node, parent_node] = stack.back();
+    stack.pop_back();
+    if (ts_node_symbol(child_node) == context.symbols.error || ts_node_is_missing(child_node)) {
+      const char* node_symbol_name = ts_language_symbol_name(context.language, ts_node_symbol(parent_node));
       TSPoint child_start = ts_node_start_point(child_node);
       throw_syntax_error(context.filepath, child_start, node_symbol_name, context.source_code, ts_node_start_byte(child_node));
       ok = false;
-      check_ts_tree_for_errors(context, child_node);
-    } else {
-      ok &= check_ts_tree_for_errors(context, child_node);
+      push_children(child_node);
+    } else if (ts_node_has_error(child_node)) {
+      push_children(child_node);
     }
   }
   return ok;
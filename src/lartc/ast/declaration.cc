@@ -2,6 +2,7 @@
 #include <lartc/ast/declaration.hh>
 #include <lartc/internal_errors.hh>
 #include <algorithm>
+#include <unordered_map>
 
 Declaration* Declaration::New(declaration_t kind) {
   return new Declaration {
@@ -14,10 +15,46 @@ Declaration* Declaration::New(declaration_t kind) {
     .body = nullptr,
     .is_variadic = false,
     .value = nullptr,
-    .modifier = MODIFIER_NONE
+    .modifier = MODIFIER_NONE,
+    .is_const = false,
+    .attributes = ATTRIBUTE_NONE
   };
 }
 
+const char* attribute_name(attribute_t attribute) {
+  switch (attribute) {
+    case ATTRIBUTE_NONE: return "";
+    case ATTRIBUTE_INLINE: return "inline";
+    case ATTRIBUTE_ALWAYS_INLINE: return "always_inline";
+    case ATTRIBUTE_NOINLINE: return "noinline";
+    case ATTRIBUTE_HOT: return "hot";
+    case ATTRIBUTE_COLD: return "cold";
+    case ATTRIBUTE_PURE: return "pure";
+    case ATTRIBUTE_NORETURN: return "noreturn";
+    case ATTRIBUTE_FAST_MATH: return "fast_math";
+  }
+  return "";
+}
+
+bool find_attribute(const std::string& name, attribute_t& attribute) {
+  static const std::unordered_map<std::string, attribute_t> attributes = {
+    {"inline", ATTRIBUTE_INLINE},
+    {"always_inline", ATTRIBUTE_ALWAYS_INLINE},
+    {"noinline", ATTRIBUTE_NOINLINE},
+    {"hot", ATTRIBUTE_HOT},
+    {"cold", ATTRIBUTE_COLD},
+    {"pure", ATTRIBUTE_PURE},
+    {"readonly", ATTRIBUTE_PURE},
+    {"noreturn", ATTRIBUTE_NORETURN},
+    {"fast_math", ATTRIBUTE_FAST_MATH},
+  };
+  auto it = attributes.find(name);
+  if (it == attributes.end())
+    return false;
+  attribute = it->second;
+  return true;
+}
+
 void Declaration::Delete(Declaration*& decl) {
   if (decl != nullptr) {
     for (Declaration*& child : decl->children) {
@@ -31,6 +68,8 @@ void Declaration::Delete(Declaration*& decl) {
     decl->parameters.clear();
     decl->is_variadic = false;
     decl->modifier = MODIFIER_NONE;
+    decl->is_const = false;
+    decl->attributes = ATTRIBUTE_NONE;
     Statement::Delete(decl->body);
     Expression::Delete(decl->value);
     Type::Delete(decl->type);
@@ -61,6 +100,21 @@ std::ostream& Declaration::Print(std::ostream& out, const Declaration* decl, std
       }
       return out;
     case declaration_t::FUNCTION_DECL:
+      if (decl->attributes != ATTRIBUTE_NONE) {
+        out << "#[";
+        first = true;
+        for (std::uint32_t bit = 1; bit <= ATTRIBUTE_FAST_MATH; bit <<= 1) {
+          if (decl->attributes & bit) {
+            if (first) {
+              first = false;
+            } else {
+              out << ", ";
+            }
+            out << attribute_name((attribute_t)bit);
+          }
+        }
+        out << "] ";
+      }
       out << "fn " << decl->name << "(";
       first = true;
       for (std::pair<std::string, Type*> item : decl->parameters) {
@@ -98,7 +152,7 @@ std::ostream& Declaration::Print(std::ostream& out, const Declaration* decl, std
       if (decl->modifier == MODIFIER_GLOBAL) {
         out << "global ";
       }
-      out << "var";
+      out << (decl->is_const ? "const" : "var");
       if (!decl->name.empty())
         out << " " << decl->name;
       Type::Print(out << ": ", decl->type);
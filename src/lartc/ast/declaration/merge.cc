@@ -14,9 +14,11 @@ bool type_matches_symbolically(Type* older, Type* latest) {
     case type_t::BOOLEAN_TYPE:
       return true;
     case type_t::POINTER_TYPE:
-      return type_matches_symbolically(older->subtype, latest->subtype);
+      return older->is_restrict == latest->is_restrict && type_matches_symbolically(older->subtype, latest->subtype);
     case type_t::ARRAY_TYPE:
       return type_matches_symbolically(older->subtype, latest->subtype);
+    case type_t::VECTOR_TYPE:
+      return older->size == latest->size && type_matches_symbolically(older->subtype, latest->subtype);
     case type_t::SYMBOL_TYPE:
       {
         std::intmax_t older_index = older->symbol.identifiers.size() - 1;
@@ -115,24 +117,36 @@ Declaration* merge_function_declarations(TSContext& context, Declaration* older,
       }
     }
 
-    if (ok) {
-      if (type_matches_symbolically(older->type, latest->type)) {
-        if (older->body != nullptr) {
-          if (latest->body != nullptr) {
-            // err: redefinition
-            throw_duplicate_function_definition(*context.file_db, context.file_db->declaration_points[older], context.file_db->declaration_points[latest]);
-            context.ok = false;
-          }
-        } else {
-          if (latest->body != nullptr) {
-            older->body = latest->body;
-            latest->body = nullptr;
-          }
+    if (ok && type_matches_symbolically(older->type, latest->type)) {
+      // attributes can be spread between the declaration and the definition, as long as they agree
+      bool attributes_ok = true;
+      for_each_attribute_conflict(older->attributes | latest->attributes, [&](attribute_t first, attribute_t second) {
+        // a conflict inside of a single declaration was reported while parsing it
+        bool within_one = ((older->attributes & first) && (older->attributes & second)) || ((latest->attributes & first) && (latest->attributes & second));
+        if (within_one)
+          return;
+        throw_duplicate_function_declaration_attributes_conflict(*context.file_db, context.file_db->declaration_points[older], context.file_db->declaration_points[latest], attribute_name(first), attribute_name(second));
+        context.ok = false;
+        attributes_ok = false;
+      });
+      if (attributes_ok) {
+        older->attributes |= latest->attributes;
+      }
+      if (older->body != nullptr) {
+        if (latest->body != nullptr) {
+          // err: redefinition
+          throw_duplicate_function_definition(*context.file_db, context.file_db->declaration_points[older], context.file_db->declaration_points[latest]);
+          context.ok = false;
         }
       } else {
-        throw_duplicate_function_declaration_return_type_doesnt_match(*context.file_db, context.file_db->declaration_points[older], context.file_db->declaration_points[latest]);
-        context.ok = false;
+        if (latest->body != nullptr) {
+          older->body = latest->body;
+          latest->body = nullptr;
+        }
       }
+    } else if (ok) {
+      throw_duplicate_function_declaration_return_type_doesnt_match(*context.file_db, context.file_db->declaration_points[older], context.file_db->declaration_points[latest]);
+      context.ok = false;
     } else {
       throw_duplicate_function_declaration_parameter_types_dont_match(*context.file_db, context.file_db->declaration_points[older], context.file_db->declaration_points[latest]);
       context.ok = false;
@@ -152,7 +166,7 @@ Declaration* merge_function_declarations(TSContext& context, Declaration* older,
 
 Declaration* merge_static_variable_declarations(TSContext& context, Declaration* older, Declaration* latest) {
   Declaration* result = nullptr;
-  if (type_matches_symbolically(older->type, latest->type)) {
+  if (type_matches_symbolically(older->type, latest->type) && older->is_const == latest->is_const) {
     if (older->value != nullptr) {
       if (latest->value != nullptr) {
         // err: redefinition
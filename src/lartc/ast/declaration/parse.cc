@@ -40,8 +40,8 @@ void append_filepath_or_throw(TSContext& context, TSNode& include_node, std::str
 }
 
 void parse_include_directive(TSContext& context, TSNode& include_node) {
-  TSNode localpath_field = ts_node_child_by_field_name(include_node, "localpath");
-  TSNode globalpath_field = ts_node_child_by_field_name(include_node, "globalpath");
+  TSNode localpath_field = ts_node_child_by_field_id(include_node, context.fields.localpath);
+  TSNode globalpath_field = ts_node_child_by_field_id(include_node, context.fields.globalpath);
   
   if (localpath_field.id != nullptr) {
     std::string localpath_raw = ts_node_source_code(localpath_field, context.source_code);
@@ -57,11 +57,9 @@ void parse_include_directive(TSContext& context, TSNode& include_node) {
 }
 
 inline void parse_declaration_module_rest(Declaration* decl, TSContext& context, TSNode& node, std::uintmax_t from_index = 0) {
-  std::uintmax_t child_count = ts_node_named_child_count(node);
-  for (std::uintmax_t child_index = from_index; child_index < child_count; ++child_index) {
-    TSNode child_node = ts_node_named_child(node, child_index);
-    const char* symbol_name = ts_language_symbol_name(context.language, ts_node_grammar_symbol(child_node));
-    if (strcmp("include", symbol_name) == 0) {
+  ts_for_each_named_child(node, [&](TSNode child_node) {
+    TSSymbol symbol = ts_node_grammar_symbol(child_node);
+    if (symbol == context.symbols.include) {
       parse_include_directive(context, child_node);
     } else {
       Declaration* child_decl = parse_declaration(context, child_node);
@@ -76,19 +74,20 @@ inline void parse_declaration_module_rest(Declaration* decl, TSContext& context,
         child_decl->parent = decl;
         decl->children.push_back(child_decl);
       } else {
-        if (!ts_can_ignore(symbol_name)) {
+        if (!ts_can_ignore(context.symbols, symbol)) {
+          const char* symbol_name = ts_language_symbol_name(context.language, symbol);
           throw_internal_error(UNHANDLED_TS_SYMBOL_NAME, MSG(": " << std::string(symbol_name) << " inside a (module)"));
         }
       }
     }
-  }
+  }, from_index);
 }
 
 inline Declaration* parse_declaration_module(TSContext& context, TSNode& node) {
   Declaration* decl = Declaration::New(declaration_t::MODULE_DECL);
   context.file_db->add_declaration(decl, node);
   
-  TSNode name = ts_node_child_by_field_name(node, "name");
+  TSNode name = ts_node_child_by_field_id(node, context.fields.name);
   decl->name = ts_node_source_code(name, context.source_code);
 
   parse_declaration_module_rest(decl, context, node, 1);
@@ -97,31 +96,56 @@ inline Declaration* parse_declaration_module(TSContext& context, TSNode& node) {
 }
 
 void parse_source_file(Declaration* decl_tree, TSContext& context, TSNode& root_node) {
-  const char* symbol_name = ts_language_symbol_name(context.language, ts_node_grammar_symbol(root_node));
-  if (std::strcmp(symbol_name, "source_file") != 0)
-    throw_internal_error(TS_ROOT_NODE_SHOULD_BE_SOURCE_FILE, MSG(": instead is " << std::string(symbol_name)));
+  TSSymbol symbol = ts_node_grammar_symbol(root_node);
+  if (symbol != context.symbols.source_file)
+    throw_internal_error(TS_ROOT_NODE_SHOULD_BE_SOURCE_FILE, MSG(": instead is " << std::string(ts_language_symbol_name(context.language, symbol))));
   parse_declaration_module_rest(decl_tree, context, root_node, 0);
 }
 
+void parse_function_attributes(Declaration* decl, TSContext& context, TSNode& attributes_node) {
+  ts_for_each_named_child(attributes_node, [&](TSNode attribute_node) {
+    std::string name = ts_node_source_code(attribute_node, context.source_code);
+    TSPoint point = ts_node_start_point(attribute_node);
+    attribute_t attribute;
+    if (!find_attribute(name, attribute)) {
+      throw_unknown_function_attribute(context.filepath, point, name, context.source_code, ts_node_start_byte(attribute_node));
+      context.ok = false;
+      return;
+    }
+    decl->attributes |= attribute;
+  });
+
+  for_each_attribute_conflict(decl->attributes, [&](attribute_t first, attribute_t second) {
+    TSPoint point = ts_node_start_point(attributes_node);
+    throw_conflicting_function_attributes(context.filepath, point, attribute_name(first), attribute_name(second), context.source_code, ts_node_start_byte(attributes_node));
+    context.ok = false;
+  });
+}
+
 inline Declaration* parse_declaration_function(TSContext& context, TSNode& node) {
   Declaration* decl = Declaration::New(declaration_t::FUNCTION_DECL);
   
-  TSNode name = ts_node_child_by_field_name(node, "name");
+  TSNode name = ts_node_child_by_field_id(node, context.fields.name);
   decl->name = ts_node_source_code(name, context.source_code);
+
+  TSNode attributes = ts_node_child_by_field_id(node, context.fields.attributes);
+  if (attributes.id != nullptr) {
+    parse_function_attributes(decl, context, attributes);
+  }
   
-  TSNode parameters = ts_node_child_by_field_name(node, "parameters");
+  TSNode parameters = ts_node_child_by_field_id(node, context.fields.parameters);
   auto parsed = parse_field_parameter_list(context, parameters);
   decl->parameters = parsed.first;
   decl->is_variadic = parsed.second;
 
-  TSNode type = ts_node_child_by_field_name(node, "type");
+  TSNode type = ts_node_child_by_field_id(node, context.fields.type);
   if (type.id) {
     decl->type = parse_type(context, type);
   } else {
     decl->type = Type::New(type_t::VOID_TYPE);
   }
   
-  TSNode body = ts_node_child_by_field_name(node, "body");
+  TSNode body = ts_node_child_by_field_id(node, context.fields.body);
   if (body.id) {
     decl->body = parse_statement(context, body);
   } else {
@@ -140,10 +164,10 @@ inline Declaration* parse_declaration_function(TSContext& context, TSNode& node)
 inline Declaration* parse_declaration_type(TSContext& context, TSNode& node) {
   Declaration* decl = Declaration::New(declaration_t::TYPE_DECL);
   
-  TSNode name = ts_node_child_by_field_name(node, "name");
+  TSNode name = ts_node_child_by_field_id(node, context.fields.name);
   decl->name = ts_node_source_code(name, context.source_code);
 
-  TSNode type = ts_node_child_by_field_name(node, "type");
+  TSNode type = ts_node_child_by_field_id(node, context.fields.type);
   decl->type = parse_type(context, type);
 
   if (decl->type == nullptr) {
@@ -158,10 +182,10 @@ inline Declaration* parse_declaration_type(TSContext& context, TSNode& node) {
 inline Declaration* parse_declaration_static_variable(TSContext& context, TSNode& node) {
   Declaration* decl = Declaration::New(declaration_t::STATIC_VARIABLE_DECL);
   
-  TSNode name = ts_node_child_by_field_name(node, "name");
+  TSNode name = ts_node_child_by_field_id(node, context.fields.name);
   decl->name = ts_node_source_code(name, context.source_code);
 
-  TSNode type = ts_node_child_by_field_name(node, "type");
+  TSNode type = ts_node_child_by_field_id(node, context.fields.type);
   decl->type = parse_type(context, type);
 
   if (decl->type == nullptr) {
@@ -169,7 +193,7 @@ inline Declaration* parse_declaration_static_variable(TSContext& context, TSNode
     throw_internal_error(UNHANDLED_TS_SYMBOL_NAME, MSG(": " << std::string(symbol_name) << " inside a (typedef)"));
   }
 
-  TSNode value = ts_node_child_by_field_name(node, "value");
+  TSNode value = ts_node_child_by_field_id(node, context.fields.value);
   if (value.id != nullptr) {
     decl->value = parse_expression(context, value);
     if (decl->value == nullptr) {
@@ -178,18 +202,22 @@ inline Declaration* parse_declaration_static_variable(TSContext& context, TSNode
     }
   }
 
-  TSNode modifier = ts_node_child_by_field_name(node, "modifier");
+  TSNode modifier = ts_node_child_by_field_id(node, context.fields.modifier);
   if (modifier.id != nullptr) {
-    const char* modifier_name = ts_language_symbol_name(context.language, ts_node_grammar_symbol(modifier));
-    if (strcmp(modifier_name, "extern_modifier") == 0) {
+    TSSymbol modifier_symbol = ts_node_grammar_symbol(modifier);
+    if (modifier_symbol == context.symbols.extern_modifier) {
       decl->modifier = MODIFIER_EXTERN;
-    } else if (strcmp(modifier_name, "global_modifier") == 0) {
+    } else if (modifier_symbol == context.symbols.global_modifier) {
       decl->modifier = MODIFIER_GLOBAL;
     } else {
+      const char* modifier_name = ts_language_symbol_name(context.language, modifier_symbol);
       throw_internal_error(UNHANDLED_TS_SYMBOL_NAME, MSG(": " << std::string(modifier_name) << " inside a (static_variable::modifier)"));
     }
   }
 
+  TSNode const_ = ts_node_child_by_field_id(node, context.fields.const_);
+  decl->is_const = const_.id != nullptr;
+
   if (decl->modifier == MODIFIER_EXTERN && decl->value != nullptr) {
     TSPoint point = ts_node_start_point(node);
     throw_extern_static_variables_cannot_have_a_defined_value(context.filepath, point, context.source_code, ts_node_start_byte(node));
@@ -208,10 +236,10 @@ std::unordered_map<std::string, declaration_parser> declaration_parsers = {
 };
 
 Declaration* parse_declaration(TSContext& context, TSNode& node) {
-  const char* symbol_name = ts_language_symbol_name(context.language, ts_node_grammar_symbol(node));
-  auto it = declaration_parsers.find(symbol_name);
-  if (it != declaration_parsers.end()) {
-    return it->second(context, node);
+  static const std::vector<declaration_parser> dispatch_table = ts_build_dispatch_table(context.language, declaration_parsers);
+  declaration_parser parser = ts_dispatch(dispatch_table, ts_node_grammar_symbol(node));
+  if (parser != nullptr) {
+    return parser(context, node);
   }
   return nullptr;
 }
@@ -1,20 +1,19 @@
 #include <cassert>
 #include <iomanip>
 #include <lartc/ast/expression.hh>
+#include <lartc/ast/walk.hh>
 #include <lartc/internal_errors.hh>
 #include <lartc/serializations.hh>
 
 Expression* Expression::New(expression_t kind) {
   return new Expression {
     .kind = kind,
-    .symbol = {},
-    .string_literal = "",
-    .boolean_literal = false,
+    .operator_ = (operator_t)-1,
     .integer_literal = 0,
-    .decimal_literal = 0.0,
+    .symbol = {},
+    .string_literal = nullptr,
     .callable = nullptr,
     .arguments = {},
-    .operator_ = (operator_t)-1,
     .type = nullptr,
     .left = nullptr,
     .right = nullptr,
@@ -22,27 +21,15 @@ Expression* Expression::New(expression_t kind) {
   };
 }
 
+void Expression::DeleteNode(Expression* expr) {
+  Type::Delete(expr->type);
+  delete expr->string_literal;
+  delete expr;
+}
+
 void Expression::Delete(Expression*& expr) {
-  if (expr != nullptr) {
-    expr->symbol = {};
-    expr->string_literal = "";
-    expr->boolean_literal = false;
-    expr->integer_literal = 0;
-    expr->decimal_literal = 0.0;
-    Expression::Delete(expr->callable);
-    for (Expression*& child : expr->arguments) {
-      Expression::Delete(child);
-    }
-    expr->arguments.clear();
-    expr->symbol = {};
-    expr->operator_ = (operator_t)-1;
-    Type::Delete(expr->type);
-    Expression::Delete(expr->left);
-    Expression::Delete(expr->right);
-    Expression::Delete(expr->value);
-    delete expr;
-    expr = nullptr;
-  }
+  walk_expression(expr, Expression::DeleteNode);
+  expr = nullptr;
 }
 
 std::ostream& Expression::Print(std::ostream& out, const Expression* expr, bool parenthesized) {
@@ -71,7 +58,7 @@ std::ostream& Expression::Print(std::ostream& out, const Expression* expr, bool
       out << dump_unescaped_char(expr->integer_literal);
       break;
     case expression_t::STRING_EXPR:
-      out << dump_unescaped_string(expr->string_literal);
+      out << dump_unescaped_string(*expr->string_literal);
       break;
     case expression_t::CALL_EXPR:
       Expression::Print(out, expr->callable) << "(";
@@ -130,6 +117,48 @@ std::ostream& Expression::Print(std::ostream& out, const Expression* expr, bool
       Type::Print(out, expr->type);
       out << ">";
       break;
+    case expression_t::VECTOR_LOAD_EXPR:
+      out << (expr->integer_literal == 1 ? "vloadu<" : "vload<");
+      Type::Print(out, expr->type);
+      out << ">(";
+      Expression::Print(out, expr->value);
+      out << ")";
+      break;
+    case expression_t::VECTOR_STORE_EXPR:
+      out << (expr->integer_literal == 1 ? "vstoreu(" : "vstore(");
+      Expression::Print(out, expr->left);
+      out << ", ";
+      Expression::Print(out, expr->right);
+      out << ")";
+      break;
+    case expression_t::VECTOR_SHUFFLE_EXPR:
+      out << "shuffle(";
+      Expression::Print(out, expr->left);
+      out << ", ";
+      Expression::Print(out, expr->right);
+      out << ", [";
+      for (Expression* lane : expr->arguments) {
+        if (first) {
+          first = false;
+        } else {
+          out << ", ";
+        }
+        Expression::Print(out, lane);
+      }
+      out << "])";
+      break;
+    case expression_t::AGGREGATE_LITERAL_EXPR:
+      Type::Print(out, expr->type) << "{";
+      for (Expression* element : expr->arguments) {
+        if (first) {
+          first = false;
+        } else {
+          out << ", ";
+        }
+        Expression::Print(out, element);
+      }
+      out << "}";
+      break;
    }
   if (parenthesized && (expr->kind == expression_t::MONARY_EXPR
                         || expr->kind == expression_t::BINARY_EXPR))
@@ -138,29 +167,42 @@ std::ostream& Expression::Print(std::ostream& out, const Expression* expr, bool
 }
 
 Expression* Expression::Clone(Expression* expr) {
-  if (expr == nullptr) {
-    throw_internal_error(ATTEMPT_TO_CLONE_NULLPTR_AS_EXPRESSION, MSG(""));
-  }
-  Expression* result = Expression::New(expr->kind);
-  result->symbol = expr->symbol;
-  result->string_literal = expr->string_literal;
-  result->boolean_literal = expr->boolean_literal;
-  result->integer_literal = expr->integer_literal;
-  result->decimal_literal = expr->decimal_literal;
-  result->operator_ = expr->operator_;
-  result->arguments = {};
-  for (auto argument : expr->arguments) {
-    result->arguments.push_back(Expression::Clone(argument));
+  // each pending node is copied into the slot its parent reserved for it
+  Expression* result = nullptr;
+  std::vector<std::pair<const Expression*, Expression**>> stack = {{expr, &result}};
+  while (!stack.empty()) {
+    auto [source, slot] = stack.back();
+    stack.pop_back();
+    if (source == nullptr) {
+      throw_internal_error(ATTEMPT_TO_CLONE_NULLPTR_AS_EXPRESSION, MSG(""));
+    }
+    Expression* clone = Expression::New(source->kind);
+    *slot = clone;
+    clone->symbol = source->symbol;
+    if (source->string_literal != nullptr)
+      clone->string_literal = new std::string(*source->string_literal);
+    if (source->kind == expression_t::BOOLEAN_EXPR) {
+      clone->boolean_literal = source->boolean_literal;
+    } else if (source->kind == expression_t::DOUBLE_EXPR) {
+      clone->decimal_literal = source->decimal_literal;
+    } else {
+      clone->integer_literal = source->integer_literal;
+    }
+    clone->operator_ = source->operator_;
+    if (source->type != nullptr)
+      clone->type = Type::Clone(source->type);
+    clone->arguments.resize(source->arguments.size(), nullptr);
+    for (std::uintmax_t i = 0; i < source->arguments.size(); ++i) {
+      stack.push_back({source->arguments[i], &clone->arguments[i]});
+    }
+    if (source->callable != nullptr)
+      stack.push_back({source->callable, &clone->callable});
+    if (source->left != nullptr)
+      stack.push_back({source->left, &clone->left});
+    if (source->right != nullptr)
+      stack.push_back({source->right, &clone->right});
+    if (source->value != nullptr)
+      stack.push_back({source->value, &clone->value});
   }
-  if (expr->callable != nullptr)
-    result->callable = Expression::Clone(expr->callable);
-  if (expr->type != nullptr)
-    result->type = Type::Clone(expr->type);
-  if (expr->left != nullptr)
-    result->left = Expression::Clone(expr->left);
-  if (expr->right != nullptr)
-    result->right = Expression::Clone(expr->right);
-  if (expr->value != nullptr)
-    result->value = Expression::Clone(expr->value);
   return result;
 }
@@ -1,6 +1,7 @@
 #include <lartc/ast/expression/parse.hh>
 #include <lartc/ast/type/parse.hh>
 #include <lartc/ast/parse.hh>
+#include <lartc/ast/walk.hh>
 #include <lartc/internal_errors.hh>
 #include <lartc/external_errors.hh>
 #include <lartc/tree_sitter.hh>
@@ -51,60 +52,81 @@ Expression* parse_expression_character(TSContext& context, TSNode& node) {
 
 Expression* parse_expression_string(TSContext& context, TSNode& node) {
   Expression* string = Expression::New(STRING_EXPR);
-  string->string_literal = load_escaped_string(ts_node_source_code(node, context.source_code));
+  string->string_literal = new std::string(load_escaped_string(ts_node_source_code(node, context.source_code)));
   return string;
 }
 
 Expression* parse_expression_call(TSContext& context, TSNode& node) {
   Expression* call = Expression::New(CALL_EXPR);
-  TSNode callable = ts_node_child_by_field_name(node, "callable");
+  TSNode callable = ts_node_child_by_field_id(node, context.fields.callable);
   call->callable = parse_expression(context, callable);
   ts_validate_parsing(context.language, callable, "call_expr:callable", call->callable);
 
-  TSNode arguments = ts_node_child_by_field_name(node, "arguments");
-  std::uintmax_t argument_count = ts_node_named_child_count(arguments);
-  for (std::uintmax_t argument_index = 0; argument_index < argument_count; ++argument_index) {
-    TSNode argument_node = ts_node_named_child(arguments, argument_index);
+  TSNode arguments = ts_node_child_by_field_id(node, context.fields.arguments);
+  ts_for_each_named_child(arguments, [&](TSNode argument_node) {
     Expression* argument = parse_expression(context, argument_node);
     if (argument != nullptr) {
       call->arguments.push_back(argument);
     } else {
-      const char* symbol_name = ts_language_symbol_name(context.language, ts_node_grammar_symbol(argument_node));
-      if (!ts_can_ignore(symbol_name)) {
+      if (!ts_can_ignore(context.symbols, ts_node_grammar_symbol(argument_node))) {
+        const char* symbol_name = ts_language_symbol_name(context.language, ts_node_grammar_symbol(argument_node));
         throw_internal_error(UNHANDLED_TS_SYMBOL_NAME, MSG(": " << std::string(symbol_name) << " inside a (call_expr:arguments)"));
       }
     }
-  }
+  });
   return call;
 }
 
+inline bool ts_is_binary_expression(TSContext& context, TSNode& node) {
+  TSSymbol symbol = ts_node_grammar_symbol(node);
+  return symbol == context.symbols.binary_expression || symbol == context.symbols.callable_binary_expression;
+}
+
+// binary expressions nested on their left, as in long sums, are walked down in a loop and built on the way up
 Expression* parse_expression_binary(TSContext& context, TSNode& node) {
-  Expression* binary = Expression::New(BINARY_EXPR);
-  TSNode left = ts_node_child_by_field_name(node, "left");
-  binary->left = parse_expression(context, left);
-  ts_validate_parsing(context.language, left, "binary_expr:left", binary->left);
+  std::vector<TSNode> chain = {node};
+  TSNode innermost = ts_node_child_by_field_id(node, context.fields.left);
+  while (ts_is_binary_expression(context, innermost)) {
+    chain.push_back(innermost);
+    innermost = ts_node_child_by_field_id(innermost, context.fields.left);
+  }
+  Expression* left = parse_expression(context, innermost);
+  ts_validate_parsing(context.language, innermost, "binary_expr:left", left);
 
-  TSNode right = ts_node_child_by_field_name(node, "right");
-  binary->right = parse_expression(context, right);
-  ts_validate_parsing(context.language, right, "binary_expr:right", binary->right);
+  Expression* binary = nullptr;
+  for (auto it = chain.rbegin(); it != chain.rend(); ++it) {
+    binary = Expression::New(BINARY_EXPR);
+    binary->left = left;
 
-  TSNode operator_ = ts_node_child_by_field_name(node, "operator");
-  ts_node_source_code(operator_, context.source_code) >> binary->operator_;
+    TSNode right = ts_node_child_by_field_id(*it, context.fields.right);
+    binary->right = parse_expression(context, right);
+    ts_validate_parsing(context.language, right, "binary_expr:right", binary->right);
+
+    TSNode operator_ = ts_node_child_by_field_id(*it, context.fields.operator_);
+    ts_node_source_code(operator_, context.source_code) >> binary->operator_;
+    // the outermost is registered by parse_expression
+    if (it + 1 != chain.rend())
+      context.file_db->add_expression(binary, *it);
+    left = binary;
+  }
   return binary;
 }
 
 Expression* parse_expression_monary(TSContext& context, TSNode& node) {
   Expression* monary = Expression::New(MONARY_EXPR);
-  TSNode value = ts_node_child_by_field_name(node, "value");
+  TSNode value = ts_node_child_by_field_id(node, context.fields.value);
   monary->value = parse_expression(context, value);
   ts_validate_parsing(context.language, value, "monary_expr:value", monary->value);
 
-  TSNode operator_ = ts_node_child_by_field_name(node, "operator");
+  TSNode operator_ = ts_node_child_by_field_id(node, context.fields.operator_);
   ts_node_source_code(operator_, context.source_code) >> monary->operator_;
 
   if (monary->operator_ == operator_t::INC_OP || monary->operator_ == operator_t::DEC_OP) {
+    Expression* target = monary->value;
+    monary->value = nullptr;
+
     Expression* change = Expression::New(expression_t::BINARY_EXPR);
-    change->left = Expression::Clone(monary->value);
+    change->left = Expression::Clone(target);
     change->right = Expression::New(expression_t::INTEGER_EXPR);
     change->right->integer_literal = 1;
 
@@ -114,9 +136,22 @@ Expression* parse_expression_monary(TSContext& context, TSNode& node) {
       change->operator_ = operator_t::SUB_OP;
     }
 
+    // the copy of the target is reported where the target is, the new nodes at the operation
+    std::vector<Expression*> originals;
+    std::vector<Expression*> copies;
+    walk_expression(target, [&](Expression* original) { originals.push_back(original); });
+    walk_expression(change->left, [&](Expression* copy) { copies.push_back(copy); });
+    for (std::uintmax_t index = 0; index < copies.size(); ++index) {
+      context.file_db->expression_points[copies[index]] = context.file_db->expression_point(originals[index]);
+      if (copies[index]->kind == expression_t::SYMBOL_EXPR)
+        context.file_db->symbol_points[&copies[index]->symbol] = context.file_db->symbol_point(&originals[index]->symbol);
+    }
+    context.file_db->add_expression(change, node);
+    context.file_db->add_expression(change->right, node);
+
     Expression* assignment = Expression::New(expression_t::BINARY_EXPR);
     assignment->operator_ = operator_t::ASS_OP;
-    assignment->left = Expression::Clone(monary->value);
+    assignment->left = target;
     assignment->right = change;
 
     Expression::Delete(monary);
@@ -127,7 +162,7 @@ Expression* parse_expression_monary(TSContext& context, TSNode& node) {
 
 Expression* parse_expression_sizeof(TSContext& context, TSNode& node) {
   Expression* sizeof_ = Expression::New(SIZEOF_EXPR);
-  TSNode type = ts_node_child_by_field_name(node, "type");
+  TSNode type = ts_node_child_by_field_id(node, context.fields.type);
   sizeof_->type = parse_type(context, type);
   ts_validate_parsing(context.language, type, "sizeof_expr:type", sizeof_->type);
   return sizeof_;
@@ -135,11 +170,11 @@ Expression* parse_expression_sizeof(TSContext& context, TSNode& node) {
 
 Expression* parse_expression_cast(TSContext& context, TSNode& node) {
   Expression* cast = Expression::New(CAST_EXPR);
-  TSNode type = ts_node_child_by_field_name(node, "type");
+  TSNode type = ts_node_child_by_field_id(node, context.fields.type);
   cast->type = parse_type(context, type);
   ts_validate_parsing(context.language, type, "cast_expr:type", cast->type);
 
-  TSNode value = ts_node_child_by_field_name(node, "value");
+  TSNode value = ts_node_child_by_field_id(node, context.fields.value);
   cast->value = parse_expression(context, value);
   ts_validate_parsing(context.language, value, "cast_expr:value", cast->value);
   return cast;
@@ -147,11 +182,11 @@ Expression* parse_expression_cast(TSContext& context, TSNode& node) {
 
 Expression* parse_expression_bitcast(TSContext& context, TSNode& node) {
   Expression* bitcast = Expression::New(BITCAST_EXPR);
-  TSNode type = ts_node_child_by_field_name(node, "type");
+  TSNode type = ts_node_child_by_field_id(node, context.fields.type);
   bitcast->type = parse_type(context, type);
   ts_validate_parsing(context.language, type, "bitcast_expr:type", bitcast->type);
 
-  TSNode value = ts_node_child_by_field_name(node, "value");
+  TSNode value = ts_node_child_by_field_id(node, context.fields.value);
   bitcast->value = parse_expression(context, value);
   ts_validate_parsing(context.language, value, "bitcast_expr:value", bitcast->value);
   return bitcast;
@@ -159,12 +194,96 @@ Expression* parse_expression_bitcast(TSContext& context, TSNode& node) {
 
 Expression* parse_expression_vanext(TSContext& context, TSNode& node) {
   Expression* vanext = Expression::New(VANEXT_EXPR);
-  TSNode type = ts_node_child_by_field_name(node, "type");
+  TSNode type = ts_node_child_by_field_id(node, context.fields.type);
   vanext->type = parse_type(context, type);
   ts_validate_parsing(context.language, type, "vanext_expr:type", vanext->type);
   return vanext;
 }
 
+// alignment is kept in integer_literal: 0 is the natural alignment of the vector, 1 is unaligned
+Expression* parse_expression_vector_load(TSContext& context, TSNode& node) {
+  Expression* load = Expression::New(VECTOR_LOAD_EXPR);
+  TSNode type = ts_node_child_by_field_id(node, context.fields.type);
+  load->type = parse_type(context, type);
+  ts_validate_parsing(context.language, type, "vector_load_expr:type", load->type);
+
+  TSNode pointer = ts_node_child_by_field_id(node, context.fields.pointer);
+  load->value = parse_expression(context, pointer);
+  ts_validate_parsing(context.language, pointer, "vector_load_expr:pointer", load->value);
+  return load;
+}
+
+Expression* parse_expression_vector_load_unaligned(TSContext& context, TSNode& node) {
+  Expression* load = parse_expression_vector_load(context, node);
+  load->integer_literal = 1;
+  return load;
+}
+
+Expression* parse_expression_vector_store(TSContext& context, TSNode& node) {
+  Expression* store = Expression::New(VECTOR_STORE_EXPR);
+  TSNode pointer = ts_node_child_by_field_id(node, context.fields.pointer);
+  store->left = parse_expression(context, pointer);
+  ts_validate_parsing(context.language, pointer, "vector_store_expr:pointer", store->left);
+
+  TSNode value = ts_node_child_by_field_id(node, context.fields.value);
+  store->right = parse_expression(context, value);
+  ts_validate_parsing(context.language, value, "vector_store_expr:value", store->right);
+  return store;
+}
+
+Expression* parse_expression_vector_store_unaligned(TSContext& context, TSNode& node) {
+  Expression* store = parse_expression_vector_store(context, node);
+  store->integer_literal = 1;
+  return store;
+}
+
+Expression* parse_expression_vector_shuffle(TSContext& context, TSNode& node) {
+  Expression* shuffle = Expression::New(VECTOR_SHUFFLE_EXPR);
+  TSNode left = ts_node_child_by_field_id(node, context.fields.left);
+  shuffle->left = parse_expression(context, left);
+  ts_validate_parsing(context.language, left, "vector_shuffle_expr:left", shuffle->left);
+
+  TSNode right = ts_node_child_by_field_id(node, context.fields.right);
+  shuffle->right = parse_expression(context, right);
+  ts_validate_parsing(context.language, right, "vector_shuffle_expr:right", shuffle->right);
+
+  TSNode mask = ts_node_child_by_field_id(node, context.fields.mask);
+  ts_for_each_named_child(mask, [&](TSNode lane_node) {
+    Expression* lane = parse_expression(context, lane_node);
+    if (lane != nullptr) {
+      shuffle->arguments.push_back(lane);
+    } else {
+      if (!ts_can_ignore(context.symbols, ts_node_grammar_symbol(lane_node))) {
+        const char* symbol_name = ts_language_symbol_name(context.language, ts_node_grammar_symbol(lane_node));
+        throw_internal_error(UNHANDLED_TS_SYMBOL_NAME, MSG(": " << std::string(symbol_name) << " inside a (vector_shuffle_expr:mask)"));
+      }
+    }
+  });
+  return shuffle;
+}
+
+// missing trailing elements are zero initialized
+Expression* parse_expression_aggregate_literal(TSContext& context, TSNode& node) {
+  Expression* literal = Expression::New(AGGREGATE_LITERAL_EXPR);
+  TSNode type = ts_node_child_by_field_id(node, context.fields.type);
+  literal->type = parse_type(context, type);
+  ts_validate_parsing(context.language, type, "aggregate_literal_expr:type", literal->type);
+
+  TSNode elements = ts_node_child_by_field_id(node, context.fields.elements);
+  ts_for_each_named_child(elements, [&](TSNode element_node) {
+    Expression* element = parse_expression(context, element_node);
+    if (element != nullptr) {
+      literal->arguments.push_back(element);
+    } else {
+      if (!ts_can_ignore(context.symbols, ts_node_grammar_symbol(element_node))) {
+        const char* symbol_name = ts_language_symbol_name(context.language, ts_node_grammar_symbol(element_node));
+        throw_internal_error(UNHANDLED_TS_SYMBOL_NAME, MSG(": " << std::string(symbol_name) << " inside a (aggregate_literal_expr:elements)"));
+      }
+    }
+  });
+  return literal;
+}
+
 inline Expression* parse_expression_parenthesized(TSContext& context, TSNode& node) {
   TSNode inner_expr = ts_node_named_child(node, 0);
   return parse_expression(context, inner_expr);
@@ -172,12 +291,12 @@ inline Expression* parse_expression_parenthesized(TSContext& context, TSNode& no
 
 Expression* parse_array_access_expression(TSContext& context, TSNode& node) {
   // TODO: RENAME THESE NAMES
-  TSNode pointer_node = ts_node_child_by_field_name(node, "pointer");
+  TSNode pointer_node = ts_node_child_by_field_id(node, context.fields.pointer);
   Expression* pointer_expression = parse_expression(context, pointer_node);
   ts_validate_parsing(context.language, pointer_node, "array_access_expr:pointer", pointer_expression);
 
   // TODO: RENAME THESE NAMES
-  TSNode offset_node = ts_node_child_by_field_name(node, "offset");
+  TSNode offset_node = ts_node_child_by_field_id(node, context.fields.offset);
   Expression* offset_expression = parse_expression(context, offset_node);
   ts_validate_parsing(context.language, offset_node, "array_access_expr:offset", offset_expression);
 
@@ -206,15 +325,21 @@ std::unordered_map<std::string, expression_parser> expression_parsers = {
   {"cast_expression", parse_expression_cast},
   {"bitcast_expression", parse_expression_bitcast},
   {"vanext_expression", parse_expression_vanext},
+  {"vector_load_expression", parse_expression_vector_load},
+  {"vector_load_unaligned_expression", parse_expression_vector_load_unaligned},
+  {"vector_store_expression", parse_expression_vector_store},
+  {"vector_store_unaligned_expression", parse_expression_vector_store_unaligned},
+  {"vector_shuffle_expression", parse_expression_vector_shuffle},
+  {"aggregate_literal_expression", parse_expression_aggregate_literal},
   {"parenthesized_expression", parse_expression_parenthesized},
   {"array_access_expression", parse_array_access_expression}
 };
 
 Expression* parse_expression(TSContext& context, TSNode& node) {
-  const char* symbol_name = ts_language_symbol_name(context.language, ts_node_grammar_symbol(node));
-  auto it = expression_parsers.find(symbol_name);
-  if (it != expression_parsers.end()) {
-    Expression* expr = it->second(context, node);
+  static const std::vector<expression_parser> dispatch_table = ts_build_dispatch_table(context.language, expression_parsers);
+  expression_parser parser = ts_dispatch(dispatch_table, ts_node_grammar_symbol(node));
+  if (parser != nullptr) {
+    Expression* expr = parser(context, node);
     if (expr != nullptr) {
       context.file_db->add_expression(expr, node);
     }
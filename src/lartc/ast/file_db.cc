@@ -5,7 +5,10 @@
 #include <tree_sitter/api.h>
 #include <filesystem>
 #include <lartc/terminal.hh>
+#include <lartc/internal_errors.hh>
+#include <algorithm>
 #include <cassert>
+#include <limits>
 
 inline char* read_source_code(const char* filepath) {
     char* text = NULL;
@@ -21,28 +24,77 @@ inline char* read_source_code(const char* filepath) {
 }
 
 FileDB::Point FileDB::Point::From(const FileDB* file_db, TSNode& ts_node) {
-  std::uintmax_t file = file_db->current_file_index();
-  TSPoint point = ts_node_start_point(ts_node);
-  std::uintmax_t byte_start = ts_node_start_byte(ts_node);
-  std::uintmax_t byte_end = ts_node_end_byte(ts_node);
+  std::uint32_t byte_start = ts_node_start_byte(ts_node);
+  std::uint32_t byte_end = ts_node_end_byte(ts_node);
   return FileDB::Point {
-    .file = file,
-    .row = point.row,
-    .column = point.column,
-    .byte_start = byte_start,
-    .byte_end = byte_end
+    .offset = file_db->files[file_db->current_file_index()].offset + byte_start,
+    .length = byte_end - byte_start
   };
 }
 
 FileDB::File* FileDB::add_file(const char* filepath) {
+  // files are laid out one after the other, one past the terminator so that every point falls in one file
+  std::uintmax_t offset = files.empty() ? 0 : (std::uintmax_t)files.back().offset + files.back().size + 1;
   files.push_back(FileDB::File {});
   FileDB::File* file = current_file();
   file->filepath = "";
   file->filepath += filepath;
   file->source_code = read_source_code(file->filepath.c_str());
+  std::uintmax_t size = strlen(file->source_code);
+  if (offset + size >= std::numeric_limits<std::uint32_t>::max()) {
+    throw_internal_error(SOURCE_FILES_EXCEED_LOCATION_SPACE, MSG(": " << file->filepath));
+  }
+  file->offset = offset;
+  file->size = size;
+  file->line_starts.push_back(0);
+  for (std::uint32_t byte = 0; byte < file->size; ++byte) {
+    if (file->source_code[byte] == '\n') {
+      file->line_starts.push_back(byte + 1);
+    }
+  }
   return file;
 }
 
+FileDB::Location FileDB::locate(const FileDB::Point& point) const {
+  auto file_it = std::upper_bound(files.begin(), files.end(), point.offset, [](std::uint32_t offset, const File& file) {
+    return offset < file.offset;
+  });
+  assert(file_it != files.begin());
+  const File& file = *(file_it - 1);
+  std::uint32_t byte_start = point.offset - file.offset;
+  auto line_it = std::upper_bound(file.line_starts.begin(), file.line_starts.end(), byte_start);
+  std::uintmax_t row = (line_it - file.line_starts.begin()) - 1;
+  return FileDB::Location {
+    .file = (std::uintmax_t)(file_it - 1 - files.begin()),
+    .row = row,
+    .column = byte_start - file.line_starts[row],
+    .byte_start = byte_start,
+    .byte_end = byte_start + point.length
+  };
+}
+
+template<typename Node>
+inline const FileDB::Point& find_point(const std::map<Node*, FileDB::Point>& points, Node* node, const FileDB::Point& fallback) {
+  auto it = points.find(node);
+  return it == points.end() ? fallback : it->second;
+}
+
+const FileDB::Point& FileDB::expression_point(Expression* expression) const {
+  return find_point(expression_points, expression, unknown_point);
+}
+
+const FileDB::Point& FileDB::symbol_point(Symbol* symbol) const {
+  return find_point(symbol_points, symbol, unknown_point);
+}
+
+const FileDB::Point& FileDB::type_point(Type* type) const {
+  return find_point(type_points, type, unknown_point);
+}
+
+const FileDB::Point& FileDB::return_point(Statement* return_stmt) const {
+  return find_point(return_points, return_stmt, unknown_point);
+}
+
 void FileDB::add_symbol(Symbol* symbol, TSNode& node) {
   symbol_points[symbol] = FileDB::Point::From(this, node);
 }
@@ -73,7 +125,8 @@ std::ostream& FileDB::File::Print(std::ostream& out, const FileDB::File& file) {
 }
 
 std::ostream& FileDB::Point::Print(std::ostream& out, const FileDB& file_db, const FileDB::Point& point) {
-  out << file_db.files[point.file].filepath << ":" << point.row+1 << ":" << point.column+1;
+  FileDB::Location location = file_db.locate(point);
+  out << file_db.files[location.file].filepath << ":" << location.row+1 << ":" << location.column+1;
   return out;
 }
 
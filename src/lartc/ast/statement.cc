@@ -1,6 +1,7 @@
 #include "lartc/ast/expression.hh"
 #include <cassert>
 #include <lartc/ast/statement.hh>
+#include <lartc/ast/walk.hh>
 #include <lartc/internal_errors.hh>
 
 Statement* Statement::New(statement_t kind) {
@@ -20,23 +21,11 @@ Statement* Statement::New(statement_t kind) {
 }
 
 void Statement::Delete(Statement*& stmt) {
-  if (stmt != nullptr) {
-    for (Statement*& child : stmt->children) {
-      Statement::Delete(child);
-    }
-    stmt->children = {};
-    stmt->name = "";
-    Type::Delete(stmt->type);
-    Expression::Delete(stmt->condition);
-    Statement::Delete(stmt->then);
-    Statement::Delete(stmt->else_);
-    Statement::Delete(stmt->init);
-    Expression::Delete(stmt->step);
-    Statement::Delete(stmt->body);
-    Expression::Delete(stmt->expr);
-    delete stmt;
-    stmt = nullptr;
-  }
+  walk_statement(stmt, [](Statement* node) {
+    Type::Delete(node->type);
+    delete node;
+  }, Expression::DeleteNode);
+  stmt = nullptr;
 }
 
 std::ostream& Statement::Print(std::ostream& out, const Statement* stmt, std::uintmax_t tabulation) {
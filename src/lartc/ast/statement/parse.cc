@@ -11,21 +11,17 @@
 inline Statement* parse_statement_block(TSContext& context, TSNode& node) {
   Statement* block = Statement::New(statement_t::BLOCK_STMT);
 
-  std::uintmax_t child_count = ts_node_named_child_count(node);
-  for (std::uintmax_t child_index = 0; child_index < child_count; ++child_index) {
-    TSNode child_node = ts_node_named_child(node, child_index);
-    const char* symbol_name = ts_language_symbol_name(context.language, ts_node_grammar_symbol(child_node));
-    if (!ts_can_ignore(symbol_name)) {
+  ts_for_each_named_child(node, [&](TSNode child_node) {
+    if (!ts_can_ignore(context.symbols, ts_node_grammar_symbol(child_node))) {
       Statement* child_stmt = parse_statement(context, child_node);
       if (child_stmt != nullptr) {
         block->children.push_back(child_stmt);
       } else {
-        if (!ts_can_ignore(symbol_name)) {
-          throw_internal_error(UNHANDLED_TS_SYMBOL_NAME, MSG(": " << std::string(symbol_name) << " inside a (block)"));
-        }
+        const char* symbol_name = ts_language_symbol_name(context.language, ts_node_grammar_symbol(child_node));
+        throw_internal_error(UNHANDLED_TS_SYMBOL_NAME, MSG(": " << std::string(symbol_name) << " inside a (block)"));
       }
     }
-  }
+  });
 
   return block;
 }
@@ -33,14 +29,14 @@ inline Statement* parse_statement_block(TSContext& context, TSNode& node) {
 inline Statement* parse_statement_let(TSContext& context, TSNode& node) {
   Statement* let = Statement::New(statement_t::LET_STMT);
   
-  TSNode name = ts_node_child_by_field_name(node, "name");
+  TSNode name = ts_node_child_by_field_id(node, context.fields.name);
   let->name = ts_node_source_code(name, context.source_code);
 
-  TSNode type = ts_node_child_by_field_name(node, "type");
+  TSNode type = ts_node_child_by_field_id(node, context.fields.type);
   let->type = parse_type(context, type);
   ts_validate_parsing(context.language, type, "let:type", let->type);
 
-  TSNode value = ts_node_child_by_field_name(node, "value");
+  TSNode value = ts_node_child_by_field_id(node, context.fields.value);
   if (value.id != nullptr) {
     let->expr = parse_expression(context, value);
     ts_validate_parsing(context.language, value, "let:value", let->expr);
@@ -52,7 +48,7 @@ inline Statement* parse_statement_let(TSContext& context, TSNode& node) {
 
 inline Statement* parse_statement_return(TSContext& context, TSNode& node) {
   Statement* return_ = Statement::New(statement_t::RETURN_STMT);
-  TSNode value = ts_node_child_by_field_name(node, "value");
+  TSNode value = ts_node_child_by_field_id(node, context.fields.value);
   if (value.id != nullptr) {
     return_->expr = parse_expression(context, value);
     ts_validate_parsing(context.language, value, "return:value", return_->expr);
@@ -74,15 +70,15 @@ inline Statement* parse_statement_continue(TSContext& /*context*/, TSNode& /*nod
 inline Statement* parse_statement_if_else(TSContext& context, TSNode& node) {
   Statement* if_else = Statement::New(statement_t::IF_ELSE_STMT);
 
-  TSNode condition = ts_node_child_by_field_name(node, "condition");
+  TSNode condition = ts_node_child_by_field_id(node, context.fields.condition);
   if_else->condition = parse_expression(context, condition);
   ts_validate_parsing(context.language, condition, "for:condition", if_else->condition);
 
-  TSNode then = ts_node_child_by_field_name(node, "then");
+  TSNode then = ts_node_child_by_field_id(node, context.fields.then);
   if_else->then = parse_statement(context, then);
   ts_validate_parsing(context.language, then, "if_else:then", if_else->then);
 
-  TSNode else_ = ts_node_child_by_field_name(node, "else");
+  TSNode else_ = ts_node_child_by_field_id(node, context.fields.else_);
   if (else_.id) {
     if_else->else_ = parse_statement(context, else_);
     ts_validate_parsing(context.language, else_, "if_else:else", if_else->else_);
@@ -94,19 +90,19 @@ inline Statement* parse_statement_if_else(TSContext& context, TSNode& node) {
 inline Statement* parse_statement_for(TSContext& context, TSNode& node) {
   Statement* for_ = Statement::New(statement_t::FOR_STMT);
 
-  TSNode init = ts_node_child_by_field_name(node, "init");
+  TSNode init = ts_node_child_by_field_id(node, context.fields.init);
   for_->init = parse_statement(context, init);
   ts_validate_parsing(context.language, init, "for:init", for_->init);
 
-  TSNode condition = ts_node_child_by_field_name(node, "condition");
+  TSNode condition = ts_node_child_by_field_id(node, context.fields.condition);
   for_->condition = parse_expression(context, condition);
   ts_validate_parsing(context.language, condition, "for:condition", for_->condition);
 
-  TSNode step = ts_node_child_by_field_name(node, "step");
+  TSNode step = ts_node_child_by_field_id(node, context.fields.step);
   for_->step = parse_expression(context, step);
   ts_validate_parsing(context.language, step, "for:step", for_->step);
 
-  TSNode body = ts_node_child_by_field_name(node, "body");
+  TSNode body = ts_node_child_by_field_id(node, context.fields.body);
   for_->body = parse_statement(context, body);
   ts_validate_parsing(context.language, body, "for:body", for_->body);
 
@@ -116,11 +112,11 @@ inline Statement* parse_statement_for(TSContext& context, TSNode& node) {
 inline Statement* parse_statement_while(TSContext& context, TSNode& node) {
   Statement* while_ = Statement::New(statement_t::WHILE_STMT);
 
-  TSNode condition = ts_node_child_by_field_name(node, "condition");
+  TSNode condition = ts_node_child_by_field_id(node, context.fields.condition);
   while_->condition = parse_expression(context, condition);
   ts_validate_parsing(context.language, condition, "while:condition", while_->condition);
 
-  TSNode body = ts_node_child_by_field_name(node, "body");
+  TSNode body = ts_node_child_by_field_id(node, context.fields.body);
   while_->body = parse_statement(context, body);
   ts_validate_parsing(context.language, body, "while:body", while_->body);
 
@@ -141,10 +137,10 @@ std::unordered_map<std::string, statement_parser> statement_parsers = {
 };
 
 Statement* parse_statement(TSContext& context, TSNode& node) {
-  const char* symbol_name = ts_language_symbol_name(context.language, ts_node_grammar_symbol(node));
-  auto it = statement_parsers.find(symbol_name);
-  if (it != statement_parsers.end()) {
-    return it->second(context, node);
+  static const std::vector<statement_parser> dispatch_table = ts_build_dispatch_table(context.language, statement_parsers);
+  statement_parser parser = ts_dispatch(dispatch_table, ts_node_grammar_symbol(node));
+  if (parser != nullptr) {
+    return parser(context, node);
   } else {
     Expression* expr = parse_expression(context, node);
     if (expr != nullptr) {
@@ -7,13 +7,14 @@
 Type* Type::New(type_t kind) {
   return new Type {
     .kind = kind,
-    .size = 0,
     .is_signed = false,
+    .is_variadic = false,
+    .is_restrict = false,
+    .size = 0,
     .subtype = nullptr,
     .symbol = {},
     .fields = {},
-    .parameters = {},
-    .is_variadic = false
+    .parameters = {}
   };
 }
 
@@ -34,6 +35,7 @@ void Type::Delete(Type*& type) {
     }
     type->parameters = {};
     type->is_variadic = false;
+    type->is_restrict = false;
 
     delete type;
     type = nullptr;
@@ -58,6 +60,7 @@ Type* Type::Clone(const Type* other) {
     type->parameters.push_back({item.first, Type::Clone(item.second)});
   }
   type->is_variadic = true;
+  type->is_restrict = other->is_restrict;
   return type;
 }
 
@@ -73,9 +76,11 @@ std::ostream& Type::Print(std::ostream& out, const Type* type, std::uintmax_t ta
     case type_t::BOOLEAN_TYPE:
       return out << "bool";
     case type_t::POINTER_TYPE:
-      return Type::Print(out << "&", type->subtype);
+      return Type::Print(out << (type->is_restrict ? "&restrict " : "&"), type->subtype);
     case type_t::ARRAY_TYPE:
       return Type::Print(out << "[", type->subtype) << ", " << type->size << "]";
+    case type_t::VECTOR_TYPE:
+      return Type::Print(out << "vec<", type->subtype) << ", " << type->size << ">";
     case type_t::SYMBOL_TYPE:
       return Symbol::Print(out, type->symbol);
     case type_t::VOID_TYPE:
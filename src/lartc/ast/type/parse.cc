@@ -1,5 +1,6 @@
 #include <lartc/ast/parse.hh>
 #include <lartc/ast/type/parse.hh>
+#include <lartc/external_errors.hh>
 #include <lartc/internal_errors.hh>
 #include <lartc/tree_sitter.hh>
 #include <ios>
@@ -13,10 +14,10 @@
 Type* parse_type_integer(TSContext& context, TSNode& node) {
   Type* type = Type::New(type_t::INTEGER_TYPE);
 
-  TSNode size = ts_node_child_by_field_name(node, "size");
+  TSNode size = ts_node_child_by_field_id(node, context.fields.size);
   type->size = std::stoi(ts_node_source_code(size, context.source_code));
 
-  TSNode is_signed = ts_node_child_by_field_name(node, "signed");
+  TSNode is_signed = ts_node_child_by_field_id(node, context.fields.signed_);
   std::stringstream(ts_node_source_code(is_signed, context.source_code)) >> std::boolalpha >> type->is_signed >> std::noboolalpha;
 
   return type;
@@ -25,7 +26,7 @@ Type* parse_type_integer(TSContext& context, TSNode& node) {
 Type* parse_type_double(TSContext& context, TSNode& node) {
   Type* type = Type::New(type_t::DOUBLE_TYPE);
 
-  TSNode size = ts_node_child_by_field_name(node, "size");
+  TSNode size = ts_node_child_by_field_id(node, context.fields.size);
   type->size = std::stoi(ts_node_source_code(size, context.source_code));
 
   return type;
@@ -40,26 +41,29 @@ Type* parse_type_boolean(TSContext& /*context*/, TSNode& /*node*/) {
 Type* parse_type_pointer(TSContext& context, TSNode& node) {
   Type* type = Type::New(type_t::POINTER_TYPE);
 
-  TSNode subtype = ts_node_child_by_field_name(node, "type");
+  TSNode subtype = ts_node_child_by_field_id(node, context.fields.type);
   type->subtype = parse_type(context, subtype);
   if (type->subtype == nullptr) {
     const char* symbol_name = ts_language_symbol_name(context.language, ts_node_grammar_symbol(subtype));
     throw_internal_error(UNHANDLED_TS_SYMBOL_NAME, MSG(": " << std::string(symbol_name) << " inside a (pointer)"));
   }
+
+  TSNode restrict_ = ts_node_child_by_field_id(node, context.fields.restrict);
+  type->is_restrict = restrict_.id != nullptr;
   return type;
 }
 
 Type* parse_type_array(TSContext& context, TSNode& node) {
   Type* type = Type::New(type_t::ARRAY_TYPE);
 
-  TSNode subtype = ts_node_child_by_field_name(node, "type");
+  TSNode subtype = ts_node_child_by_field_id(node, context.fields.type);
   type->subtype = parse_type(context, subtype);
   if (type->subtype == nullptr) {
     const char* symbol_name = ts_language_symbol_name(context.language, ts_node_grammar_symbol(subtype));
     throw_internal_error(UNHANDLED_TS_SYMBOL_NAME, MSG(": " << std::string(symbol_name) << " inside a (pointer)"));
   }
 
-  TSNode size = ts_node_child_by_field_name(node, "length");
+  TSNode size = ts_node_child_by_field_id(node, context.fields.length);
   if (size.id) {
     type->size = std::stoi(ts_node_source_code(size, context.source_code));
   } else {
@@ -68,6 +72,25 @@ Type* parse_type_array(TSContext& context, TSNode& node) {
   return type;
 }
 
+Type* parse_type_vector(TSContext& context, TSNode& node) {
+  Type* type = Type::New(type_t::VECTOR_TYPE);
+
+  TSNode subtype = ts_node_child_by_field_id(node, context.fields.type);
+  type->subtype = parse_type(context, subtype);
+  if (type->subtype == nullptr) {
+    const char* symbol_name = ts_language_symbol_name(context.language, ts_node_grammar_symbol(subtype));
+    throw_internal_error(UNHANDLED_TS_SYMBOL_NAME, MSG(": " << std::string(symbol_name) << " inside a (vector)"));
+  }
+
+  TSNode size = ts_node_child_by_field_id(node, context.fields.length);
+  type->size = std::stoi(ts_node_source_code(size, context.source_code));
+  if (type->size == 0) {
+    TSPoint point = ts_node_start_point(size);
+    throw_vector_should_have_at_least_one_lane(context.filepath, point, context.source_code, ts_node_start_byte(size));
+  }
+  return type;
+}
+
 Type* parse_type_symbol(TSContext& context, TSNode& node) {
   Type* type = Type::New(type_t::SYMBOL_TYPE);
   type->symbol = Symbol::From(ts_node_source_code(node, context.source_code));
@@ -83,7 +106,7 @@ Type* parse_type_void(TSContext& /*context*/, TSNode& /*node*/) {
 Type* parse_type_struct(TSContext& context, TSNode& node) {
   Type* type = Type::New(type_t::STRUCT_TYPE);
   
-  TSNode fields = ts_node_child_by_field_name(node, "fields");
+  TSNode fields = ts_node_child_by_field_id(node, context.fields.fields);
   auto parsed = parse_field_parameter_list(context, fields);
   type->fields = parsed.first;
 
@@ -94,12 +117,12 @@ Type* parse_type_function(TSContext& context, TSNode& node) {
 
   Type* type = Type::New(type_t::FUNCTION_TYPE);
   
-  TSNode parameters = ts_node_child_by_field_name(node, "parameters");
+  TSNode parameters = ts_node_child_by_field_id(node, context.fields.parameters);
   auto parsed = parse_field_parameter_list(context, parameters);
   type->parameters = parsed.first;
   type->is_variadic = parsed.second;
 
-  TSNode subtype = ts_node_child_by_field_name(node, "type");
+  TSNode subtype = ts_node_child_by_field_id(node, context.fields.type);
   if (subtype.id) {
     type->subtype = parse_type(context, subtype);
   } else {
@@ -116,6 +139,7 @@ std::unordered_map<std::string, type_parser> type_parsers = {
   {"boolean_type", parse_type_boolean},
   {"pointer_type", parse_type_pointer},
   {"array_type", parse_type_array},
+  {"vector_type", parse_type_vector},
   {"identifier", parse_type_symbol},
   {"scoped_identifier", parse_type_symbol},
   {"void_type", parse_type_void},
@@ -124,10 +148,10 @@ std::unordered_map<std::string, type_parser> type_parsers = {
 };
 
 Type* parse_type(TSContext& context, TSNode& node) {
-  const char* symbol_name = ts_language_symbol_name(context.language, ts_node_grammar_symbol(node));
-  auto it = type_parsers.find(symbol_name);
-  if (it != type_parsers.end()) {
-    Type* type = it->second(context, node);
+  static const std::vector<type_parser> dispatch_table = ts_build_dispatch_table(context.language, type_parsers);
+  type_parser parser = ts_dispatch(dispatch_table, ts_node_grammar_symbol(node));
+  if (parser != nullptr) {
+    Type* type = parser(context, node);
     if (type != nullptr) {
       context.file_db->add_type(type, node);
     }
@@ -0,0 +1,31 @@
+#include <lartc/attributes/attribute_cache.hh>
+
+const FunctionSummary* AttributeCache::get_summary(Declaration* function) const {
+  auto it = summaries.find(function);
+  if (it == summaries.end())
+    return nullptr;
+  return &it->second;
+}
+
+std::ostream& AttributeCache::Print(std::ostream& out, AttributeCache& attribute_cache) {
+  out << "# Attribute Cache" << std::endl << std::endl;
+  for (auto& item : attribute_cache.summaries) {
+    Declaration::PrintShort(out << " - ", item.first) << ":";
+    if (item.second.nounwind)
+      out << " nounwind";
+    if (item.second.norecurse)
+      out << " norecurse";
+    if (item.second.willreturn)
+      out << " willreturn";
+    if (item.second.memory == MEMORY_EFFECT_NONE)
+      out << " memory(none)";
+    if (item.second.memory == MEMORY_EFFECT_READ)
+      out << " memory(read)";
+    for (std::uintmax_t index = 0; index < item.second.nocapture.size(); ++index) {
+      if (item.second.nocapture[index])
+        out << " nocapture(" << item.first->parameters[index].first << ")";
+    }
+    out << std::endl;
+  }
+  return out;
+}
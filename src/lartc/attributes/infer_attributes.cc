@@ -0,0 +1,463 @@
+#include <lartc/attributes/infer_attributes.hh>
+#include <lartc/api/config.hh>
+#include <algorithm>
+#include <cassert>
+#include <set>
+
+// What a function does by itself, without looking inside of its callees
+struct LocalEffects {
+  bool has_loops;
+  bool has_unknown_calls;
+  // checked arithmetic branches to llvm.trap
+  bool may_trap;
+  memory_effect_t memory;
+  std::set<Declaration*> callees;
+  std::vector<bool> captured;
+  std::vector<bool> nocapture;
+};
+
+struct InferContext {
+  SymbolCache& symbol_cache;
+  TypeCache& type_cache;
+  Declaration* function;
+  LocalEffects& effects;
+};
+
+inline void raise_memory_effect(memory_effect_t& memory, memory_effect_t effect) {
+  memory = std::max(memory, effect);
+}
+
+void collect_defined_functions(Declaration* decl, std::vector<Declaration*>& functions) {
+  switch (decl->kind) {
+    case declaration_t::MODULE_DECL:
+      for (Declaration* child : decl->children) {
+        collect_defined_functions(child, functions);
+      }
+      break;
+    case declaration_t::FUNCTION_DECL:
+      if (decl->body != nullptr) {
+        functions.push_back(decl);
+      }
+      break;
+    case declaration_t::TYPE_DECL:
+    case declaration_t::STATIC_VARIABLE_DECL:
+      break;
+  }
+}
+
+Type* resolve_type(InferContext& context, Type* type) {
+  std::uintmax_t depth = 0;
+  while (type != nullptr && type->kind == type_t::SYMBOL_TYPE && depth++ < 64) {
+    Declaration* decl = context.symbol_cache.get_declaration(context.function, type->symbol);
+    if (decl == nullptr || decl->kind != declaration_t::TYPE_DECL)
+      return type;
+    type = decl->type;
+  }
+  return type;
+}
+
+type_t resolve_type_kind(InferContext& context, Type* type) {
+  type = resolve_type(context, type);
+  return type == nullptr ? type_t::VOID_TYPE : type->kind;
+}
+
+// integer add, sub and mul are checked under the trapping overflow mode
+bool is_checked_arithmetic(InferContext& context, Expression* expr) {
+  if (API::OVERFLOW_MODE != API::TRAP_OVERFLOW || (expr->operator_ != ADD_OP && expr->operator_ != SUB_OP && expr->operator_ != MUL_OP))
+    return false;
+  auto it = context.type_cache.expression_types.find(expr);
+  if (it == context.type_cache.expression_types.end())
+    return true;
+  Type* type = resolve_type(context, it->second);
+  if (type != nullptr && type->kind == type_t::VECTOR_TYPE)
+    type = resolve_type(context, type->subtype);
+  return type != nullptr && type->kind == type_t::INTEGER_TYPE;
+}
+
+// a place is local when it lives inside of the stack frame of the function (locals and parameters)
+bool is_local_place(InferContext& context, Expression* expr) {
+  switch (expr->kind) {
+    case expression_t::SYMBOL_EXPR:
+      return context.symbol_cache.get_statement(expr) != nullptr || context.symbol_cache.get_parameter(expr) != nullptr;
+    case expression_t::BINARY_EXPR:
+      return expr->operator_ == DOT_OP && is_local_place(context, expr->left);
+    case expression_t::ARRAY_ACCESS_EXPR:
+      {
+        auto it = context.type_cache.expression_types.find(expr->left);
+        if (it == context.type_cache.expression_types.end())
+          return false;
+        type_t kind = resolve_type_kind(context, it->second);
+        return (kind == type_t::ARRAY_TYPE || kind == type_t::VECTOR_TYPE) && is_local_place(context, expr->left);
+      }
+    default:
+      return false;
+  }
+}
+
+void infer_attributes(InferContext& context, Expression* expr, bool pointer_use = false);
+
+// the address of a place escapes together with every pointer it is derived from
+void infer_address_attributes(InferContext& context, Expression* place) {
+  switch (place->kind) {
+    case expression_t::BINARY_EXPR:
+      if (get_operator_category(place->operator_) == FIELD_ACCESS_OPC) {
+        infer_address_attributes(context, place->left);
+        return;
+      }
+      if (get_operator_category(place->operator_) == POINTED_FIELD_ACCESS_OPC) {
+        infer_attributes(context, place->left);
+        return;
+      }
+      break;
+    case expression_t::ARRAY_ACCESS_EXPR:
+      {
+        auto it = context.type_cache.expression_types.find(place->left);
+        type_t kind = it == context.type_cache.expression_types.end() ? type_t::SYMBOL_TYPE : resolve_type_kind(context, it->second);
+        if (kind == type_t::ARRAY_TYPE || kind == type_t::VECTOR_TYPE) {
+          infer_address_attributes(context, place->left);
+        } else {
+          infer_attributes(context, place->left);
+        }
+        infer_attributes(context, place->right);
+        return;
+      }
+    case expression_t::MONARY_EXPR:
+      if (place->operator_ == MUL_OP) {
+        infer_attributes(context, place->value);
+        return;
+      }
+      break;
+    default:
+      break;
+  }
+  infer_attributes(context, place);
+}
+
+// pointer_use is true when the value is only dereferenced or compared, so it cannot escape
+void infer_attributes(InferContext& context, Expression* expr, bool pointer_use) {
+  switch (expr->kind) {
+    case expression_t::SYMBOL_EXPR:
+      {
+        if (Declaration* decl = context.symbol_cache.get_declaration(context.function, expr->symbol)) {
+          // defined constants are not memory llvm has to read
+          if (decl->kind == declaration_t::STATIC_VARIABLE_DECL && !(decl->is_const && decl->value != nullptr)) {
+            raise_memory_effect(context.effects.memory, MEMORY_EFFECT_READ);
+          }
+        } else if (std::pair<std::string, Type*>* param = context.symbol_cache.get_parameter(expr)) {
+          if (!pointer_use) {
+            std::uintmax_t index = param - context.function->parameters.data();
+            assert(index < context.effects.captured.size());
+            context.effects.captured[index] = true;
+          }
+        }
+        break;
+      }
+    case expression_t::INTEGER_EXPR:
+    case expression_t::DOUBLE_EXPR:
+    case expression_t::BOOLEAN_EXPR:
+    case expression_t::NULLPTR_EXPR:
+    case expression_t::CHARACTER_EXPR:
+    case expression_t::STRING_EXPR:
+    case expression_t::SIZEOF_EXPR:
+      break;
+    case expression_t::CALL_EXPR:
+      {
+        if (const builtin_t* builtin = context.symbol_cache.get_builtin(expr->callable)) {
+          std::uintmax_t pointer_arguments = 0;
+          switch (*builtin) {
+            case MEMCPY_BUILTIN:
+              raise_memory_effect(context.effects.memory, MEMORY_EFFECT_WRITE);
+              pointer_arguments = 2;
+              break;
+            case MEMSET_BUILTIN:
+              raise_memory_effect(context.effects.memory, MEMORY_EFFECT_WRITE);
+              pointer_arguments = 1;
+              break;
+            case PREFETCH_BUILTIN:
+              raise_memory_effect(context.effects.memory, MEMORY_EFFECT_READ);
+              pointer_arguments = 1;
+              break;
+            case EXPECT_BUILTIN:
+            case ASSUME_BUILTIN:
+            case POPCOUNT_BUILTIN:
+            case CLZ_BUILTIN:
+            case CTZ_BUILTIN:
+            case ROTL_BUILTIN:
+            case ROTR_BUILTIN:
+            case FSHL_BUILTIN:
+            case FSHR_BUILTIN:
+              break;
+          }
+          for (std::uintmax_t index = 0; index < expr->arguments.size(); ++index) {
+            infer_attributes(context, expr->arguments[index], index < pointer_arguments);
+          }
+          break;
+        }
+
+        Declaration* callee = nullptr;
+        if (expr->callable->kind == expression_t::SYMBOL_EXPR) {
+          callee = context.symbol_cache.get_declaration(context.function, expr->callable->symbol);
+        }
+        if (callee != nullptr && callee->kind == declaration_t::FUNCTION_DECL && callee->body != nullptr) {
+          context.effects.callees.insert(callee);
+        } else if (callee != nullptr && callee->kind == declaration_t::FUNCTION_DECL) {
+          // externs can unwind and call us back, but can promise not to write
+          context.effects.has_unknown_calls = true;
+          raise_memory_effect(context.effects.memory, (callee->attributes & ATTRIBUTE_PURE) ? MEMORY_EFFECT_READ : MEMORY_EFFECT_WRITE);
+        } else {
+          context.effects.has_unknown_calls = true;
+          raise_memory_effect(context.effects.memory, MEMORY_EFFECT_WRITE);
+          infer_attributes(context, expr->callable);
+        }
+        for (Expression* argument : expr->arguments) {
+          infer_attributes(context, argument);
+        }
+        break;
+      }
+    case expression_t::BINARY_EXPR:
+      {
+        switch (get_operator_category(expr->operator_)) {
+          case FIELD_ACCESS_OPC:
+            infer_attributes(context, expr->left);
+            break;
+          case POINTED_FIELD_ACCESS_OPC:
+            raise_memory_effect(context.effects.memory, MEMORY_EFFECT_READ);
+            infer_attributes(context, expr->left, true);
+            break;
+          case ASSIGNMENT_OPC:
+            if (!is_local_place(context, expr->left)) {
+              raise_memory_effect(context.effects.memory, MEMORY_EFFECT_WRITE);
+            }
+            // overwriting a local (or a parameter) does not make it escape
+            if (expr->left->kind != expression_t::SYMBOL_EXPR) {
+              infer_attributes(context, expr->left);
+            }
+            infer_attributes(context, expr->right);
+            break;
+          case LOGICAL_OPC:
+            infer_attributes(context, expr->left, true);
+            infer_attributes(context, expr->right, true);
+            break;
+          case ALGEBRAIC_OPC:
+            context.effects.may_trap |= is_checked_arithmetic(context, expr);
+            infer_attributes(context, expr->left);
+            infer_attributes(context, expr->right);
+            break;
+        }
+        break;
+      }
+    case expression_t::ARRAY_ACCESS_EXPR:
+      {
+        if (is_local_place(context, expr)) {
+          infer_attributes(context, expr->left);
+        } else {
+          raise_memory_effect(context.effects.memory, MEMORY_EFFECT_READ);
+          infer_attributes(context, expr->left, true);
+        }
+        infer_attributes(context, expr->right);
+        break;
+      }
+    case expression_t::MONARY_EXPR:
+      {
+        if (expr->operator_ == MUL_OP) {
+          raise_memory_effect(context.effects.memory, MEMORY_EFFECT_READ);
+          infer_attributes(context, expr->value, true);
+        } else if (expr->operator_ == AND_OP) {
+          infer_address_attributes(context, expr->value);
+        } else {
+          infer_attributes(context, expr->value);
+        }
+        break;
+      }
+    case expression_t::CAST_EXPR:
+    case expression_t::BITCAST_EXPR:
+      infer_attributes(context, expr->value);
+      break;
+    case expression_t::VANEXT_EXPR:
+      raise_memory_effect(context.effects.memory, MEMORY_EFFECT_WRITE);
+      break;
+    case expression_t::VECTOR_LOAD_EXPR:
+      raise_memory_effect(context.effects.memory, MEMORY_EFFECT_READ);
+      infer_attributes(context, expr->value, true);
+      break;
+    case expression_t::VECTOR_STORE_EXPR:
+      raise_memory_effect(context.effects.memory, MEMORY_EFFECT_WRITE);
+      infer_attributes(context, expr->left, true);
+      infer_attributes(context, expr->right);
+      break;
+    case expression_t::VECTOR_SHUFFLE_EXPR:
+      infer_attributes(context, expr->left);
+      infer_attributes(context, expr->right);
+      break;
+    case expression_t::AGGREGATE_LITERAL_EXPR:
+      for (Expression* element : expr->arguments) {
+        infer_attributes(context, element);
+      }
+      break;
+  }
+}
+
+void infer_attributes(InferContext& context, Statement* stmt) {
+  switch (stmt->kind) {
+    case statement_t::BLOCK_STMT:
+      for (Statement* child : stmt->children) {
+        infer_attributes(context, child);
+      }
+      break;
+    case statement_t::FOR_STMT:
+      context.effects.has_loops = true;
+      infer_attributes(context, stmt->init);
+      infer_attributes(context, stmt->condition);
+      infer_attributes(context, stmt->step);
+      infer_attributes(context, stmt->body);
+      break;
+    case statement_t::WHILE_STMT:
+      context.effects.has_loops = true;
+      infer_attributes(context, stmt->condition);
+      infer_attributes(context, stmt->body);
+      break;
+    case statement_t::LET_STMT:
+    case statement_t::RETURN_STMT:
+    case statement_t::EXPRESSION_STMT:
+      if (stmt->expr != nullptr) {
+        infer_attributes(context, stmt->expr);
+      }
+      break;
+    case statement_t::IF_ELSE_STMT:
+      infer_attributes(context, stmt->condition);
+      infer_attributes(context, stmt->then);
+      if (stmt->else_ != nullptr) {
+        infer_attributes(context, stmt->else_);
+      }
+      break;
+    case statement_t::BREAK_STMT:
+    case statement_t::CONTINUE_STMT:
+      break;
+  }
+}
+
+LocalEffects compute_local_effects(SymbolCache& symbol_cache, TypeCache& type_cache, Declaration* function) {
+  LocalEffects effects = {
+    .has_loops = false,
+    .has_unknown_calls = false,
+    .may_trap = false,
+    .memory = MEMORY_EFFECT_NONE,
+    .callees = {},
+    .captured = std::vector<bool>(function->parameters.size(), false),
+    .nocapture = std::vector<bool>(function->parameters.size(), false)
+  };
+  InferContext context = {
+    .symbol_cache = symbol_cache,
+    .type_cache = type_cache,
+    .function = function,
+    .effects = effects
+  };
+
+  // va_start writes the va_list, aggregates are read from the caller's copy
+  if (function->is_variadic) {
+    raise_memory_effect(effects.memory, MEMORY_EFFECT_WRITE);
+  }
+  for (std::pair<std::string, Type*>& param : function->parameters) {
+    type_t kind = resolve_type_kind(context, param.second);
+    if (kind == type_t::STRUCT_TYPE || kind == type_t::ARRAY_TYPE || kind == type_t::SYMBOL_TYPE) {
+      raise_memory_effect(effects.memory, MEMORY_EFFECT_READ);
+    }
+  }
+
+  infer_attributes(context, function->body);
+  // the trap may not return, and llvm models it as a write
+  if (effects.may_trap) {
+    raise_memory_effect(effects.memory, MEMORY_EFFECT_WRITE);
+  }
+  for (std::uintmax_t index = 0; index < function->parameters.size(); ++index) {
+    effects.nocapture[index] = resolve_type_kind(context, function->parameters[index].second) == type_t::POINTER_TYPE && !effects.captured[index];
+  }
+  return effects;
+}
+
+bool infer_attributes(SymbolCache& symbol_cache, TypeCache& type_cache, AttributeCache& attribute_cache, Declaration* decl_tree) {
+  std::vector<Declaration*> functions;
+  collect_defined_functions(decl_tree, functions);
+
+  std::map<Declaration*, LocalEffects> effects;
+  for (Declaration* function : functions) {
+    effects[function] = compute_local_effects(symbol_cache, type_cache, function);
+  }
+
+  // norecurse and nounwind depend on every function reachable through the call graph
+  for (Declaration* function : functions) {
+    std::set<Declaration*> reachable;
+    std::vector<Declaration*> worklist(effects[function].callees.begin(), effects[function].callees.end());
+    bool reaches_unknown_calls = effects[function].has_unknown_calls;
+    while (!worklist.empty()) {
+      Declaration* callee = worklist.back();
+      worklist.pop_back();
+      if (!reachable.insert(callee).second)
+        continue;
+      reaches_unknown_calls |= effects[callee].has_unknown_calls;
+      worklist.insert(worklist.end(), effects[callee].callees.begin(), effects[callee].callees.end());
+    }
+
+    LocalEffects& local = effects[function];
+    FunctionSummary& summary = attribute_cache.summaries[function];
+    summary.nounwind = !reaches_unknown_calls;
+    summary.norecurse = !reaches_unknown_calls && !reachable.contains(function);
+    summary.willreturn = summary.norecurse && !local.has_loops && !local.may_trap && !(function->attributes & ATTRIBUTE_NORETURN);
+    summary.memory = local.memory;
+    summary.nocapture = local.nocapture;
+  }
+
+  // memory effects and willreturn are propagated from the callees until nothing changes
+  bool changed = true;
+  while (changed) {
+    changed = false;
+    for (Declaration* function : functions) {
+      FunctionSummary& summary = attribute_cache.summaries[function];
+      for (Declaration* callee : effects[function].callees) {
+        const FunctionSummary& callee_summary = attribute_cache.summaries[callee];
+        if (callee_summary.memory > summary.memory) {
+          summary.memory = callee_summary.memory;
+          changed = true;
+        }
+        if (summary.willreturn && !callee_summary.willreturn) {
+          summary.willreturn = false;
+          changed = true;
+        }
+      }
+    }
+  }
+
+  return true;
+}
+
+bool infer_function_attributes(SymbolCache& symbol_cache, TypeCache& type_cache, AttributeCache& attribute_cache, Declaration* function) {
+  LocalEffects local = compute_local_effects(symbol_cache, type_cache, function);
+
+  // a callee that is nounwind never reaches an unknown call, so it cannot call back into function
+  bool reaches_unknown_calls = local.has_unknown_calls;
+  bool callees_norecurse = !local.callees.contains(function);
+  bool callees_willreturn = true;
+  memory_effect_t memory = local.memory;
+  for (Declaration* callee : local.callees) {
+    if (callee == function)
+      continue;
+    const FunctionSummary* callee_summary = attribute_cache.get_summary(callee);
+    if (callee_summary == nullptr) {
+      reaches_unknown_calls = true;
+      raise_memory_effect(memory, MEMORY_EFFECT_WRITE);
+      continue;
+    }
+    reaches_unknown_calls |= !callee_summary->nounwind;
+    callees_norecurse &= callee_summary->norecurse;
+    callees_willreturn &= callee_summary->willreturn;
+    raise_memory_effect(memory, callee_summary->memory);
+  }
+
+  FunctionSummary& summary = attribute_cache.summaries[function];
+  summary.nounwind = !reaches_unknown_calls;
+  summary.norecurse = !reaches_unknown_calls && callees_norecurse;
+  summary.willreturn = summary.norecurse && callees_willreturn && !local.has_loops && !local.may_trap && !(function->attributes & ATTRIBUTE_NORETURN);
+  summary.memory = memory;
+  summary.nocapture = local.nocapture;
+  return true;
+}
@@ -0,0 +1,10 @@
+#include <lartc/codegen/attribute_store.hh>
+
+std::uintmax_t AttributeStore::get_attribute_group(const std::string& attributes) {
+  auto it = groups.find(attributes);
+  if (it != groups.end())
+    return it->second;
+  std::uintmax_t group = groups.size();
+  groups[attributes] = group;
+  return group;
+}
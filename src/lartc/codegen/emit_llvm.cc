@@ -3,11 +3,15 @@
 #include <iostream>
 #include <lartc/codegen/emit_llvm.hh>
 #include <lartc/codegen/markers.hh>
+#include <lartc/constants/check_constants.hh>
 #include <lartc/typecheck/casting.hh>
 #include <cassert>
 #include <lartc/terminal.hh>
 #include <lartc/serializations.hh>
 #include <unordered_map>
+#include <sstream>
+#include <set>
+#include <algorithm>
 #include <lartc/api/config.hh>
 #include <lartc/api/config.hh>
 
@@ -23,7 +27,7 @@
 
 std::ostream& emit_marker(std::ostream& out, const std::string& marker) {
   // if marker is "%nn" i want to print "nn:"
-  return out << marker.substr(1) << ':';
+  return out.write(marker.data() + 1, marker.size() - 1) << ':';
 }
 
 std::string craft_decl_label(Declaration* decl) {
@@ -71,6 +75,10 @@ Type* extract_subtype(CGContext& context, Declaration* decl, Type* type) {
       {
         return type->subtype;
       }
+    case VECTOR_TYPE:
+      {
+        return type->subtype;
+      }
     case FUNCTION_TYPE:
       {
         return type->subtype;
@@ -135,6 +143,11 @@ bool type_is_pointer(CGContext& context, Declaration* decl, Type* type) {
   return solved.second->kind == POINTER_TYPE;
 }
 
+bool type_is_restrict_pointer(CGContext& context, Declaration* decl, Type* type) {
+  std::pair<Declaration*, Type*> solved = resolve_type_if_symbol(context, decl, type);
+  return solved.second->kind == POINTER_TYPE && solved.second->is_restrict;
+}
+
 bool type_is_array(CGContext& context, Declaration* decl, Type* type) {
   std::pair<Declaration*, Type*> solved = resolve_type_if_symbol(context, decl, type);
   return solved.second->kind == ARRAY_TYPE;
@@ -155,6 +168,41 @@ bool type_is_double(CGContext& context, Declaration* decl, Type* type) {
   return solved.second->kind == DOUBLE_TYPE;
 }
 
+bool type_is_vector(CGContext& context, Declaration* decl, Type* type) {
+  std::pair<Declaration*, Type*> solved = resolve_type_if_symbol(context, decl, type);
+  return solved.second->kind == VECTOR_TYPE;
+}
+
+// element type for vectors, the type itself otherwise
+std::pair<Declaration*, Type*> extract_element_type(CGContext& context, Declaration* decl, Type* type) {
+  std::pair<Declaration*, Type*> solved = resolve_type_if_symbol(context, decl, type);
+  if (solved.second->kind == VECTOR_TYPE) {
+    return resolve_type_if_symbol(context, solved.first, solved.second->subtype);
+  }
+  return solved;
+}
+
+std::uintmax_t compute_vector_alignment(CGContext& context, Declaration* decl, Type* type, std::intmax_t requested_alignment) {
+  if (requested_alignment != 0) {
+    return requested_alignment;
+  }
+  // natural alignment is the size in bytes rounded up to a power of two
+  std::uintmax_t bytesize = (context.size_cache.compute_size_of(context.symbol_cache, decl, type) + 7) / 8;
+  std::uintmax_t alignment = 1;
+  while (alignment < bytesize) {
+    alignment *= 2;
+  }
+  return alignment;
+}
+
+// how a value crosses a call boundary, following the SysV x86_64 calling convention
+enum abi_pass_t {
+  ABI_DIRECT,  // as its own llvm type
+  ABI_COERCED, // in registers, reinterpreted as the eightbytes it occupies
+  ABI_MEMORY   // through a pointer: byval parameters and sret results
+};
+std::pair<abi_pass_t, std::string> classify_abi(CGContext& context, Declaration* decl, Type* type);
+
 std::ostream& emit_type_specifier(std::ostream& out, CGContext& context, Declaration* decl, Type* type, bool first_level = true, bool function_as_pointer = true) {
   switch (type->kind) {
     case INTEGER_TYPE:
@@ -191,6 +239,16 @@ std::ostream& emit_type_specifier(std::ostream& out, CGContext& context, Declara
         out << " ]";
         break;
       }
+    case VECTOR_TYPE:
+      {
+        // vector elements cannot be named types
+        std::pair<Declaration*, Type*> element = resolve_type_if_symbol(context, decl, type->subtype);
+        out << "<";
+        out << type->size << " x ";
+        emit_type_specifier(out, context, element.first, element.second, false);
+        out << ">";
+        break;
+      }
     case SYMBOL_TYPE:
       {
         // resolve
@@ -226,21 +284,33 @@ std::ostream& emit_type_specifier(std::ostream& out, CGContext& context, Declara
       }
     case FUNCTION_TYPE:
       {
-        emit_type_specifier(out, context, decl, type->subtype) << " (";
+        std::pair<abi_pass_t, std::string> return_abi = classify_abi(context, decl, type->subtype);
         bool first = true;
+        if (return_abi.first == ABI_MEMORY) {
+          out << "void (ptr";
+          first = false;
+        } else if (return_abi.first == ABI_COERCED) {
+          out << return_abi.second << " (";
+        } else {
+          emit_type_specifier(out, context, decl, type->subtype) << " (";
+        }
         for (auto field : type->parameters) {
           if (first) {
             first = false;
           } else {
             out << ", ";
           }
-          emit_type_specifier(out, context, decl, field.second, false);
-          if (type_is_struct(context, decl, field.second) && context.size_cache.compute_size_of(context.symbol_cache, decl, field.second) > API::STRUCT_PASSED_AS_INLINE_SIZE_LIMIT) {
-            out << "*";
+          std::pair<abi_pass_t, std::string> abi = classify_abi(context, decl, field.second);
+          if (abi.first == ABI_MEMORY) {
+            out << "ptr";
+          } else if (abi.first == ABI_COERCED) {
+            out << abi.second;
+          } else {
+            emit_type_specifier(out, context, decl, field.second, false);
           }
         }
         if (type->is_variadic) {
-          if (type->parameters.size() > 0)
+          if (!first)
             out << ", ";
           out << "...";
         }
@@ -254,19 +324,25 @@ std::ostream& emit_type_specifier(std::ostream& out, CGContext& context, Declara
   return out;
 }
 
+std::string craft_type_specifier(CGContext& context, Declaration* decl, Type* type) {
+  std::ostringstream out;
+  emit_type_specifier(out, context, decl, type);
+  return out.str();
+}
+
 void emit_type_truncation(std::ostream& out, CGContext& context, Declaration* func, Type* src_type, const std::string& src_marker, Type* dst_type, const std::string& dst_marker, const std::string& truncator = "trunc") {
-  emit_type_specifier(emit_type_specifier(out << dst_marker << " = " << truncator << " ", context, func, src_type) << " " << src_marker << " to ", context, func, dst_type) << std::endl;
+  emit_type_specifier(emit_type_specifier(out << dst_marker << " = " << truncator << " ", context, func, src_type) << " " << src_marker << " to ", context, func, dst_type) << '\n';
 }
 
 void emit_type_extension(std::ostream& out, CGContext& context, Declaration* func, Type* src_type, const std::string& src_marker, Type* dst_type, const std::string& dst_marker, const std::string& extensor = "zext") {
-  emit_type_specifier(emit_type_specifier(out << dst_marker << " = " << extensor << " ", context, func, src_type) << " " << src_marker << " to ", context, func, dst_type) << std::endl;
+  emit_type_specifier(emit_type_specifier(out << dst_marker << " = " << extensor << " ", context, func, src_type) << " " << src_marker << " to ", context, func, dst_type) << '\n';
 }
 
 void emit_type_bitcast(std::ostream& out, CGContext& context, Declaration* func, Type* src_type, const std::string& src_marker, Type* dst_type, const std::string& dst_marker) {
   if (type_is_pointer(context, func, dst_type) && !type_is_pointer(context, func, src_type)) {
-    emit_type_specifier(emit_type_specifier(out << dst_marker << " = inttoptr ", context, func, src_type) << " " << src_marker << " to ", context, func, dst_type) << std::endl;
+    emit_type_specifier(emit_type_specifier(out << dst_marker << " = inttoptr ", context, func, src_type) << " " << src_marker << " to ", context, func, dst_type) << '\n';
   } else {
-    emit_type_specifier(emit_type_specifier(out << dst_marker << " = bitcast ", context, func, src_type) << " " << src_marker << " to ", context, func, dst_type) << std::endl;
+    emit_type_specifier(emit_type_specifier(out << dst_marker << " = bitcast ", context, func, src_type) << " " << src_marker << " to ", context, func, dst_type) << '\n';
   }
 }
 
@@ -308,12 +384,12 @@ void cast_double_to_double(std::ostream& out, CGContext& context, Declaration* f
 
 void cast_integer_to_double(std::ostream& out, CGContext& context, Declaration* func, Markers& markers, const std::string& value_marker, Type* value_type, Type* requested_type, std::string& output_marker) {
   output_marker = markers.new_marker();
-  emit_type_specifier(emit_type_specifier(out << output_marker << " = sitofp ", context, func, value_type) << " " << value_marker << " to ", context, func, requested_type) << std::endl;
+  emit_type_specifier(emit_type_specifier(out << output_marker << " = sitofp ", context, func, value_type) << " " << value_marker << " to ", context, func, requested_type) << '\n';
 }
 
 void cast_double_to_integer(std::ostream& out, CGContext& context, Declaration* func, Markers& markers, const std::string& value_marker, Type* value_type, Type* requested_type, std::string& output_marker) {
   output_marker = markers.new_marker();
-  emit_type_specifier(emit_type_specifier(out << output_marker << " = fptosi ", context, func, value_type) << " " << value_marker << " to ", context, func, requested_type) << std::endl;
+  emit_type_specifier(emit_type_specifier(out << output_marker << " = fptosi ", context, func, value_type) << " " << value_marker << " to ", context, func, requested_type) << '\n';
 }
 
 void cast_value_to_requested_type(std::ostream& out, CGContext& context, Declaration* func, Markers& markers, const std::string& value_marker, Type* value_type, Type* requested_type, std::string& output_marker, bool is_bitcast = false) {
@@ -323,16 +399,42 @@ void cast_value_to_requested_type(std::ostream& out, CGContext& context, Declara
   }
 
   if (!is_bitcast) {
-    if (type_is_integer(context, func, value_type)) {
-      if (type_is_integer(context, func, requested_type)) {
+    if (type_is_vector(context, func, requested_type) && !type_is_vector(context, func, value_type)) {
+      // splat the scalar over every lane
+      std::pair<Declaration*, Type*> vector = resolve_type_if_symbol(context, func, requested_type);
+      std::pair<Declaration*, Type*> element = resolve_type_if_symbol(context, vector.first, vector.second->subtype);
+      std::string element_marker;
+      cast_value_to_requested_type(out, context, func, markers, value_marker, value_type, element.second, element_marker);
+
+      std::string inserted_marker = markers.new_marker();
+      emit_type_specifier(out << inserted_marker << " = insertelement ", context, func, requested_type) << " poison, ";
+      emit_type_specifier(out, context, func, element.second) << " " << element_marker << ", i64 0" << '\n';
+      output_marker = markers.new_marker();
+      emit_type_specifier(out << output_marker << " = shufflevector ", context, func, requested_type) << " " << inserted_marker << ", ";
+      emit_type_specifier(out, context, func, requested_type) << " poison, <" << vector.second->size << " x i32> zeroinitializer" << '\n';
+      return;
+    }
+
+    // vectors with the same number of lanes are converted element-wise
+    bool elementwise = !type_is_vector(context, func, value_type) && !type_is_vector(context, func, requested_type);
+    if (type_is_vector(context, func, value_type) && type_is_vector(context, func, requested_type)) {
+      elementwise = resolve_type_if_symbol(context, func, value_type).second->size == resolve_type_if_symbol(context, func, requested_type).second->size;
+    }
+    std::pair<Declaration*, Type*> value_element = extract_element_type(context, func, value_type);
+    std::pair<Declaration*, Type*> requested_element = extract_element_type(context, func, requested_type);
+
+    if (!elementwise) {
+      // fallthrough to bitcast
+    } else if (type_is_integer(context, value_element.first, value_element.second)) {
+      if (type_is_integer(context, requested_element.first, requested_element.second)) {
         return cast_integer_to_integer(out, context, func, markers, value_marker, value_type, requested_type, output_marker);
-      } else if (type_is_double(context, func, requested_type)) {
+      } else if (type_is_double(context, requested_element.first, requested_element.second)) {
         return cast_integer_to_double(out, context, func, markers, value_marker, value_type, requested_type, output_marker);
       }
-    } else if (type_is_double(context, func, value_type)) {
-      if (type_is_integer(context, func, requested_type)) {
+    } else if (type_is_double(context, value_element.first, value_element.second)) {
+      if (type_is_integer(context, requested_element.first, requested_element.second)) {
         return cast_double_to_integer(out, context, func, markers, value_marker, value_type, requested_type, output_marker);
-      } else if (type_is_double(context, func, requested_type)) {
+      } else if (type_is_double(context, requested_element.first, requested_element.second)) {
         return cast_double_to_double(out, context, func, markers, value_marker, value_type, requested_type, output_marker);
       }
     }
@@ -411,7 +513,9 @@ Type* decide_logic_operand_type(CGContext& context, Declaration* decl, Type* lef
   }
 
   Type* type = nullptr;
-  if (left->kind == DOUBLE_TYPE || right->kind == DOUBLE_TYPE) {
+  if (left->kind == VECTOR_TYPE) {
+    type = Type::Clone(left);
+  } else if (left->kind == DOUBLE_TYPE || right->kind == DOUBLE_TYPE) {
     if (left->kind  == DOUBLE_TYPE) {
       type = Type::Clone(left);
     }
@@ -450,21 +554,110 @@ Type* cast_operands_to_biggest_type(std::ostream& out, CGContext& context, Marke
   return cast_operands_to_expression_type(out, context, markers, func, left_type, left_marker, right_type, right_marker, decide_logic_operand_type(context, func, left_type, right_type));
 }
 
+std::string craft_fast_math_flags(Declaration* func) {
+  std::uint32_t flags = API::FAST_MATH_FLAGS;
+  if (func != nullptr && (func->attributes & ATTRIBUTE_FAST_MATH)) {
+    flags = API::FAST_MATH_ALL;
+  }
+  if (flags == API::FAST_MATH_ALL) {
+    return " fast";
+  }
+  std::string result;
+  if (flags & API::FAST_MATH_REASSOC)
+    result += " reassoc";
+  if (flags & API::FAST_MATH_NNAN)
+    result += " nnan";
+  if (flags & API::FAST_MATH_NINF)
+    result += " ninf";
+  if (flags & API::FAST_MATH_NSZ)
+    result += " nsz";
+  if (flags & API::FAST_MATH_ARCP)
+    result += " arcp";
+  if (flags & API::FAST_MATH_CONTRACT)
+    result += " contract";
+  if (flags & API::FAST_MATH_AFN)
+    result += " afn";
+  return result;
+}
+
+// fast-math flags go right after the opcode: `fcmp fast olt`
+std::string craft_floating_point_op(Declaration* func, const std::string& double_op) {
+  std::string::size_type space = double_op.find(' ');
+  if (space == std::string::npos)
+    return double_op + craft_fast_math_flags(func);
+  return double_op.substr(0, space) + craft_fast_math_flags(func) + double_op.substr(space);
+}
+
 std::ostream& emit_simple_binary_operation(std::ostream& out, CGContext& context, Declaration* func, const std::string& output_marker, const std::string& left_marker, const std::string& right_marker, Type* type, std::string integer_op, std::string double_op) {
-  if (type_is_integer(context, func, type)) {
-    emit_type_specifier(out << output_marker << " = " << integer_op << " ", context, func, type) << " " << left_marker << ", " << right_marker << std::endl;
-  } else if (type_is_double(context, func, type)) {
-    emit_type_specifier(out << output_marker << " = " << double_op << " ", context, func, type) << " " << left_marker << ", " << right_marker << std::endl;
+  std::pair<Declaration*, Type*> element = extract_element_type(context, func, type);
+  if (type_is_integer(context, element.first, element.second)) {
+    emit_type_specifier(out << output_marker << " = " << integer_op << " ", context, func, type) << " " << left_marker << ", " << right_marker << '\n';
+  } else if (type_is_double(context, element.first, element.second)) {
+    emit_type_specifier(out << output_marker << " = " << craft_floating_point_op(func, double_op) << " ", context, func, type) << " " << left_marker << ", " << right_marker << '\n';
   } else {
-    emit_type_specifier(out << output_marker << " = " << integer_op << " ", context, func, type) << " " << left_marker << ", " << right_marker << std::endl;
+    emit_type_specifier(out << output_marker << " = " << integer_op << " ", context, func, type) << " " << left_marker << ", " << right_marker << '\n';
   }
   return out;
 }
 
+// add, sub and mul on integers honor the overflow mode of the module
+std::ostream& emit_overflowing_binary_operation(std::ostream& out, CGContext& context, Declaration* func, Markers& markers, const std::string& output_marker, const std::string& left_marker, const std::string& right_marker, Type* type, std::string integer_op, std::string double_op) {
+  std::pair<Declaration*, Type*> element = extract_element_type(context, func, type);
+  if (!type_is_integer(context, element.first, element.second)) {
+    return emit_simple_binary_operation(out, context, func, output_marker, left_marker, right_marker, type, integer_op, double_op);
+  }
+
+  bool is_signed = element.second->kind == INTEGER_TYPE && element.second->is_signed;
+  switch (API::OVERFLOW_MODE) {
+    case API::WRAP_OVERFLOW:
+      return emit_simple_binary_operation(out, context, func, output_marker, left_marker, right_marker, type, integer_op, double_op);
+    case API::UNDEFINED_OVERFLOW:
+      // unsigned arithmetic keeps wrapping
+      return emit_simple_binary_operation(out, context, func, output_marker, left_marker, right_marker, type, is_signed ? integer_op + " nsw" : integer_op, double_op);
+    case API::TRAP_OVERFLOW:
+      break;
+  }
+
+  std::string type_specifier = craft_type_specifier(context, func, type);
+  std::string element_specifier = craft_type_specifier(context, element.first, element.second);
+  std::string flag_specifier = "i1";
+  std::string suffix = element_specifier;
+  bool is_vector = type_is_vector(context, func, type);
+  if (is_vector) {
+    std::string lanes = std::to_string(resolve_type_if_symbol(context, func, type).second->size);
+    flag_specifier = "<" + lanes + " x i1>";
+    suffix = "v" + lanes + element_specifier;
+  }
+  std::string pair_specifier = "{" + type_specifier + ", " + flag_specifier + "}";
+  std::string intrinsic = context.intrinsic_store.get_intrinsic(pair_specifier, std::string("llvm.") + (is_signed ? "s" : "u") + integer_op + ".with.overflow." + suffix, type_specifier + ", " + type_specifier);
+
+  std::string checked = markers.new_marker();
+  out << checked << " = call " << pair_specifier << " " << intrinsic << "(" << type_specifier << " " << left_marker << ", " << type_specifier << " " << right_marker << ")" << '\n';
+  out << output_marker << " = extractvalue " << pair_specifier << " " << checked << ", 0" << '\n';
+  std::string overflow = markers.new_marker();
+  out << overflow << " = extractvalue " << pair_specifier << " " << checked << ", 1" << '\n';
+  if (is_vector) {
+    std::string any_lane = markers.new_marker();
+    std::string reduce = context.intrinsic_store.get_intrinsic("i1", "llvm.vector.reduce.or." + suffix.substr(0, suffix.find('i')) + "i1", flag_specifier);
+    out << any_lane << " = call i1 " << reduce << "(" << flag_specifier << " " << overflow << ")" << '\n';
+    overflow = any_lane;
+  }
+
+  std::string on_overflow = markers.new_marker();
+  std::string after_check = markers.new_marker();
+  out << "br i1 " << overflow << ", label " << on_overflow << ", label " << after_check << '\n';
+  emit_marker(out, on_overflow) << '\n';
+  out << "call void " << context.intrinsic_store.get_intrinsic("void", "llvm.trap", "") << "()" << '\n';
+  out << "unreachable" << '\n';
+  emit_marker(out, after_check) << '\n';
+  return out;
+}
+
 std::ostream& emit_integer_only_binary_operation(std::ostream& out, CGContext& context, Declaration* func, const std::string& output_marker, const std::string& left_marker, const std::string& right_marker, Type* type, std::string integer_op) {
-  if (type_is_integer(context, func, type)) {
-    emit_type_specifier(out << output_marker << " = " << integer_op << " ", context, func, type) << " " << left_marker << ", " << right_marker << std::endl;
-  } else if (type_is_double(context, func, type)) {
+  std::pair<Declaration*, Type*> element = extract_element_type(context, func, type);
+  if (type_is_integer(context, element.first, element.second)) {
+    emit_type_specifier(out << output_marker << " = " << integer_op << " ", context, func, type) << " " << left_marker << ", " << right_marker << '\n';
+  } else if (type_is_double(context, element.first, element.second)) {
     assert(false);
   } else {
     assert(false);
@@ -483,47 +676,725 @@ std::uintmax_t compute_field_index(CGContext& context, Declaration* decl, Type*
   return Type::ExtractFieldIndex(left_type, right->symbol);
 }
 
+// size and alignment in bytes, following the natural layout of the x86_64 data layout
+std::pair<std::uintmax_t, std::uintmax_t> compute_abi_layout(CGContext& context, Declaration* decl, Type* type) {
+  std::pair<Declaration*, Type*> solved = resolve_type_if_symbol(context, decl, type);
+  decl = solved.first;
+  type = solved.second;
+  auto round_up = [](std::uintmax_t size, std::uintmax_t alignment) {
+    return (size + alignment - 1) / alignment * alignment;
+  };
+  auto power_of_two = [](std::uintmax_t size) {
+    std::uintmax_t result = 1;
+    while (result < size)
+      result *= 2;
+    return result;
+  };
+  switch (type->kind) {
+    case INTEGER_TYPE:
+      {
+        std::uintmax_t bytesize = (type->size + 7) / 8;
+        std::uintmax_t alignment = std::min<std::uintmax_t>(power_of_two(bytesize), 16);
+        return {round_up(bytesize, alignment), alignment};
+      }
+    case DOUBLE_TYPE:
+      {
+        if (type->size <= 32)
+          return {4, 4};
+        if (type->size <= API::CPU_BIT_SIZE)
+          return {8, 8};
+        return {16, 16};
+      }
+    case BOOLEAN_TYPE:
+    case VOID_TYPE:
+      return {1, 1};
+    case POINTER_TYPE:
+    case FUNCTION_TYPE:
+      return {API::CPU_BIT_SIZE / 8, API::CPU_BIT_SIZE / 8};
+    case ARRAY_TYPE:
+      {
+        std::pair<std::uintmax_t, std::uintmax_t> element = compute_abi_layout(context, decl, type->subtype);
+        return {element.first * type->size, element.second};
+      }
+    case VECTOR_TYPE:
+      {
+        std::uintmax_t alignment = compute_vector_alignment(context, decl, type, 0);
+        std::uintmax_t bytesize = (context.size_cache.compute_size_of(context.symbol_cache, decl, type) + 7) / 8;
+        return {round_up(bytesize, alignment), alignment};
+      }
+    case STRUCT_TYPE:
+      {
+        std::uintmax_t size = 0;
+        std::uintmax_t alignment = 1;
+        for (auto& field : type->fields) {
+          std::pair<std::uintmax_t, std::uintmax_t> layout = compute_abi_layout(context, decl, field.second);
+          size = round_up(size, layout.second) + layout.first;
+          alignment = std::max(alignment, layout.second);
+        }
+        return {round_up(size, alignment), alignment};
+      }
+    case SYMBOL_TYPE:
+      break;
+  }
+  assert(false);
+  return {0, 1};
+}
+
+std::uintmax_t compute_field_offset(CGContext& context, Declaration* decl, Type* struct_type, std::uintmax_t field_index) {
+  std::uintmax_t offset = 0;
+  for (std::uintmax_t index = 0; index <= field_index; ++index) {
+    std::pair<std::uintmax_t, std::uintmax_t> layout = compute_abi_layout(context, decl, struct_type->fields[index].second);
+    offset = (offset + layout.second - 1) / layout.second * layout.second;
+    if (index < field_index)
+      offset += layout.first;
+  }
+  return offset;
+}
+
+// SysV x86_64 class of each eightbyte of a small aggregate
+enum eightbyte_class_t {
+  EIGHTBYTE_NONE,
+  EIGHTBYTE_INTEGER,
+  EIGHTBYTE_SSE
+};
+
+// false when the aggregate holds something not classified here: vectors, scalars wider than an eightbyte
+bool classify_eightbytes(CGContext& context, Declaration* decl, Type* type, std::uintmax_t offset, std::vector<eightbyte_class_t>& classes, std::vector<bool>& has_double) {
+  std::pair<Declaration*, Type*> solved = resolve_type_if_symbol(context, decl, type);
+  decl = solved.first;
+  type = solved.second;
+  switch (type->kind) {
+    case STRUCT_TYPE:
+      {
+        for (std::uintmax_t index = 0; index < type->fields.size(); ++index) {
+          std::uintmax_t field_offset = offset + compute_field_offset(context, decl, type, index);
+          if (!classify_eightbytes(context, decl, type->fields[index].second, field_offset, classes, has_double))
+            return false;
+        }
+        return true;
+      }
+    case ARRAY_TYPE:
+      {
+        std::uintmax_t element_size = compute_abi_layout(context, decl, type->subtype).first;
+        for (std::uintmax_t index = 0; index < type->size; ++index) {
+          if (!classify_eightbytes(context, decl, type->subtype, offset + index * element_size, classes, has_double))
+            return false;
+        }
+        return true;
+      }
+    case INTEGER_TYPE:
+    case DOUBLE_TYPE:
+    case BOOLEAN_TYPE:
+    case POINTER_TYPE:
+    case FUNCTION_TYPE:
+      {
+        std::uintmax_t size = compute_abi_layout(context, decl, type).first;
+        std::uintmax_t index = offset / 8;
+        if (size > 8 || (offset + size - 1) / 8 != index)
+          return false;
+        if (type->kind != DOUBLE_TYPE) {
+          classes[index] = EIGHTBYTE_INTEGER;
+        } else {
+          if (classes[index] == EIGHTBYTE_NONE)
+            classes[index] = EIGHTBYTE_SSE;
+          if (size == 8)
+            has_double[index] = true;
+        }
+        return true;
+      }
+    case VECTOR_TYPE:
+    case VOID_TYPE:
+    case SYMBOL_TYPE:
+      return false;
+  }
+  assert(false);
+  return false;
+}
+
+std::pair<abi_pass_t, std::string> classify_abi(CGContext& context, Declaration* decl, Type* type) {
+  if (!type_is_struct(context, decl, type)) {
+    return {ABI_DIRECT, ""};
+  }
+  std::uintmax_t size = compute_abi_layout(context, decl, type).first;
+  if (size * 8 > API::STRUCT_PASSED_AS_INLINE_SIZE_LIMIT) {
+    return {ABI_MEMORY, ""};
+  }
+  if (size == 0) {
+    return {ABI_DIRECT, ""};
+  }
+  std::vector<eightbyte_class_t> classes((size + 7) / 8, EIGHTBYTE_NONE);
+  std::vector<bool> has_double(classes.size(), false);
+  if (!classify_eightbytes(context, decl, type, 0, classes, has_double)) {
+    return {ABI_DIRECT, ""};
+  }
+  std::vector<std::string> eightbytes;
+  for (std::uintmax_t index = 0; index < classes.size(); ++index) {
+    std::uintmax_t bytes = std::min<std::uintmax_t>(8, size - index * 8);
+    if (classes[index] == EIGHTBYTE_SSE) {
+      eightbytes.push_back(has_double[index] ? "double" : bytes > 4 ? "<2 x float>" : "float");
+    } else {
+      eightbytes.push_back("i" + std::to_string(bytes * 8));
+    }
+  }
+  if (eightbytes.size() == 1) {
+    return {ABI_COERCED, eightbytes[0]};
+  }
+  return {ABI_COERCED, "{ " + eightbytes[0] + ", " + eightbytes[1] + " }"};
+}
+
+// TBAA type descriptor of a type, -1 when the type has none (void, anonymous structs)
+std::intmax_t get_tbaa_type_node(CGContext& context, Declaration* decl, Type* type) {
+  MetadataStore& store = context.metadata_store;
+  std::uintmax_t root = store.add_unique_node("!{!\"lart TBAA\"}");
+  std::uintmax_t omnipotent_char = store.add_unique_node("!{!\"omnipotent char\", !" + std::to_string(root) + ", i64 0}");
+  auto scalar = [&store, omnipotent_char](const std::string& name) -> std::intmax_t {
+    return store.add_unique_node("!{!\"" + name + "\", !" + std::to_string(omnipotent_char) + ", i64 0}");
+  };
+
+  Declaration* named_decl = nullptr;
+  if (type->kind == SYMBOL_TYPE) {
+    std::pair<Declaration*, Type*> solved = resolve_type_if_symbol(context, decl, type);
+    named_decl = solved.first;
+    decl = solved.first;
+    type = solved.second;
+  }
+
+  switch (type->kind) {
+    case INTEGER_TYPE:
+      // bytes can alias anything, signedness does not matter
+      if (type->size <= 8)
+        return omnipotent_char;
+      return scalar("int" + std::to_string(type->size));
+    case DOUBLE_TYPE:
+      if (type->size <= 32)
+        return scalar("float");
+      if (type->size <= API::CPU_BIT_SIZE)
+        return scalar("double");
+      return scalar("fp128");
+    case BOOLEAN_TYPE:
+      return scalar("bool");
+    case POINTER_TYPE:
+    case FUNCTION_TYPE:
+      return scalar("any pointer");
+    case ARRAY_TYPE:
+    case VECTOR_TYPE:
+      return get_tbaa_type_node(context, decl, type->subtype);
+    case STRUCT_TYPE:
+      {
+        if (named_decl == nullptr)
+          return -1;
+        std::string node = "!{!\"" + craft_decl_label(named_decl) + "\"";
+        for (std::uintmax_t index = 0; index < type->fields.size(); ++index) {
+          std::intmax_t member = get_tbaa_type_node(context, decl, type->fields[index].second);
+          if (member < 0)
+            return -1;
+          node += ", !" + std::to_string(member) + ", i64 " + std::to_string(compute_field_offset(context, decl, type, index));
+        }
+        return store.add_unique_node(node + "}");
+      }
+    case VOID_TYPE:
+    case SYMBOL_TYPE:
+      return -1;
+  }
+  return -1;
+}
+
+// access tag for a scalar of access_type, read or written through place (if known)
+std::string craft_tbaa_metadata(CGContext& context, Declaration* func, Expression* place, Type* access_type) {
+  if (!API::STRICT_ALIASING)
+    return "";
+  std::pair<Declaration*, Type*> solved = resolve_type_if_symbol(context, func, access_type);
+  if (solved.second->kind == STRUCT_TYPE || solved.second->kind == ARRAY_TYPE || solved.second->kind == VOID_TYPE)
+    return "";
+  std::intmax_t access = get_tbaa_type_node(context, func, access_type);
+  if (access < 0)
+    return "";
+
+  std::intmax_t base = access;
+  std::uintmax_t offset = 0;
+  if (place != nullptr && place->kind == BINARY_EXPR && (place->operator_ == DOT_OP || place->operator_ == ARR_OP)) {
+    Type* base_type = context.type_cache.expression_types[place->left];
+    if (place->operator_ == ARR_OP) {
+      base_type = resolve_type_if_symbol(context, func, base_type).second->subtype;
+    }
+    std::intmax_t struct_node = get_tbaa_type_node(context, func, base_type);
+    if (struct_node >= 0) {
+      std::pair<Declaration*, Type*> struct_type = resolve_type_if_symbol(context, func, base_type);
+      base = struct_node;
+      offset = compute_field_offset(context, struct_type.first, struct_type.second, compute_field_index(context, func, base_type, place->right));
+    }
+  }
+  std::uintmax_t tag = context.metadata_store.add_unique_node("!{!" + std::to_string(base) + ", !" + std::to_string(access) + ", i64 " + std::to_string(offset) + "}");
+  return ", !tbaa !" + std::to_string(tag);
+}
+
+bool type_is_aggregate(CGContext& context, Declaration* decl, Type* type) {
+  return type_is_struct(context, decl, type) || type_is_array(context, decl, type);
+}
+
+// copies an aggregate with its size and alignment known, instead of a first-class aggregate load and store
+std::ostream& emit_aggregate_memcpy(std::ostream& out, CGContext& context, Declaration* func, const std::string& destination, const std::string& source, Type* type) {
+  std::pair<std::uintmax_t, std::uintmax_t> layout = compute_abi_layout(context, func, type);
+  std::string size_type_specifier = "i" + std::to_string(API::CPU_BIT_SIZE);
+  std::string intrinsic = context.intrinsic_store.get_intrinsic("void", "llvm.memcpy.p0.p0." + size_type_specifier, "ptr, ptr, " + size_type_specifier + ", i1");
+  out << "call void " << intrinsic << "(ptr align " << layout.second << " " << destination << ", ptr align " << layout.second << " " << source;
+  out << ", " << size_type_specifier << " " << layout.first << ", i1 false)" << '\n';
+  return out;
+}
+
+// reinterprets a value through a stack slot, moving small structs in and out of their coerced type
+std::string emit_coercion(std::ostream& out, Markers& markers, const std::string& value_marker, const std::string& from_type, const std::string& to_type, const std::string& coerced_type) {
+  // the slot has the type of the coercion, which is never smaller than the struct
+  std::string slot = markers.new_entry_slot(coerced_type, 8);
+  out << "store " << from_type << " " << value_marker << ", ptr " << slot << ", align 8" << '\n';
+  std::string output_marker = markers.new_marker();
+  out << output_marker << " = load " << to_type << ", ptr " << slot << ", align 8" << '\n';
+  return output_marker;
+}
+
 std::ostream& emit_automatic_return_statement(std::ostream& out, CGContext& context, Declaration* func, Markers& markers) {
-  if (func->type->kind != VOID_TYPE) {
+  std::pair<abi_pass_t, std::string> abi = classify_abi(context, func, func->type);
+  if (func->type->kind != VOID_TYPE && abi.first != ABI_MEMORY) {
+    std::string type_specifier = abi.first == ABI_COERCED ? abi.second : craft_type_specifier(context, func, func->type);
     std::string _implicit_var = markers.new_marker();
     std::string _implicit_rvalue = markers.new_marker();
-    out << _implicit_var << " = alloca ";
-    emit_type_specifier(out, context, func, func->type);
-    out << ", align 8" << std::endl;
-    out << _implicit_rvalue << " = load ";
-    emit_type_specifier(out, context, func, func->type);
-    out << ", ptr " << _implicit_var << ", align 8" << std::endl;
-    out << "ret ";
-    emit_type_specifier(out, context, func, func->type);
-    out << " " << _implicit_rvalue << std::endl;
+    out << _implicit_var << " = alloca " << type_specifier << ", align 8" << '\n';
+    out << _implicit_rvalue << " = load " << type_specifier << ", ptr " << _implicit_var << ", align 8" << '\n';
+    out << "ret " << type_specifier << " " << _implicit_rvalue << '\n';
   } else {
-    out << "ret void" << std::endl;
+    out << "ret void" << '\n';
   }
   return out;
 }
 
-std::ostream& emit_manual_return_statement(std::ostream& out, CGContext& context, Declaration* func, Markers& /*markers*/, const std::string& return_value_marker) {
-  if (func->type->kind != VOID_TYPE) {
+std::ostream& emit_manual_return_statement(std::ostream& out, CGContext& context, Declaration* func, Markers& markers, const std::string& return_value_marker) {
+  std::pair<abi_pass_t, std::string> abi = classify_abi(context, func, func->type);
+  if (func->type->kind != VOID_TYPE && abi.first == ABI_COERCED) {
+    std::string type_specifier = craft_type_specifier(context, func, func->type);
+    std::string coerced_marker = emit_coercion(out, markers, return_value_marker, type_specifier, abi.second, abi.second);
+    out << "ret " << abi.second << " " << coerced_marker << '\n';
+  } else if (func->type->kind != VOID_TYPE && abi.first == ABI_DIRECT) {
     out << "ret ";
     emit_type_specifier(out, context, func, func->type);
-    out << " " << return_value_marker << std::endl;
+    out << " " << return_value_marker << '\n';
   } else {
-    out << "ret void" << std::endl;
+    // results in memory were already copied through the sret pointer
+    out << "ret void" << '\n';
   }
   return out;
 }
 
 std::ostream& emit_variable_allocation(std::ostream& out, CGContext& context, Declaration* func, Markers& markers, Statement* variable) {
   std::string var = markers.get_var(variable);
+  // vectors may ask for more than the usual 8, their lanes are loaded at that alignment
+  std::uintmax_t alignment = std::max<std::uintmax_t>(8, compute_abi_layout(context, func, variable->type).second);
   out << var << " = alloca ";
   emit_type_specifier(out, context, func, variable->type);
-  out << ", align 8" << std::endl;
+  out << ", align " << alignment << '\n';
   return out;
 }
 
 std::ostream& emit_expression_as_lvalue(std::ostream& out, CGContext& context, Declaration* func, Markers& markers, Expression* expression, std::string& output_marker);
 std::ostream& emit_expression_as_rvalue(std::ostream& out, CGContext& context, Declaration* func, Markers& markers, Expression* expression, std::string& output_marker);
 
+// whether an expression lives in memory, so that it can be copied without being loaded
+bool expression_has_address(CGContext& context, Declaration* func, Expression* expression) {
+  switch (expression->kind) {
+    case SYMBOL_EXPR:
+      {
+        if (Declaration* decl = context.symbol_cache.get_declaration(func, expression->symbol)) {
+          return decl->kind == declaration_t::STATIC_VARIABLE_DECL;
+        }
+        return true;
+      }
+    case BINARY_EXPR:
+      {
+        if (expression->operator_ == ARR_OP)
+          return true;
+        if (expression->operator_ == DOT_OP)
+          return expression_has_address(context, func, expression->left);
+        return false;
+      }
+    case ARRAY_ACCESS_EXPR:
+      return true;
+    case MONARY_EXPR:
+      return expression->operator_ == MUL_OP;
+    case CALL_EXPR:
+      {
+        if (context.symbol_cache.get_builtin(expression->callable))
+          return false;
+        Type* callable_type = extract_callable_type(context, func, context.type_cache.expression_types[expression->callable]);
+        return classify_abi(context, func, extract_subtype(context, func, callable_type)).first == ABI_MEMORY;
+      }
+    default:
+      return false;
+  }
+}
+
+// evaluates an aggregate as its address when it has one, as a value otherwise
+bool emit_aggregate_source(std::ostream& out, CGContext& context, Declaration* func, Markers& markers, Expression* expression, std::string& output_marker) {
+  if (expression_has_address(context, func, expression)) {
+    emit_expression_as_lvalue(out, context, func, markers, expression, output_marker);
+    return true;
+  }
+  emit_expression_as_rvalue(out, context, func, markers, expression, output_marker);
+  return false;
+}
+
+std::ostream& emit_aggregate_copy(std::ostream& out, CGContext& context, Declaration* func, const std::string& destination, const std::string& source, bool source_is_address, Type* type, const std::string& metadata) {
+  if (source_is_address) {
+    return emit_aggregate_memcpy(out, context, func, destination, source, type);
+  }
+  std::uintmax_t alignment = compute_abi_layout(context, func, type).second;
+  emit_type_specifier(out << "store ", context, func, type) << " " << source << ", ptr " << destination << ", align " << alignment << metadata << '\n';
+  return out;
+}
+
+// the restrict parameter an address is computed from, if any
+std::pair<std::string, Type*>* find_restrict_base_of_address(CGContext& context, Declaration* func, Expression* address) {
+  switch (address->kind) {
+    case SYMBOL_EXPR:
+      {
+        std::pair<std::string, Type*>* param = context.symbol_cache.get_parameter(address);
+        if (param != nullptr && type_is_restrict_pointer(context, func, param->second))
+          return param;
+        return nullptr;
+      }
+    case BINARY_EXPR:
+      {
+        if (address->operator_ == ADD_OP || address->operator_ == SUB_OP) {
+          if (type_is_pointer(context, func, context.type_cache.expression_types[address->left]))
+            return find_restrict_base_of_address(context, func, address->left);
+          if (address->operator_ == ADD_OP && type_is_pointer(context, func, context.type_cache.expression_types[address->right]))
+            return find_restrict_base_of_address(context, func, address->right);
+        }
+        return nullptr;
+      }
+    case CAST_EXPR:
+    case BITCAST_EXPR:
+      return find_restrict_base_of_address(context, func, address->value);
+    default:
+      return nullptr;
+  }
+}
+
+std::pair<std::string, Type*>* find_restrict_base_of_place(CGContext& context, Declaration* func, Expression* place) {
+  switch (place->kind) {
+    case MONARY_EXPR:
+      if (place->operator_ == MUL_OP)
+        return find_restrict_base_of_address(context, func, place->value);
+      return nullptr;
+    case ARRAY_ACCESS_EXPR:
+      if (type_is_pointer(context, func, context.type_cache.expression_types[place->left]))
+        return find_restrict_base_of_address(context, func, place->left);
+      return find_restrict_base_of_place(context, func, place->left);
+    case BINARY_EXPR:
+      if (place->operator_ == ARR_OP)
+        return find_restrict_base_of_address(context, func, place->left);
+      if (place->operator_ == DOT_OP)
+        return find_restrict_base_of_place(context, func, place->left);
+      return nullptr;
+    default:
+      return nullptr;
+  }
+}
+
+std::string craft_alias_metadata(CGContext& context, std::pair<std::string, Type*>* restrict_param) {
+  auto it = context.metadata_store.restrict_scopes.find(restrict_param);
+  if (restrict_param == nullptr || it == context.metadata_store.restrict_scopes.end())
+    return "";
+  return ", !alias.scope !" + std::to_string(it->second.first) + ", !noalias !" + std::to_string(it->second.second);
+}
+
+void register_restrict_scopes(CGContext& context, Declaration* func) {
+  std::vector<std::pair<std::string, Type*>*> restrict_params;
+  for (std::pair<std::string, Type*>& param : func->parameters) {
+    if (type_is_restrict_pointer(context, func, param.second))
+      restrict_params.push_back(&param);
+  }
+  // a lone scope is disjoint from nothing, noalias on the parameter says it all
+  if (restrict_params.size() < 2)
+    return;
+
+  std::string label = craft_decl_label(func);
+  std::uintmax_t domain = context.metadata_store.add_distinct_node(", !\"" + label + "\"");
+  std::vector<std::uintmax_t> scopes;
+  for (std::pair<std::string, Type*>* param : restrict_params) {
+    scopes.push_back(context.metadata_store.add_distinct_node(", !" + std::to_string(domain) + ", !\"" + label + ": " + param->first + "\""));
+  }
+  for (std::uintmax_t index = 0; index < restrict_params.size(); ++index) {
+    std::string others;
+    for (std::uintmax_t other = 0; other < scopes.size(); ++other) {
+      if (other == index)
+        continue;
+      if (!others.empty())
+        others += ", ";
+      others += "!" + std::to_string(scopes[other]);
+    }
+    std::uintmax_t scope_list = context.metadata_store.add_node("!{!" + std::to_string(scopes[index]) + "}");
+    std::uintmax_t noalias_list = context.metadata_store.add_node("!{" + others + "}");
+    context.metadata_store.restrict_scopes[restrict_params[index]] = {scope_list, noalias_list};
+  }
+}
+
+std::ostream& emit_builtin_call(std::ostream& out, CGContext& context, Declaration* func, Markers& markers, Expression* expression, builtin_t builtin, std::string& output_marker) {
+  std::vector<std::string> argument_markers = {};
+  for (Expression* argument : expression->arguments) {
+    std::string argument_marker;
+    emit_expression_as_rvalue(out, context, func, markers, argument, argument_marker);
+    argument_markers.push_back(argument_marker);
+  }
+
+  // integer operands are casted to the type of the first one
+  Type* type = context.type_cache.expression_types[expression->arguments.front()];
+  std::string type_specifier = craft_type_specifier(context, func, type);
+
+  Type* size_type = Type::New(type_t::INTEGER_TYPE);
+  size_type->size = API::CPU_BIT_SIZE;
+  size_type->is_signed = false;
+  std::string size_type_specifier = craft_type_specifier(context, func, size_type);
+
+  Type* byte_type = Type::New(type_t::INTEGER_TYPE);
+  byte_type->size = 8;
+  byte_type->is_signed = false;
+
+  for (std::uintmax_t arg_index = 1; arg_index < expression->arguments.size(); ++arg_index) {
+    Type* arg_type = context.type_cache.expression_types[expression->arguments[arg_index]];
+    Type* requested_type = nullptr;
+    switch (builtin) {
+      case EXPECT_BUILTIN:
+      case ROTL_BUILTIN:
+      case ROTR_BUILTIN:
+      case FSHL_BUILTIN:
+      case FSHR_BUILTIN:
+        requested_type = type;
+        break;
+      case MEMCPY_BUILTIN:
+        requested_type = (arg_index == 2) ? size_type : nullptr;
+        break;
+      case MEMSET_BUILTIN:
+        requested_type = (arg_index == 2) ? size_type : byte_type;
+        break;
+      case PREFETCH_BUILTIN:
+      case ASSUME_BUILTIN:
+      case POPCOUNT_BUILTIN:
+      case CLZ_BUILTIN:
+      case CTZ_BUILTIN:
+        break;
+    }
+    if (requested_type != nullptr) {
+      std::string casted_marker;
+      cast_value_to_requested_type(out, context, func, markers, argument_markers[arg_index], arg_type, requested_type, casted_marker);
+      argument_markers[arg_index] = casted_marker;
+    }
+  }
+
+  std::string intrinsic;
+  switch (builtin) {
+    case EXPECT_BUILTIN:
+      {
+        intrinsic = context.intrinsic_store.get_intrinsic(type_specifier, "llvm.expect." + type_specifier, type_specifier + ", " + type_specifier);
+        output_marker = markers.new_marker();
+        out << output_marker << " = call " << type_specifier << " " << intrinsic << "(";
+        out << type_specifier << " " << argument_markers[0] << ", " << type_specifier << " " << argument_markers[1] << ")" << '\n';
+        break;
+      }
+    case PREFETCH_BUILTIN:
+      {
+        // arguments are: address, rw, locality, cache type (1 is data)
+        intrinsic = context.intrinsic_store.get_intrinsic("void", "llvm.prefetch.p0", "ptr, i32, i32, i32");
+        output_marker = "if_you_read_this_you_are_operating_on_a_void_returning_function";
+        out << "call void " << intrinsic << "(ptr " << argument_markers[0] << ", i32 " << argument_markers[1] << ", i32 " << argument_markers[2] << ", i32 1)" << '\n';
+        break;
+      }
+    case ASSUME_BUILTIN:
+      {
+        intrinsic = context.intrinsic_store.get_intrinsic("void", "llvm.assume", "i1");
+        output_marker = "if_you_read_this_you_are_operating_on_a_void_returning_function";
+        out << "call void " << intrinsic << "(i1 " << argument_markers[0] << ")" << '\n';
+        break;
+      }
+    case POPCOUNT_BUILTIN:
+      {
+        intrinsic = context.intrinsic_store.get_intrinsic(type_specifier, "llvm.ctpop." + type_specifier, type_specifier);
+        output_marker = markers.new_marker();
+        out << output_marker << " = call " << type_specifier << " " << intrinsic << "(" << type_specifier << " " << argument_markers[0] << ")" << '\n';
+        break;
+      }
+    case CLZ_BUILTIN:
+    case CTZ_BUILTIN:
+      {
+        // zero is not poison, the result is the bit width
+        std::string name = (builtin == CLZ_BUILTIN) ? "llvm.ctlz." : "llvm.cttz.";
+        intrinsic = context.intrinsic_store.get_intrinsic(type_specifier, name + type_specifier, type_specifier + ", i1");
+        output_marker = markers.new_marker();
+        out << output_marker << " = call " << type_specifier << " " << intrinsic << "(" << type_specifier << " " << argument_markers[0] << ", i1 false)" << '\n';
+        break;
+      }
+    case ROTL_BUILTIN:
+    case ROTR_BUILTIN:
+    case FSHL_BUILTIN:
+    case FSHR_BUILTIN:
+      {
+        // a rotation is a funnel shift of a value with itself
+        std::string name = (builtin == ROTL_BUILTIN || builtin == FSHL_BUILTIN) ? "llvm.fshl." : "llvm.fshr.";
+        std::string high = argument_markers[0];
+        std::string low = argument_markers[0];
+        std::string amount = argument_markers[1];
+        if (builtin == FSHL_BUILTIN || builtin == FSHR_BUILTIN) {
+          low = argument_markers[1];
+          amount = argument_markers[2];
+        }
+        intrinsic = context.intrinsic_store.get_intrinsic(type_specifier, name + type_specifier, type_specifier + ", " + type_specifier + ", " + type_specifier);
+        output_marker = markers.new_marker();
+        out << output_marker << " = call " << type_specifier << " " << intrinsic << "(";
+        out << type_specifier << " " << high << ", " << type_specifier << " " << low << ", " << type_specifier << " " << amount << ")" << '\n';
+        break;
+      }
+    case MEMCPY_BUILTIN:
+      {
+        intrinsic = context.intrinsic_store.get_intrinsic("void", "llvm.memcpy.p0.p0." + size_type_specifier, "ptr, ptr, " + size_type_specifier + ", i1");
+        output_marker = "if_you_read_this_you_are_operating_on_a_void_returning_function";
+        out << "call void " << intrinsic << "(ptr " << argument_markers[0] << ", ptr " << argument_markers[1] << ", " << size_type_specifier << " " << argument_markers[2] << ", i1 false)" << '\n';
+        break;
+      }
+    case MEMSET_BUILTIN:
+      {
+        intrinsic = context.intrinsic_store.get_intrinsic("void", "llvm.memset.p0." + size_type_specifier, "ptr, i8, " + size_type_specifier + ", i1");
+        output_marker = "if_you_read_this_you_are_operating_on_a_void_returning_function";
+        out << "call void " << intrinsic << "(ptr " << argument_markers[0] << ", i8 " << argument_markers[1] << ", " << size_type_specifier << " " << argument_markers[2] << ", i1 false)" << '\n';
+        break;
+      }
+  }
+
+  Type::Delete(size_type);
+  Type::Delete(byte_type);
+  return out;
+}
+
+// calls with an sret result, or spilled aggregate results, give an address when as_lvalue is set
+std::ostream& emit_call_expression(std::ostream& out, CGContext& context, Declaration* func, Markers& markers, Expression* expression, std::string& output_marker, bool as_lvalue) {
+  if (const builtin_t* builtin = context.symbol_cache.get_builtin(expression->callable)) {
+    return emit_builtin_call(out, context, func, markers, expression, *builtin, output_marker);
+  }
+
+  std::string callable_marker;
+  emit_expression_as_lvalue(out, context, func, markers, expression->callable, callable_marker);
+  Type* callable_type = extract_callable_type(context, func, context.type_cache.expression_types[expression->callable]);
+
+  if (!callable_marker.starts_with("@")) {
+    // it's an lvalue from stack
+    // I need to dereference it
+    // TODO: ALIGN
+    std::string new_callable_marker = markers.new_marker();
+    emit_type_specifier(out << new_callable_marker << " = load ", context, func, callable_type) << ", ptr " << callable_marker << ", align 8" << '\n';
+    callable_marker = new_callable_marker;
+  }
+
+  std::vector<std::string> argument_markers = {};
+  for (std::uintmax_t arg_index = 0; arg_index < expression->arguments.size(); ++arg_index) {
+    std::string argument_marker;
+    Type* arg_type = context.type_cache.expression_types[expression->arguments[arg_index]];
+    std::pair<abi_pass_t, std::string> abi = classify_abi(context, func, arg_type);
+    if (abi.first == ABI_MEMORY) {
+      if (!emit_aggregate_source(out, context, func, markers, expression->arguments[arg_index], argument_marker)) {
+        std::string slot = markers.new_entry_slot(craft_type_specifier(context, func, arg_type), std::max<std::uintmax_t>(8, compute_abi_layout(context, func, arg_type).second));
+        emit_aggregate_copy(out, context, func, slot, argument_marker, false, arg_type, "");
+        argument_marker = slot;
+      }
+    } else if (abi.first == ABI_COERCED) {
+      // the struct is copied in a slot of its coerced type, then loaded as such
+      std::string source;
+      bool source_is_address = emit_aggregate_source(out, context, func, markers, expression->arguments[arg_index], source);
+      std::string slot = markers.new_entry_slot(abi.second, 8);
+      emit_aggregate_copy(out, context, func, slot, source, source_is_address, arg_type, "");
+      argument_marker = markers.new_marker();
+      out << argument_marker << " = load " << abi.second << ", ptr " << slot << ", align 8" << '\n';
+    } else {
+      emit_expression_as_rvalue(out, context, func, markers, expression->arguments[arg_index], argument_marker);
+      if (arg_index < callable_type->parameters.size()) {
+        Type* param_type = callable_type->parameters[arg_index].second;
+        std::string casted_marker;
+        cast_value_to_requested_type(out, context, func, markers, argument_marker, arg_type, param_type, casted_marker);
+        argument_marker = casted_marker;
+      }
+    }
+    argument_markers.push_back(argument_marker);
+  }
+
+  Type* callable_subtype = extract_subtype(context, func, callable_type);
+  std::pair<abi_pass_t, std::string> return_abi = classify_abi(context, func, callable_subtype);
+  std::string result_slot;
+  if (return_abi.first == ABI_MEMORY) {
+    // byval and sret pointers are passed as aligned to 8
+    result_slot = markers.new_entry_slot(craft_type_specifier(context, func, callable_subtype), std::max<std::uintmax_t>(8, compute_abi_layout(context, func, callable_subtype).second));
+  }
+
+  if (callable_subtype->kind == VOID_TYPE || return_abi.first == ABI_MEMORY) {
+    output_marker = "if_you_read_this_you_are_operating_on_a_void_returning_function";
+    out << "call ";
+  } else {
+    output_marker = markers.new_marker();
+    out << output_marker << " = call ";
+    if (extract_element_type(context, func, callable_subtype).second->kind == DOUBLE_TYPE) {
+      std::string flags = craft_fast_math_flags(func);
+      if (!flags.empty())
+        out << flags.substr(1) << " ";
+    }
+  }
+  emit_type_specifier(out, context, func, callable_type, true, false);
+  out << " " << callable_marker << "(";
+  if (return_abi.first == ABI_MEMORY) {
+    emit_type_specifier(out << "ptr sret(", context, func, callable_subtype) << ") align 8 " << result_slot;
+    if (!expression->arguments.empty())
+      out << ", ";
+  }
+  for (std::uintmax_t arg_index = 0; arg_index < expression->arguments.size(); ++arg_index) {
+    if (arg_index > 0) {
+      out << ", ";
+    }
+    Type* arg_type = context.type_cache.expression_types[expression->arguments[arg_index]];
+    std::pair<abi_pass_t, std::string> abi = classify_abi(context, func, arg_type);
+    if (abi.first == ABI_MEMORY) {
+      emit_type_specifier(out << "ptr byval(", context, func, arg_type) << ") align 8 " << argument_markers[arg_index];
+    } else if (abi.first == ABI_COERCED) {
+      out << abi.second << " " << argument_markers[arg_index];
+    } else {
+      if (arg_index < callable_type->parameters.size()) {
+        Type* param_type = callable_type->parameters[arg_index].second;
+        emit_type_specifier(out, context, func, param_type) << " " << argument_markers[arg_index];
+      } else {
+        emit_type_specifier(out, context, func, arg_type) << " " << argument_markers[arg_index];
+      }
+    }
+  }
+  out << ")" << '\n';
+
+  if (return_abi.first == ABI_MEMORY) {
+    if (as_lvalue) {
+      output_marker = result_slot;
+    } else {
+      output_marker = markers.new_marker();
+      emit_type_specifier(out << output_marker << " = load ", context, func, callable_subtype) << ", ptr " << result_slot << ", align 8" << '\n';
+    }
+  } else if (return_abi.first == ABI_COERCED) {
+    std::string type_specifier = craft_type_specifier(context, func, callable_subtype);
+    if (as_lvalue) {
+      result_slot = markers.new_entry_slot(return_abi.second, 8);
+      out << "store " << return_abi.second << " " << output_marker << ", ptr " << result_slot << ", align 8" << '\n';
+      output_marker = result_slot;
+    } else {
+      output_marker = emit_coercion(out, markers, output_marker, return_abi.second, type_specifier, return_abi.second);
+    }
+  } else if (as_lvalue && type_is_aggregate(context, func, callable_subtype)) {
+    // aggregates are accessed through their address
+    result_slot = markers.new_entry_slot(craft_type_specifier(context, func, callable_subtype), compute_abi_layout(context, func, callable_subtype).second);
+    emit_type_specifier(out << "store ", context, func, callable_subtype) << " " << output_marker << ", ptr " << result_slot << ", align " << compute_abi_layout(context, func, callable_subtype).second << '\n';
+    output_marker = result_slot;
+  }
+  return out;
+}
+
 std::ostream& emit_expression_as_lvalue(std::ostream& out, CGContext& context, Declaration* func, Markers& markers, Expression* expression, std::string& output_marker) {
   switch (expression->kind) {
     case SYMBOL_EXPR:
@@ -551,7 +1422,7 @@ std::ostream& emit_expression_as_lvalue(std::ostream& out, CGContext& context, D
 
           emit_type_specifier(out << output_marker << " = getelementptr ", context, func, left_type) << ", ptr " << left_value;
           std::uintmax_t field_index = compute_field_index(context, func, left_type, expression->right);
-          out << ", i64 0, i32 " << field_index << std::endl;
+          out << ", i64 0, i32 " << field_index << '\n';
         } else if (expression->operator_ == DOT_OP) {
           std::string left_value;
           emit_expression_as_lvalue(out, context, func, markers, expression->left, left_value);
@@ -560,93 +1431,371 @@ std::ostream& emit_expression_as_lvalue(std::ostream& out, CGContext& context, D
 
           emit_type_specifier(out << output_marker << " = getelementptr ", context, func, left_type) << ", ptr " << left_value;
           std::uintmax_t field_index = compute_field_index(context, func, left_type, expression->right);
-          out << ", i64 0, i32 " << field_index << std::endl;
+          out << ", i64 0, i32 " << field_index << '\n';
+        } else {
+          assert(false);
+        }
+        break;
+      }
+    case ARRAY_ACCESS_EXPR:
+      {
+        Type* left_type = context.type_cache.expression_types[expression->left];
+        Type* right_type = context.type_cache.expression_types[expression->right];
+        Type* element_type = left_type;
+
+        std::string left_value;
+        if (type_is_array(context, func, left_type) || type_is_vector(context, func, left_type)) {
+          emit_expression_as_lvalue(out, context, func, markers, expression->left, left_value);
+        } else {
+          assert (type_is_pointer(context, func, left_type));
+          emit_expression_as_rvalue(out, context, func, markers, expression->left, left_value);
+          element_type = extract_subtype(context, func, left_type);
+        }
+
+        std::string right_value;
+        emit_expression_as_rvalue(out, context, func, markers, expression->right, right_value);
+
+        output_marker = markers.new_marker();
+        if (type_is_array(context, func, left_type) || type_is_vector(context, func, left_type) || (type_is_pointer(context, func, left_type) && type_is_array(context, func, extract_subtype(context, func, left_type)))) {
+          emit_type_specifier(out << output_marker << " = getelementptr ", context, func, element_type) << ", ptr " << left_value;
+          emit_type_specifier(out << ", i64 0, ", context, func, right_type) << " " << right_value << '\n';
+        } else {
+          assert (type_is_pointer(context, func, left_type));
+          emit_type_specifier(out << output_marker << " = getelementptr ", context, func, element_type) << ", ptr " << left_value;
+          emit_type_specifier(out << ", ", context, func, right_type) << " " << right_value << '\n';
+        }
+        break;
+      }
+    case MONARY_EXPR:
+      {
+        switch (expression->operator_) {
+          case MUL_OP: //*
+            {
+              emit_expression_as_rvalue(out, context, func, markers, expression->value, output_marker);
+              break;
+            }
+          default:
+            assert(false);
+        }
+        break;
+      }
+    case CALL_EXPR:
+      {
+        emit_call_expression(out, context, func, markers, expression, output_marker, true);
+        break;
+      }
+    case BITCAST_EXPR:
+    case CAST_EXPR:
+      {
+        std::string value_marker;
+        emit_expression_as_lvalue(out, context, func, markers, expression->value, value_marker);
+        Type* value_type = context.type_cache.expression_types[expression->value];
+        Type* requested_type = context.type_cache.expression_types[expression];
+        cast_value_to_requested_type(out, context, func, markers, value_marker, value_type, requested_type, output_marker);
+        break;
+      }
+    case VANEXT_EXPR:
+      {
+        emit_expression_as_rvalue(out, context, func, markers, expression, output_marker);
+        break;
+      }
+    case AGGREGATE_LITERAL_EXPR:
+      {
+        // literals are materialized on the stack to be accessed through their address
+        std::string literal_value;
+        emit_expression_as_rvalue(out, context, func, markers, expression, literal_value);
+        std::uintmax_t alignment = compute_abi_layout(context, func, expression->type).second;
+        output_marker = markers.new_entry_slot(craft_type_specifier(context, func, expression->type), alignment);
+        emit_type_specifier(out << "store ", context, func, expression->type) << " " << literal_value << ", ptr " << output_marker << ", align " << alignment << '\n';
+        break;
+      }
+    case INTEGER_EXPR:
+    case DOUBLE_EXPR:
+    case BOOLEAN_EXPR:
+    case NULLPTR_EXPR:
+    case CHARACTER_EXPR:
+    case STRING_EXPR:
+    case SIZEOF_EXPR:
+    case VECTOR_LOAD_EXPR:
+    case VECTOR_STORE_EXPR:
+    case VECTOR_SHUFFLE_EXPR:
+      assert(false);
+      break;
+  }
+  if (output_marker.empty()) {
+    std::cerr << RED_TEXT << expression->kind << std::endl;
+    Expression::Print(std::cerr << AZURE_TEXT, expression) << NORMAL_TEXT << std::endl;
+    assert(output_marker != "");
+  }
+  return out;
+}
+
+// truth of a condition folded by the constant checker, false when it is only known at runtime
+bool find_folded_condition(CGContext& context, Expression* condition, bool& truth) {
+  auto it = context.constant_cache.folded.find(condition);
+  if (it == context.constant_cache.folded.end()) {
+    return false;
+  }
+  Expression* folded = it->second;
+  truth = folded->kind == BOOLEAN_EXPR ? folded->boolean_literal : folded->kind == DOUBLE_EXPR ? folded->decimal_literal != 0 : folded->integer_literal != 0;
+  return true;
+}
+
+// width of the floating type a literal is spelled as, double when it is not typed
+std::uintmax_t compute_float_literal_size(CGContext& context, Declaration* func, Expression* expression) {
+  auto it = context.type_cache.expression_types.find(expression);
+  if (it == context.type_cache.expression_types.end()) {
+    return 64;
+  }
+  std::pair<Declaration*, Type*> element = extract_element_type(context, func, it->second);
+  return element.second->kind == DOUBLE_TYPE ? element.second->size : 64;
+}
+
+// algebraic and logical operations, once both operands are values
+std::ostream& emit_binary_operation(std::ostream& out, CGContext& context, Declaration* func, Markers& markers, Expression* expression, std::string left_value, std::string right_value, std::string& output_marker) {
+  output_marker = markers.new_marker();
+
+  Type* master_operand_type;
+  if (type_is_pointer(context, func, context.type_cache.expression_types[expression])) {
+    master_operand_type = Type::Clone(context.type_cache.expression_types[expression]);
+  } else {
+    if (is_algebraic_operator(expression->operator_)) {
+      master_operand_type = cast_operands_to_expression_type(out, context, markers, func, context.type_cache.expression_types[expression->left], left_value, context.type_cache.expression_types[expression->right], right_value, Type::Clone(context.type_cache.expression_types[expression]));
+    } else if (is_logical_operator(expression->operator_)) {
+      master_operand_type = cast_operands_to_biggest_type(out, context, markers, func, context.type_cache.expression_types[expression->left], left_value, context.type_cache.expression_types[expression->right], right_value);
+    } else {
+      assert(false);
+    }
+  }
+
+  switch (expression->operator_) {
+    case MUL_OP:
+      {
+        if (type_is_pointer(context, func, context.type_cache.expression_types[expression])) {
+          assert(false);
+        } else {
+          emit_overflowing_binary_operation(out, context, func, markers, output_marker, left_value, right_value, context.type_cache.expression_types[expression], "mul", "fmul");
+        }
+      }
+      break;
+    case DIV_OP:
+      {
+        if (type_is_pointer(context, func, context.type_cache.expression_types[expression])) {
+          assert(false);
+        } else {
+          emit_simple_binary_operation(out, context, func, output_marker, left_value, right_value, context.type_cache.expression_types[expression], "udiv", "fdiv");
+        }
+        break;
+      }
+    case MOD_OP:
+      {
+        if (type_is_pointer(context, func, context.type_cache.expression_types[expression])) {
+          assert(false);
+        } else {
+          emit_simple_binary_operation(out, context, func, output_marker, left_value, right_value, context.type_cache.expression_types[expression], "urem", "frem");
+        }
+        break;
+      }
+    case ADD_OP:
+      {
+        if (type_is_pointer(context, func, context.type_cache.expression_types[expression])) {
+          Type* subtype = extract_subtype(context, func, context.type_cache.expression_types[expression]);
+          if (subtype->kind == type_t::ARRAY_TYPE) {
+            subtype = subtype->subtype;
+          }
+          if (type_is_pointer(context, func, context.type_cache.expression_types[expression->right])) {
+            emit_type_specifier(out << output_marker << " = getelementptr ", context, func, subtype) << ", ";
+            emit_type_specifier(out, context, func, context.type_cache.expression_types[expression->right]);
+            out << " " << right_value << ", ";
+            emit_type_specifier(out, context, func, context.type_cache.expression_types[expression->left]);
+            out << " " << left_value << '\n';
+          } else {
+            emit_type_specifier(out << output_marker << " = getelementptr ", context, func, subtype) << ", ";
+            emit_type_specifier(out, context, func, context.type_cache.expression_types[expression->left]);
+            out << " " << left_value << ", ";
+            emit_type_specifier(out, context, func, context.type_cache.expression_types[expression->right]);
+            out << " " << right_value << '\n';
+          }
+        } else {
+          emit_overflowing_binary_operation(out, context, func, markers, output_marker, left_value, right_value, context.type_cache.expression_types[expression], "add", "fadd");
+        }
+        break;
+      }
+    case SUB_OP:
+      {
+        if (type_is_pointer(context, func, context.type_cache.expression_types[expression])) {
+          Type* subtype = extract_subtype(context, func, context.type_cache.expression_types[expression]);
+          if (type_is_pointer(context, func, context.type_cache.expression_types[expression->right])) {
+            std::string inverted_offset = markers.new_marker();
+            out << inverted_offset << " = mul ";
+            emit_type_specifier(out, context, func, context.type_cache.expression_types[expression->left]);
+            out << " " << left_value << ", -1" << '\n';
+
+            emit_type_specifier(out << output_marker << " = getelementptr ", context, func, subtype) << ", ";
+            emit_type_specifier(out, context, func, context.type_cache.expression_types[expression->right]);
+            out << " " << right_value << ", ";
+            emit_type_specifier(out, context, func, context.type_cache.expression_types[expression->left]);
+            out << " " << inverted_offset << '\n';
+          } else {
+            std::string inverted_offset = markers.new_marker();
+            out << inverted_offset << " = mul ";
+            emit_type_specifier(out, context, func, context.type_cache.expression_types[expression->right]);
+            out << " " << right_value << ", -1" << '\n';
+
+            emit_type_specifier(out << output_marker << " = getelementptr ", context, func, subtype) << ", ";
+            emit_type_specifier(out, context, func, context.type_cache.expression_types[expression->left]);
+            out << " " << left_value << ", ";
+            emit_type_specifier(out, context, func, context.type_cache.expression_types[expression->right]);
+            out << " " << inverted_offset << '\n';
+          }
+        } else {
+          emit_overflowing_binary_operation(out, context, func, markers, output_marker, left_value, right_value, context.type_cache.expression_types[expression], "sub", "fsub");
+        }
+        break;
+      }
+    case XOR_OP:
+      {
+        if (type_is_pointer(context, func, context.type_cache.expression_types[expression])) {
+          assert(false);
+        } else {
+          emit_integer_only_binary_operation(out, context, func, output_marker, left_value, right_value, master_operand_type, "xor");
+        }
+        break;
+      }
+    case AND_OP:
+      {
+        if (type_is_pointer(context, func, master_operand_type)) {
+          assert(false);
+        } else {
+          emit_integer_only_binary_operation(out, context, func, output_marker, left_value, right_value, master_operand_type, "and");
+        }
+        break;
+      }
+    case OR_OP:
+      {
+        if (type_is_pointer(context, func, master_operand_type)) {
+          assert(false);
+        } else {
+          emit_integer_only_binary_operation(out, context, func, output_marker, left_value, right_value, master_operand_type, "or");
+        }
+        break;
+      }
+    case LROT_OP:
+      {
+        if (type_is_pointer(context, func, master_operand_type)) {
+          assert(false);
         } else {
+          emit_integer_only_binary_operation(out, context, func, output_marker, left_value, right_value, master_operand_type, "shl");
+        }
+        break;
+      }
+    case RROT_OP:
+      {
+        if (type_is_pointer(context, func, master_operand_type)) {
           assert(false);
+        } else {
+          emit_integer_only_binary_operation(out, context, func, output_marker, left_value, right_value, master_operand_type, "lshr");
         }
         break;
       }
-    case ARRAY_ACCESS_EXPR:
+    case SCA_OP:
       {
-        Type* left_type = context.type_cache.expression_types[expression->left];
-        Type* right_type = context.type_cache.expression_types[expression->right];
-        Type* element_type = left_type;
-
-        std::string left_value;
-        if (type_is_array(context, func, left_type)) {
-          emit_expression_as_lvalue(out, context, func, markers, expression->left, left_value);
+        if (type_is_pointer(context, func, master_operand_type)) {
+          assert(false);
         } else {
-          assert (type_is_pointer(context, func, left_type));
-          emit_expression_as_rvalue(out, context, func, markers, expression->left, left_value);
-          element_type = extract_subtype(context, func, left_type);
+          emit_integer_only_binary_operation(out, context, func, output_marker, left_value, right_value, master_operand_type, "and");
         }
-
-        std::string right_value;
-        emit_expression_as_rvalue(out, context, func, markers, expression->right, right_value);
-
-        output_marker = markers.new_marker();
-        if (type_is_array(context, func, left_type) || (type_is_pointer(context, func, left_type) && type_is_array(context, func, extract_subtype(context, func, left_type)))) {
-          emit_type_specifier(out << output_marker << " = getelementptr ", context, func, element_type) << ", ptr " << left_value;
-          emit_type_specifier(out << ", i64 0, ", context, func, right_type) << " " << right_value << std::endl;
+        break;
+      }
+    case SCO_OP:
+      {
+        if (type_is_pointer(context, func, master_operand_type)) {
+          assert(false);
         } else {
-          assert (type_is_pointer(context, func, left_type));
-          emit_type_specifier(out << output_marker << " = getelementptr ", context, func, element_type) << ", ptr " << left_value;
-          emit_type_specifier(out << ", ", context, func, right_type) << " " << right_value << std::endl;
+          emit_integer_only_binary_operation(out, context, func, output_marker, left_value, right_value, master_operand_type, "or");
         }
         break;
       }
-    case MONARY_EXPR:
+    case GE_OP:
       {
-        switch (expression->operator_) {
-          case MUL_OP: //*
-            {
-              emit_expression_as_rvalue(out, context, func, markers, expression->value, output_marker);
-              break;
-            }
-          default:
-            assert(false);
+        if (type_is_pointer(context, func, master_operand_type)) {
+          assert(false);
+        } else {
+          emit_simple_binary_operation(out, context, func, output_marker, left_value, right_value, master_operand_type, "icmp sge", "fcmp oge");
         }
         break;
       }
-    case CALL_EXPR:
+    case LE_OP:
       {
-        emit_expression_as_rvalue(out, context, func, markers, expression, output_marker);
+        emit_simple_binary_operation(out, context, func, output_marker, left_value, right_value, master_operand_type, "icmp sle", "fcmp ole");
         break;
       }
-    case BITCAST_EXPR:
-    case CAST_EXPR:
+    case EQ_OP:
       {
-        std::string value_marker;
-        emit_expression_as_lvalue(out, context, func, markers, expression->value, value_marker);
-        Type* value_type = context.type_cache.expression_types[expression->value];
-        Type* requested_type = context.type_cache.expression_types[expression];
-        cast_value_to_requested_type(out, context, func, markers, value_marker, value_type, requested_type, output_marker);
+        emit_simple_binary_operation(out, context, func, output_marker, left_value, right_value, master_operand_type, "icmp eq", "fcmp oeq");
         break;
       }
-    case VANEXT_EXPR:
+    case NE_OP:
       {
-        emit_expression_as_rvalue(out, context, func, markers, expression, output_marker);
+        emit_simple_binary_operation(out, context, func, output_marker, left_value, right_value, master_operand_type, "icmp ne", "fcmp one");
         break;
       }
-    case INTEGER_EXPR:
-    case DOUBLE_EXPR:
-    case BOOLEAN_EXPR:
-    case NULLPTR_EXPR:
-    case CHARACTER_EXPR:
-    case STRING_EXPR:
-    case SIZEOF_EXPR:
+    case GR_OP:
+      {
+        emit_simple_binary_operation(out, context, func, output_marker, left_value, right_value, master_operand_type, "icmp sgt", "fcmp ogt");
+        break;
+      }
+    case LR_OP:
+      {
+        emit_simple_binary_operation(out, context, func, output_marker, left_value, right_value, master_operand_type, "icmp slt", "fcmp olt");
+        break;
+      }
+    default:
       assert(false);
-      break;
-  }
-  if (output_marker.empty()) {
-    std::cerr << RED_TEXT << expression->kind << std::endl;
-    Expression::Print(std::cerr << AZURE_TEXT, expression) << NORMAL_TEXT << std::endl;
-    assert(output_marker != "");
   }
+  Type::Delete(master_operand_type);
   return out;
 }
 
+// binary operations nested on their left, as in long sums, are emitted in a loop instead of recursing on each of them
+bool is_left_nested_operation(CGContext& context, Expression* expression) {
+  return expression->kind == BINARY_EXPR && expression->operator_ != ARR_OP && expression->operator_ != DOT_OP && expression->operator_ != ASS_OP
+      && !context.constant_cache.folded.contains(expression);
+}
+
+std::ostream& emit_single_expression_as_rvalue(std::ostream& out, CGContext& context, Declaration* func, Markers& markers, Expression* expression, std::string& output_marker);
+
+// same order as the recursive form: the right operands on the way down, the operations on the way up
 std::ostream& emit_expression_as_rvalue(std::ostream& out, CGContext& context, Declaration* func, Markers& markers, Expression* expression, std::string& output_marker) {
+  if (!is_left_nested_operation(context, expression) || !is_left_nested_operation(context, expression->left)) {
+    return emit_single_expression_as_rvalue(out, context, func, markers, expression, output_marker);
+  }
+  std::vector<std::pair<Expression*, std::string>> chain;
+  Expression* innermost = expression;
+  while (is_left_nested_operation(context, innermost)) {
+    std::string right_value;
+    emit_expression_as_rvalue(out, context, func, markers, innermost->right, right_value);
+    chain.push_back({innermost, right_value});
+    innermost = innermost->left;
+  }
+  std::string left_value;
+  emit_single_expression_as_rvalue(out, context, func, markers, innermost, left_value);
+  for (auto it = chain.rbegin(); it != chain.rend(); ++it) {
+    emit_binary_operation(out, context, func, markers, it->first, left_value, it->second, output_marker);
+    left_value = output_marker;
+  }
+  return out;
+}
+
+std::ostream& emit_single_expression_as_rvalue(std::ostream& out, CGContext& context, Declaration* func, Markers& markers, Expression* expression, std::string& output_marker) {
+  auto folded = context.constant_cache.folded.find(expression);
+  if (folded != context.constant_cache.folded.end()) {
+    if (folded->second->kind == DOUBLE_EXPR) {
+      output_marker = context.literal_store.get_float_literal(folded->second->decimal_literal, compute_float_literal_size(context, func, expression));
+      return out;
+    }
+    return emit_expression_as_rvalue(out, context, func, markers, folded->second, output_marker);
+  }
   switch (expression->kind) {
     case SYMBOL_EXPR:
       {
@@ -659,7 +1808,7 @@ std::ostream& emit_expression_as_rvalue(std::ostream& out, CGContext& context, D
             emit_type_specifier(out, context, func, decl->type);
             std::string marker = "@" + craft_decl_label(decl);
             assert(!marker.empty());
-            out << ", ptr " << marker << ", align 8" << std::endl;
+            out << ", ptr " << marker << ", align 8" << craft_tbaa_metadata(context, func, nullptr, decl->type) << '\n';
           } else {
             assert (false);
           }
@@ -669,14 +1818,14 @@ std::ostream& emit_expression_as_rvalue(std::ostream& out, CGContext& context, D
           emit_type_specifier(out, context, func, var->type);
           std::string marker = markers.get_var(var);
           assert(!marker.empty());
-          out << ", ptr " << marker << ", align 8" << std::endl;
+          out << ", ptr " << marker << ", align 8" << craft_tbaa_metadata(context, func, nullptr, var->type) << '\n';
         } else if (std::pair<std::string, Type*>* param = context.symbol_cache.get_parameter(expression)) {
           output_marker = markers.new_marker();
           out << output_marker << " = load ";
           emit_type_specifier(out, context, func, param->second);
           std::string marker = markers.get_param(param);
           assert(!marker.empty());
-          out << ", ptr " << marker << ", align 8" << std::endl;
+          out << ", ptr " << marker << ", align 8" << craft_tbaa_metadata(context, func, nullptr, param->second) << '\n';
         } else {
           assert(false);
         }
@@ -689,7 +1838,7 @@ std::ostream& emit_expression_as_rvalue(std::ostream& out, CGContext& context, D
       }
     case DOUBLE_EXPR:
       {
-        output_marker = context.literal_store.get_float_literal(expression->decimal_literal);
+        output_marker = context.literal_store.get_float_literal(expression->decimal_literal, compute_float_literal_size(context, func, expression));
         break;
       }
     case BOOLEAN_EXPR:
@@ -709,69 +1858,12 @@ std::ostream& emit_expression_as_rvalue(std::ostream& out, CGContext& context, D
       }
     case STRING_EXPR:
       {
-        output_marker = context.literal_store.get_string_literal(expression->string_literal);
+        output_marker = context.literal_store.get_string_literal(*expression->string_literal);
         break;
       }
     case CALL_EXPR:
       {
-        std::string callable_marker;
-        emit_expression_as_lvalue(out, context, func, markers, expression->callable, callable_marker);
-        Type* callable_type = extract_callable_type(context, func, context.type_cache.expression_types[expression->callable]);
-
-        if (!callable_marker.starts_with("@")) {
-          // it's an lvalue from stack
-          // I need to dereference it
-          // TODO: ALIGN
-          std::string new_callable_marker = markers.new_marker();
-          emit_type_specifier(out << new_callable_marker << " = load ", context, func, callable_type) << ", ptr " << callable_marker << ", align 8" << std::endl;
-          callable_marker = new_callable_marker;
-        }
-
-        std::vector<std::string> argument_markers = {};
-        for (std::uintmax_t arg_index = 0; arg_index < expression->arguments.size(); ++arg_index) {
-          std::string argument_marker;
-          Type* arg_type = context.type_cache.expression_types[expression->arguments[arg_index]];
-          if (type_is_struct(context, func, arg_type) && context.size_cache.compute_size_of(context.symbol_cache, func, arg_type) > API::STRUCT_PASSED_AS_INLINE_SIZE_LIMIT) {
-            emit_expression_as_lvalue(out, context, func, markers, expression->arguments[arg_index], argument_marker);
-          } else {
-            emit_expression_as_rvalue(out, context, func, markers, expression->arguments[arg_index], argument_marker);
-            if (arg_index < callable_type->parameters.size()) {
-              Type* param_type = callable_type->parameters[arg_index].second;
-              std::string casted_marker;
-              cast_value_to_requested_type(out, context, func, markers, argument_marker, arg_type, param_type, casted_marker);
-              argument_marker = casted_marker;
-            }
-          }
-          argument_markers.push_back(argument_marker);
-        }
-
-        Type* callable_subtype = extract_subtype(context, func, callable_type);
-        if (callable_subtype->kind == VOID_TYPE) {
-          output_marker = "if_you_read_this_you_are_operating_on_a_void_returning_function";
-          out << "call ";
-        } else {
-          output_marker = markers.new_marker();
-          out << output_marker << " = call ";
-        }
-        emit_type_specifier(out, context, func, callable_type, true, false);
-        out << " " << callable_marker << "(";
-        for (std::uintmax_t arg_index = 0; arg_index < expression->arguments.size(); ++arg_index) {
-          if (arg_index > 0) {
-            out << ", ";
-          }
-          Type* arg_type = context.type_cache.expression_types[expression->arguments[arg_index]];
-          if (type_is_struct(context, func, arg_type) && context.size_cache.compute_size_of(context.symbol_cache, func, arg_type) > API::STRUCT_PASSED_AS_INLINE_SIZE_LIMIT) {
-            emit_type_specifier(out << "ptr byval(", context, func, arg_type) << ") align 8 " << argument_markers[arg_index];
-          } else {
-            if (arg_index < callable_type->parameters.size()) {
-              Type* param_type = callable_type->parameters[arg_index].second;
-              emit_type_specifier(out, context, func, param_type) << " " << argument_markers[arg_index];
-            } else {
-              emit_type_specifier(out, context, func, arg_type) << " " << argument_markers[arg_index];
-            }
-          }
-        }
-        out << ")" << std::endl;
+        emit_call_expression(out, context, func, markers, expression, output_marker, false);
         break;
       }
     case BINARY_EXPR:
@@ -781,13 +1873,55 @@ std::ostream& emit_expression_as_rvalue(std::ostream& out, CGContext& context, D
           emit_expression_as_lvalue(out, context, func, markers, expression, referenced);
           Type* type = context.type_cache.expression_types[expression];
           output_marker = markers.new_marker();
-          emit_type_specifier(out << output_marker << " = load ", context, func, type) << ", ptr " << referenced << ", align 8" << std::endl;
+          emit_type_specifier(out << output_marker << " = load ", context, func, type) << ", ptr " << referenced << ", align 8" << craft_alias_metadata(context, find_restrict_base_of_place(context, func, expression));
+          out << craft_tbaa_metadata(context, func, expression, type) << '\n';
         } else if (expression->operator_ == DOT_OP) {
           std::string referenced;
           emit_expression_as_lvalue(out, context, func, markers, expression, referenced);
           Type* type = context.type_cache.expression_types[expression];
           output_marker = markers.new_marker();
-          emit_type_specifier(out << output_marker << " = load ", context, func, type) << ", ptr " << referenced << ", align 8" << std::endl;
+          emit_type_specifier(out << output_marker << " = load ", context, func, type) << ", ptr " << referenced << ", align 8" << craft_alias_metadata(context, find_restrict_base_of_place(context, func, expression));
+          out << craft_tbaa_metadata(context, func, expression, type) << '\n';
+        } else if (expression->operator_ == ASS_OP
+                && expression->left->kind == ARRAY_ACCESS_EXPR
+                && type_is_vector(context, func, context.type_cache.expression_types[expression->left->left])) {
+          // lane insert
+          std::string right_value;
+          emit_expression_as_rvalue(out, context, func, markers, expression->right, right_value);
+          Type* right_type = context.type_cache.expression_types[expression->right];
+          Type* lane_type = context.type_cache.expression_types[expression->left];
+          cast_value_to_requested_type(out, context, func, markers, right_value, right_type, lane_type, output_marker);
+
+          std::string vector_pointer;
+          emit_expression_as_lvalue(out, context, func, markers, expression->left->left, vector_pointer);
+          Type* vector_type = context.type_cache.expression_types[expression->left->left];
+
+          std::string index_value;
+          emit_expression_as_rvalue(out, context, func, markers, expression->left->right, index_value);
+          Type* index_type = context.type_cache.expression_types[expression->left->right];
+
+          std::uintmax_t alignment = compute_vector_alignment(context, func, vector_type, 0);
+          std::string vector_value = markers.new_marker();
+          emit_type_specifier(out << vector_value << " = load ", context, func, vector_type) << ", ptr " << vector_pointer << ", align " << alignment << '\n';
+          std::string inserted_value = markers.new_marker();
+          emit_type_specifier(out << inserted_value << " = insertelement ", context, func, vector_type) << " " << vector_value << ", ";
+          emit_type_specifier(out, context, func, lane_type) << " " << output_marker << ", ";
+          emit_type_specifier(out, context, func, index_type) << " " << index_value << '\n';
+          emit_type_specifier(out << "store ", context, func, vector_type) << " " << inserted_value << ", ptr " << vector_pointer << ", align " << alignment << '\n';
+        } else if (expression->operator_ == ASS_OP && type_is_aggregate(context, func, context.type_cache.expression_types[expression->left])) {
+          std::string right_value;
+          bool right_is_address = emit_aggregate_source(out, context, func, markers, expression->right, right_value);
+
+          std::string left_value;
+          emit_expression_as_lvalue(out, context, func, markers, expression->left, left_value);
+          Type* left_type = context.type_cache.expression_types[expression->left];
+          output_marker = markers.new_marker();
+
+          std::string alias_metadata = craft_alias_metadata(context, find_restrict_base_of_place(context, func, expression->left));
+          alias_metadata += craft_tbaa_metadata(context, func, expression->left, left_type);
+          emit_aggregate_copy(out, context, func, left_value, right_value, right_is_address, left_type, alias_metadata);
+          std::uintmax_t alignment = compute_abi_layout(context, func, left_type).second;
+          emit_type_specifier(out << output_marker << " = load ", context, func, left_type) << ", ptr " << left_value << ", align " << alignment << alias_metadata << '\n';
         } else if (expression->operator_ == ASS_OP) {
           std::string right_value;
           emit_expression_as_rvalue(out, context, func, markers, expression->right, right_value);
@@ -803,214 +1937,16 @@ std::ostream& emit_expression_as_rvalue(std::ostream& out, CGContext& context, D
           right_value = right_marker;
 
           // TODO: ALIGN
-          emit_type_specifier(out << "store ", context, func, left_type) << " " << right_value << ", ptr " << left_value << ", align 8" << std::endl;
-          emit_type_specifier(out << output_marker << " = load ", context, func, left_type) << ", ptr " << left_value << ", align 8" << std::endl;
+          std::string alias_metadata = craft_alias_metadata(context, find_restrict_base_of_place(context, func, expression->left));
+          alias_metadata += craft_tbaa_metadata(context, func, expression->left, left_type);
+          emit_type_specifier(out << "store ", context, func, left_type) << " " << right_value << ", ptr " << left_value << ", align 8" << alias_metadata << '\n';
+          emit_type_specifier(out << output_marker << " = load ", context, func, left_type) << ", ptr " << left_value << ", align 8" << alias_metadata << '\n';
         } else {
           std::string right_value;
           emit_expression_as_rvalue(out, context, func, markers, expression->right, right_value);
           std::string left_value;
           emit_expression_as_rvalue(out, context, func, markers, expression->left, left_value);
-          output_marker = markers.new_marker();
-
-          Type* master_operand_type;
-          if (type_is_pointer(context, func, context.type_cache.expression_types[expression])) {
-            master_operand_type = Type::Clone(context.type_cache.expression_types[expression]);
-          } else {
-            if (is_algebraic_operator(expression->operator_)) {
-              master_operand_type = cast_operands_to_expression_type(out, context, markers, func, context.type_cache.expression_types[expression->left], left_value, context.type_cache.expression_types[expression->right], right_value, Type::Clone(context.type_cache.expression_types[expression]));
-            } else if (is_logical_operator(expression->operator_)) {
-              master_operand_type = cast_operands_to_biggest_type(out, context, markers, func, context.type_cache.expression_types[expression->left], left_value, context.type_cache.expression_types[expression->right], right_value);
-            } else {
-              assert(false);
-            }
-          }
-
-          switch (expression->operator_) {
-            case MUL_OP:
-              {
-                if (type_is_pointer(context, func, context.type_cache.expression_types[expression])) {
-                  assert(false);
-                } else {
-                  emit_simple_binary_operation(out, context, func, output_marker, left_value, right_value, context.type_cache.expression_types[expression], "mul", "fmul");
-                }
-              }
-              break;
-            case DIV_OP:
-              {
-                if (type_is_pointer(context, func, context.type_cache.expression_types[expression])) {
-                  assert(false);
-                } else {
-                  emit_simple_binary_operation(out, context, func, output_marker, left_value, right_value, context.type_cache.expression_types[expression], "udiv", "fdiv");
-                }
-                break;
-              }
-            case MOD_OP:
-              {
-                if (type_is_pointer(context, func, context.type_cache.expression_types[expression])) {
-                  assert(false);
-                } else {
-                  emit_simple_binary_operation(out, context, func, output_marker, left_value, right_value, context.type_cache.expression_types[expression], "urem", "frem");
-                }
-                break;
-              }
-            case ADD_OP:
-              {
-                if (type_is_pointer(context, func, context.type_cache.expression_types[expression])) {
-                  Type* subtype = extract_subtype(context, func, context.type_cache.expression_types[expression]);
-                  if (subtype->kind == type_t::ARRAY_TYPE) {
-                    subtype = subtype->subtype;
-                  }
-                  if (type_is_pointer(context, func, context.type_cache.expression_types[expression->right])) {
-                    emit_type_specifier(out << output_marker << " = getelementptr ", context, func, subtype) << ", ";
-                    emit_type_specifier(out, context, func, context.type_cache.expression_types[expression->right]);
-                    out << " " << right_value << ", ";
-                    emit_type_specifier(out, context, func, context.type_cache.expression_types[expression->left]);
-                    out << " " << left_value << std::endl;
-                  } else {
-                    emit_type_specifier(out << output_marker << " = getelementptr ", context, func, subtype) << ", ";
-                    emit_type_specifier(out, context, func, context.type_cache.expression_types[expression->left]);
-                    out << " " << left_value << ", ";
-                    emit_type_specifier(out, context, func, context.type_cache.expression_types[expression->right]);
-                    out << " " << right_value << std::endl;
-                  }
-                } else {
-                  emit_simple_binary_operation(out, context, func, output_marker, left_value, right_value, context.type_cache.expression_types[expression], "add", "fadd");
-                }
-                break;
-              }
-            case SUB_OP:
-              {
-                if (type_is_pointer(context, func, context.type_cache.expression_types[expression])) {
-                  Type* subtype = extract_subtype(context, func, context.type_cache.expression_types[expression]);
-                  if (type_is_pointer(context, func, context.type_cache.expression_types[expression->right])) {
-                    std::string inverted_offset = markers.new_marker();
-                    out << inverted_offset << " = mul ";
-                    emit_type_specifier(out, context, func, context.type_cache.expression_types[expression->left]);
-                    out << " " << left_value << ", -1" << std::endl;
-
-                    emit_type_specifier(out << output_marker << " = getelementptr ", context, func, subtype) << ", ";
-                    emit_type_specifier(out, context, func, context.type_cache.expression_types[expression->right]);
-                    out << " " << right_value << ", ";
-                    emit_type_specifier(out, context, func, context.type_cache.expression_types[expression->left]);
-                    out << " " << inverted_offset << std::endl;
-                  } else {
-                    std::string inverted_offset = markers.new_marker();
-                    out << inverted_offset << " = mul ";
-                    emit_type_specifier(out, context, func, context.type_cache.expression_types[expression->right]);
-                    out << " " << right_value << ", -1" << std::endl;
-
-                    emit_type_specifier(out << output_marker << " = getelementptr ", context, func, subtype) << ", ";
-                    emit_type_specifier(out, context, func, context.type_cache.expression_types[expression->left]);
-                    out << " " << left_value << ", ";
-                    emit_type_specifier(out, context, func, context.type_cache.expression_types[expression->right]);
-                    out << " " << inverted_offset << std::endl;
-                  }
-                } else {
-                  emit_simple_binary_operation(out, context, func, output_marker, left_value, right_value, context.type_cache.expression_types[expression], "sub", "fsub");
-                }
-                break;
-              }
-            case XOR_OP:
-              {
-                if (type_is_pointer(context, func, context.type_cache.expression_types[expression])) {
-                  assert(false);
-                } else {
-                  emit_integer_only_binary_operation(out, context, func, output_marker, left_value, right_value, master_operand_type, "xor");
-                }
-                break;
-              }
-            case AND_OP:
-              {
-                if (type_is_pointer(context, func, master_operand_type)) {
-                  assert(false);
-                } else {
-                  emit_integer_only_binary_operation(out, context, func, output_marker, left_value, right_value, master_operand_type, "and");
-                }
-                break;
-              }
-            case OR_OP:
-              {
-                if (type_is_pointer(context, func, master_operand_type)) {
-                  assert(false);
-                } else {
-                  emit_integer_only_binary_operation(out, context, func, output_marker, left_value, right_value, master_operand_type, "or");
-                }
-                break;
-              }
-            case LROT_OP:
-              {
-                if (type_is_pointer(context, func, master_operand_type)) {
-                  assert(false);
-                } else {
-                  emit_integer_only_binary_operation(out, context, func, output_marker, left_value, right_value, master_operand_type, "shl");
-                }
-                break;
-              }
-            case RROT_OP:
-              {
-                if (type_is_pointer(context, func, master_operand_type)) {
-                  assert(false);
-                } else {
-                  emit_integer_only_binary_operation(out, context, func, output_marker, left_value, right_value, master_operand_type, "lshr");
-                }
-                break;
-              }
-            case SCA_OP:
-              {
-                if (type_is_pointer(context, func, master_operand_type)) {
-                  assert(false);
-                } else {
-                  emit_integer_only_binary_operation(out, context, func, output_marker, left_value, right_value, master_operand_type, "and");
-                }
-                break;
-              }
-            case SCO_OP:
-              {
-                if (type_is_pointer(context, func, master_operand_type)) {
-                  assert(false);
-                } else {
-                  emit_integer_only_binary_operation(out, context, func, output_marker, left_value, right_value, master_operand_type, "or");
-                }
-                break;
-              }
-            case GE_OP:
-              {
-                if (type_is_pointer(context, func, master_operand_type)) {
-                  assert(false);
-                } else {
-                  emit_simple_binary_operation(out, context, func, output_marker, left_value, right_value, master_operand_type, "icmp sge", "fcmp oge");
-                }
-                break;
-              }
-            case LE_OP:
-              {
-                emit_simple_binary_operation(out, context, func, output_marker, left_value, right_value, master_operand_type, "icmp sle", "fcmp ole");
-                break;
-              }
-            case EQ_OP:
-              {
-                emit_simple_binary_operation(out, context, func, output_marker, left_value, right_value, master_operand_type, "icmp eq", "fcmp oeq");
-                break;
-              }
-            case NE_OP:
-              {
-                emit_simple_binary_operation(out, context, func, output_marker, left_value, right_value, master_operand_type, "icmp ne", "fcmp one");
-                break;
-              }
-            case GR_OP:
-              {
-                emit_simple_binary_operation(out, context, func, output_marker, left_value, right_value, master_operand_type, "icmp sgt", "fcmp ogt");
-                break;
-              }
-            case LR_OP:
-              {
-                emit_simple_binary_operation(out, context, func, output_marker, left_value, right_value, master_operand_type, "icmp slt", "fcmp olt");
-                break;
-              }
-            default:
-              assert(false);
-          }
-          Type::Delete(master_operand_type);
+          emit_binary_operation(out, context, func, markers, expression, left_value, right_value, output_marker);
         }
         break;
       }
@@ -1024,9 +1960,11 @@ std::ostream& emit_expression_as_rvalue(std::ostream& out, CGContext& context, D
               emit_expression_as_rvalue(out, context, func, markers, expression->value, value_marker);
               output_marker = markers.new_marker();
               // TODO: ALIGN
+              Type* value_type = extract_subtype(context, func, context.type_cache.expression_types[expression->value]);
               out << output_marker << " = load ";
-              emit_type_specifier(out, context, func, extract_subtype(context, func, context.type_cache.expression_types[expression->value]));
-              out << ", ptr " << value_marker << ", align 8" << std::endl;
+              emit_type_specifier(out, context, func, value_type);
+              out << ", ptr " << value_marker << ", align 8" << craft_alias_metadata(context, find_restrict_base_of_place(context, func, expression));
+              out << craft_tbaa_metadata(context, func, expression, value_type) << '\n';
               break;
             }
           case AND_OP: //&
@@ -1044,18 +1982,21 @@ std::ostream& emit_expression_as_rvalue(std::ostream& out, CGContext& context, D
                 output_marker = markers.new_marker();
 
                 // TODO: STUB
-                if (context.type_cache.expression_types[expression]->kind == type_t::DOUBLE_TYPE) {
-                  out << output_marker << " = fsub ";
+                std::pair<Declaration*, Type*> element = extract_element_type(context, func, context.type_cache.expression_types[expression]);
+                if (element.second->kind == type_t::DOUBLE_TYPE) {
+                  out << output_marker << " = " << craft_floating_point_op(func, "fsub") << " ";
                 } else {
                   out << output_marker << " = sub ";
                 }
                 emit_type_specifier(out, context, func, context.type_cache.expression_types[expression]);
-                if (context.type_cache.expression_types[expression]->kind == type_t::DOUBLE_TYPE) {
+                if (type_is_vector(context, func, context.type_cache.expression_types[expression])) {
+                  out << " zeroinitializer, ";
+                } else if (element.second->kind == type_t::DOUBLE_TYPE) {
                   out << " 0.0, ";
                 } else {
                   out << " 0, ";
                 }
-                out << " " << value_marker << std::endl;
+                out << " " << value_marker << '\n';
               } else if (is_logical_operator(expression->operator_)) {
                 std::string value_marker;
                 emit_expression_as_rvalue(out, context, func, markers, expression->value, value_marker);
@@ -1065,7 +2006,7 @@ std::ostream& emit_expression_as_rvalue(std::ostream& out, CGContext& context, D
                 out << output_marker << " = sub ";
                 emit_type_specifier(out, context, func, context.type_cache.expression_types[expression]);
                 out << " 1, ";
-                out << " " << value_marker << std::endl;
+                out << " " << value_marker << '\n';
               } else {
                 assert(false);
               }
@@ -1093,11 +2034,24 @@ std::ostream& emit_expression_as_rvalue(std::ostream& out, CGContext& context, D
         output_marker = markers.new_marker();
         out << output_marker << " = va_arg ptr %valist, ";
         emit_type_specifier(out, context, func, expression->type);
-        out << std::endl;
+        out << '\n';
         break;
       }
     case ARRAY_ACCESS_EXPR:
       {
+        if (type_is_vector(context, func, context.type_cache.expression_types[expression->left])) {
+          // lane extract
+          std::string vector_value;
+          emit_expression_as_rvalue(out, context, func, markers, expression->left, vector_value);
+          std::string index_value;
+          emit_expression_as_rvalue(out, context, func, markers, expression->right, index_value);
+
+          output_marker = markers.new_marker();
+          emit_type_specifier(out << output_marker << " = extractelement ", context, func, context.type_cache.expression_types[expression->left]) << " " << vector_value << ", ";
+          emit_type_specifier(out, context, func, context.type_cache.expression_types[expression->right]) << " " << index_value << '\n';
+          break;
+        }
+
         std::string element_marker;
         emit_expression_as_lvalue(out, context, func, markers, expression, element_marker);
 
@@ -1105,7 +2059,77 @@ std::ostream& emit_expression_as_rvalue(std::ostream& out, CGContext& context, D
         output_marker = markers.new_marker();
         out << output_marker << " = load ";
         emit_type_specifier(out, context, func, context.type_cache.expression_types[expression]);
-        out << ", ptr " << element_marker << ", align 8" << std::endl;
+        out << ", ptr " << element_marker << ", align 8" << craft_alias_metadata(context, find_restrict_base_of_place(context, func, expression));
+        out << craft_tbaa_metadata(context, func, expression, context.type_cache.expression_types[expression]) << '\n';
+        break;
+      }
+    case VECTOR_LOAD_EXPR:
+      {
+        std::string pointer_value;
+        emit_expression_as_rvalue(out, context, func, markers, expression->value, pointer_value);
+
+        output_marker = markers.new_marker();
+        std::uintmax_t alignment = compute_vector_alignment(context, func, expression->type, expression->integer_literal);
+        emit_type_specifier(out << output_marker << " = load ", context, func, expression->type) << ", ptr " << pointer_value << ", align " << alignment << craft_alias_metadata(context, find_restrict_base_of_address(context, func, expression->value));
+        out << craft_tbaa_metadata(context, func, nullptr, expression->type) << '\n';
+        break;
+      }
+    case VECTOR_STORE_EXPR:
+      {
+        std::string vector_value;
+        emit_expression_as_rvalue(out, context, func, markers, expression->right, vector_value);
+        std::string pointer_value;
+        emit_expression_as_rvalue(out, context, func, markers, expression->left, pointer_value);
+
+        Type* vector_type = context.type_cache.expression_types[expression->right];
+        std::uintmax_t alignment = compute_vector_alignment(context, func, vector_type, expression->integer_literal);
+        emit_type_specifier(out << "store ", context, func, vector_type) << " " << vector_value << ", ptr " << pointer_value << ", align " << alignment << craft_alias_metadata(context, find_restrict_base_of_address(context, func, expression->left));
+        out << craft_tbaa_metadata(context, func, nullptr, vector_type) << '\n';
+        output_marker = "if_you_read_this_you_are_operating_on_a_vector_store";
+        break;
+      }
+    case VECTOR_SHUFFLE_EXPR:
+      {
+        std::string left_value;
+        emit_expression_as_rvalue(out, context, func, markers, expression->left, left_value);
+        std::string right_value;
+        emit_expression_as_rvalue(out, context, func, markers, expression->right, right_value);
+
+        Type* operand_type = context.type_cache.expression_types[expression->left];
+        output_marker = markers.new_marker();
+        emit_type_specifier(out << output_marker << " = shufflevector ", context, func, operand_type) << " " << left_value << ", ";
+        emit_type_specifier(out, context, func, operand_type) << " " << right_value << ", ";
+        out << "<" << expression->arguments.size() << " x i32> <";
+        bool first = true;
+        for (Expression* lane : expression->arguments) {
+          if (first) {
+            first = false;
+          } else {
+            out << ", ";
+          }
+          out << "i32 " << lane->integer_literal;
+        }
+        out << ">" << '\n';
+        break;
+      }
+    case AGGREGATE_LITERAL_EXPR:
+      {
+        std::pair<Declaration*, Type*> aggregate = resolve_type_if_symbol(context, func, expression->type);
+        std::string type_specifier = craft_type_specifier(context, func, expression->type);
+        output_marker = "zeroinitializer";
+        for (std::uintmax_t index = 0; index < expression->arguments.size(); ++index) {
+          Expression* element = expression->arguments[index];
+          Type* slot_type = aggregate.second->kind == ARRAY_TYPE ? aggregate.second->subtype : aggregate.second->fields[index].second;
+          std::string element_value;
+          emit_expression_as_rvalue(out, context, func, markers, element, element_value);
+          std::string casted_value;
+          cast_value_to_requested_type(out, context, func, markers, element_value, context.type_cache.expression_types[element], slot_type, casted_value);
+
+          std::string inserted_value = markers.new_marker();
+          out << inserted_value << " = insertvalue " << type_specifier << " " << output_marker << ", ";
+          emit_type_specifier(out, context, aggregate.first, slot_type) << " " << casted_value << ", " << index << '\n';
+          output_marker = inserted_value;
+        }
         break;
       }
   }
@@ -1121,6 +2145,12 @@ std::ostream& emit_statement(std::ostream& out, CGContext& context, Declaration*
   switch (statement->kind) {
     case statement_t::FOR_STMT:
       {
+        bool truth = false;
+        if (find_folded_condition(context, statement->condition, truth) && !truth) {
+          // the body is never entered
+          emit_statement(out, context, func, markers, statement->init);
+          break;
+        }
         PRESERVE_MARKER_KEY(CONTINUE_MK);
         PRESERVE_MARKER_KEY(BREAK_MK);
 
@@ -1130,22 +2160,22 @@ std::ostream& emit_statement(std::ostream& out, CGContext& context, Declaration*
         std::string end_for = markers.new_marker(BREAK_MK);
 
         emit_statement(out, context, func, markers, statement->init);
-        out << "br label " << before_condition << std::endl;
+        out << "br label " << before_condition << '\n';
 
-        emit_marker(out, before_condition) << std::endl;
+        emit_marker(out, before_condition) << '\n';
         std::string rvalue_marker;
         emit_expression_as_rvalue(out, context, func, markers, statement->condition, rvalue_marker);
-        out << "br i1 " << rvalue_marker << ", label " << before_body << ", label " << end_for << std::endl;
+        out << "br i1 " << rvalue_marker << ", label " << before_body << ", label " << end_for << '\n';
 
-        emit_marker(out, before_body) << std::endl;
+        emit_marker(out, before_body) << '\n';
         emit_statement(out, context, func, markers, statement->body);
-        out << "br label " << after_body << std::endl;
+        out << "br label " << after_body << '\n';
 
-        emit_marker(out, after_body) << std::endl;
+        emit_marker(out, after_body) << '\n';
         emit_expression_as_rvalue(out, context, func, markers, statement->step, rvalue_marker);
-        out << "br label " << before_condition << std::endl;
+        out << "br label " << before_condition << '\n';
 
-        emit_marker(out, end_for) << std::endl;
+        emit_marker(out, end_for) << '\n';
 
         RESTORE_MARKER_KEY(CONTINUE_MK);
         RESTORE_MARKER_KEY(BREAK_MK);
@@ -1155,7 +2185,11 @@ std::ostream& emit_statement(std::ostream& out, CGContext& context, Declaration*
       {
         markers.add_var(statement);
         emit_variable_allocation(out, context, func, markers, statement);
-        if (statement->expr != nullptr) {
+        if (statement->expr != nullptr && type_is_aggregate(context, func, statement->type)) {
+          std::string source;
+          bool source_is_address = emit_aggregate_source(out, context, func, markers, statement->expr, source);
+          emit_aggregate_copy(out, context, func, markers.get_var(statement), source, source_is_address, statement->type, craft_tbaa_metadata(context, func, nullptr, statement->type));
+        } else if (statement->expr != nullptr) {
           std::string rvalue_marker;
           emit_expression_as_rvalue(out, context, func, markers, statement->expr, rvalue_marker);
           Type* rvalue_type = context.type_cache.expression_types[statement->expr];
@@ -1165,7 +2199,7 @@ std::ostream& emit_statement(std::ostream& out, CGContext& context, Declaration*
           rvalue_marker = right_marker;
 
           // TODO: ALIGN
-          emit_type_specifier(out << "store ", context, func, statement->type) << " " << rvalue_marker << ", ptr " << markers.get_var(statement) << ", align 8" << std::endl;
+          emit_type_specifier(out << "store ", context, func, statement->type) << " " << rvalue_marker << ", ptr " << markers.get_var(statement) << ", align 8" << craft_tbaa_metadata(context, func, nullptr, statement->type) << '\n';
         }
         break;
       }
@@ -1180,11 +2214,16 @@ std::ostream& emit_statement(std::ostream& out, CGContext& context, Declaration*
       {
         std::string break_marker = markers.get_key(BREAK_MK);
         assert(!break_marker.empty());
-        out << "br label " << break_marker << std::endl;
+        out << "br label " << break_marker << '\n';
         break;
       }
     case statement_t::WHILE_STMT:
       {
+        bool truth = false;
+        if (find_folded_condition(context, statement->condition, truth) && !truth) {
+          // the body is never entered
+          break;
+        }
         PRESERVE_MARKER_KEY(CONTINUE_MK);
         PRESERVE_MARKER_KEY(BREAK_MK);
 
@@ -1192,18 +2231,23 @@ std::ostream& emit_statement(std::ostream& out, CGContext& context, Declaration*
         std::string before_body = markers.new_marker();
         std::string after_body = markers.new_marker(BREAK_MK);
 
-        out << "br label " << before_condition << std::endl;
+        out << "br label " << before_condition << '\n';
 
-        emit_marker(out, before_condition) << std::endl;
-        std::string rvalue_marker;
-        emit_expression_as_rvalue(out, context, func, markers, statement->condition, rvalue_marker);
-        out << "br i1 " << rvalue_marker << ", label " << before_body << ", label " << after_body << std::endl;
+        emit_marker(out, before_condition) << '\n';
+        if (find_folded_condition(context, statement->condition, truth)) {
+          // only a break leaves the loop
+          out << "br label " << before_body << '\n';
+        } else {
+          std::string rvalue_marker;
+          emit_expression_as_rvalue(out, context, func, markers, statement->condition, rvalue_marker);
+          out << "br i1 " << rvalue_marker << ", label " << before_body << ", label " << after_body << '\n';
+        }
 
-        emit_marker(out, before_body) << std::endl;
+        emit_marker(out, before_body) << '\n';
         emit_statement(out, context, func, markers, statement->body);
-        out << "br label " << before_condition << std::endl;
+        out << "br label " << before_condition << '\n';
 
-        emit_marker(out, after_body) << std::endl;
+        emit_marker(out, after_body) << '\n';
 
         RESTORE_MARKER_KEY(CONTINUE_MK);
         RESTORE_MARKER_KEY(BREAK_MK);
@@ -1212,7 +2256,11 @@ std::ostream& emit_statement(std::ostream& out, CGContext& context, Declaration*
     case statement_t::RETURN_STMT:
       {
         std::string rvalue_marker;
-        if (statement->expr != nullptr) {
+        if (statement->expr != nullptr && classify_abi(context, func, func->type).first == ABI_MEMORY) {
+          bool source_is_address = emit_aggregate_source(out, context, func, markers, statement->expr, rvalue_marker);
+          emit_aggregate_copy(out, context, func, "%.sret", rvalue_marker, source_is_address, func->type, "");
+          emit_manual_return_statement(out, context, func, markers, rvalue_marker);
+        } else if (statement->expr != nullptr) {
           emit_expression_as_rvalue(out, context, func, markers, statement->expr, rvalue_marker);
           emit_manual_return_statement(out, context, func, markers, rvalue_marker);
         } else {
@@ -1225,37 +2273,43 @@ std::ostream& emit_statement(std::ostream& out, CGContext& context, Declaration*
       }
     case statement_t::IF_ELSE_STMT:
       {
-        if (statement->else_ != nullptr) {
+        bool truth = false;
+        if (find_folded_condition(context, statement->condition, truth)) {
+          // only the taken arm is emitted
+          Statement* taken = truth ? statement->then : statement->else_;
+          if (taken != nullptr)
+            emit_statement(out, context, func, markers, taken);
+        } else if (statement->else_ != nullptr) {
           std::string before_then = markers.new_marker();
           std::string before_else = markers.new_marker();
           std::string after_else = markers.new_marker();
 
           std::string rvalue_marker;
           emit_expression_as_rvalue(out, context, func, markers, statement->condition, rvalue_marker);
-          out << "br i1 " << rvalue_marker << ", label " << before_then << ", label " << before_else << std::endl;
-          emit_marker(out, before_then) << std::endl;
+          out << "br i1 " << rvalue_marker << ", label " << before_then << ", label " << before_else << '\n';
+          emit_marker(out, before_then) << '\n';
 
           emit_statement(out, context, func, markers, statement->then);
-          out << "br label " << after_else << std::endl;
+          out << "br label " << after_else << '\n';
 
-          emit_marker(out, before_else) << std::endl;
+          emit_marker(out, before_else) << '\n';
 
           emit_statement(out, context, func, markers, statement->else_);
-          out << "br label " << after_else << std::endl;
-          emit_marker(out, after_else) << std::endl;
+          out << "br label " << after_else << '\n';
+          emit_marker(out, after_else) << '\n';
         } else {
           std::string before_then = markers.new_marker();
           std::string after_then = markers.new_marker();
 
           std::string rvalue_marker;
           emit_expression_as_rvalue(out, context, func, markers, statement->condition, rvalue_marker);
-          out << "br i1 " << rvalue_marker << ", label " << before_then << ", label " << after_then << std::endl;
-          emit_marker(out, before_then) << std::endl;
+          out << "br i1 " << rvalue_marker << ", label " << before_then << ", label " << after_then << '\n';
+          emit_marker(out, before_then) << '\n';
 
           emit_statement(out, context, func, markers, statement->then);
-          out << "br label " << after_then << std::endl;
+          out << "br label " << after_then << '\n';
 
-          emit_marker(out, after_then) << std::endl;
+          emit_marker(out, after_then) << '\n';
         }
 
         break;
@@ -1264,7 +2318,7 @@ std::ostream& emit_statement(std::ostream& out, CGContext& context, Declaration*
       {
         std::string continue_marker = markers.get_key(CONTINUE_MK);
         assert(!continue_marker.empty());
-        out << "br label " << continue_marker << std::endl;
+        out << "br label " << continue_marker << '\n';
         break;
       }
     case statement_t::EXPRESSION_STMT:
@@ -1278,104 +2332,263 @@ std::ostream& emit_statement(std::ostream& out, CGContext& context, Declaration*
   return out;
 }
 
+bool is_libm_function(Declaration* decl) {
+  static const std::set<std::string> libm_functions = {
+    "sqrt", "sqrtf", "cbrt", "cbrtf", "hypot", "hypotf",
+    "sin", "sinf", "cos", "cosf", "tan", "tanf", "asin", "asinf", "acos", "acosf", "atan", "atanf", "atan2", "atan2f",
+    "sinh", "sinhf", "cosh", "coshf", "tanh", "tanhf",
+    "exp", "expf", "exp2", "exp2f", "expm1", "expm1f", "log", "logf", "log2", "log2f", "log10", "log10f", "log1p", "log1pf",
+    "pow", "powf", "fmod", "fmodf", "fma", "fmaf", "fabs", "fabsf",
+    "floor", "floorf", "ceil", "ceilf", "trunc", "truncf", "round", "roundf", "rint", "rintf",
+    "fmin", "fminf", "fmax", "fmaxf", "copysign", "copysignf"
+  };
+  return decl->parent != nullptr && decl->parent->parent == nullptr && libm_functions.contains(decl->name);
+}
+
+std::ostream& emit_function_attributes(std::ostream& out, CGContext& context, Declaration* decl) {
+  std::string attributes;
+  auto append = [&attributes](const char* attribute) {
+    if (!attributes.empty())
+      attributes += " ";
+    attributes += attribute;
+  };
+  if (decl->attributes & ATTRIBUTE_INLINE)
+    append("inlinehint");
+  if (decl->attributes & ATTRIBUTE_ALWAYS_INLINE)
+    append("alwaysinline");
+  if (decl->attributes & ATTRIBUTE_NOINLINE)
+    append("noinline");
+  if (decl->attributes & ATTRIBUTE_HOT)
+    append("hot");
+  if (decl->attributes & ATTRIBUTE_COLD)
+    append("cold");
+  if (decl->attributes & ATTRIBUTE_NORETURN)
+    append("noreturn");
+
+  // the stronger between the annotated and the inferred memory effects
+  memory_effect_t memory = (decl->attributes & ATTRIBUTE_PURE) ? MEMORY_EFFECT_READ : MEMORY_EFFECT_WRITE;
+  if (!API::SET_MATH_ERRNO && decl->body == nullptr && is_libm_function(decl)) {
+    // without errno, libm functions are pure computations
+    append("nounwind");
+    append("willreturn");
+    memory = MEMORY_EFFECT_NONE;
+  }
+  if (const FunctionSummary* summary = context.attribute_cache.get_summary(decl)) {
+    if (summary->nounwind)
+      append("nounwind");
+    if (summary->norecurse)
+      append("norecurse");
+    if (summary->willreturn)
+      append("willreturn");
+    memory = std::min(memory, summary->memory);
+  }
+  // the result of an sret function is written through its pointer argument
+  bool writes_sret = decl->type->kind != VOID_TYPE && classify_abi(context, decl, decl->type).first == ABI_MEMORY;
+  if (memory == MEMORY_EFFECT_NONE)
+    append(writes_sret ? "memory(argmem: write)" : "memory(none)");
+  if (memory == MEMORY_EFFECT_READ)
+    append(writes_sret ? "memory(read, argmem: readwrite)" : "memory(read)");
+
+  if (!attributes.empty()) {
+    out << " #" << context.attribute_store.get_attribute_group(attributes);
+  }
+  return out;
+}
+
+// void for results returned through an sret pointer
+std::ostream& emit_return_type_specifier(std::ostream& out, CGContext& context, Declaration* decl) {
+  std::pair<abi_pass_t, std::string> abi = classify_abi(context, decl, decl->type);
+  if (abi.first == ABI_MEMORY) {
+    out << "void";
+  } else if (abi.first == ABI_COERCED) {
+    out << abi.second;
+  } else {
+    emit_type_specifier(out, context, decl, decl->type);
+  }
+  return out;
+}
+
+std::ostream& emit_sret_parameter(std::ostream& out, CGContext& context, Declaration* decl) {
+  if (classify_abi(context, decl, decl->type).first == ABI_MEMORY) {
+    emit_type_specifier(out << "ptr noalias sret(", context, decl, decl->type) << ") align 8";
+  }
+  return out;
+}
+
 std::ostream& emit_function_declaration(std::ostream& out, CGContext& context, Declaration* decl) {
   out << "declare ";
-  emit_type_specifier(out, context, decl, decl->type);
+  emit_return_type_specifier(out, context, decl);
   out << " @";
   emit_decl_label(out, decl);
   out  << "(";
-  bool first = true;
+  emit_sret_parameter(out, context, decl);
+  bool first = classify_abi(context, decl, decl->type).first != ABI_MEMORY;
   for (auto field : decl->parameters) {
     if (first) {
       first = false;
     } else {
       out << ", ";
     }
-    if (type_is_struct(context, decl, field.second) && context.size_cache.compute_size_of(context.symbol_cache, decl, field.second) > API::STRUCT_PASSED_AS_INLINE_SIZE_LIMIT) {
+    std::pair<abi_pass_t, std::string> abi = classify_abi(context, decl, field.second);
+    if (abi.first == ABI_MEMORY) {
       emit_type_specifier(out << "ptr byval(", context, decl, field.second) << ") align 8";
+    } else if (abi.first == ABI_COERCED) {
+      out << abi.second;
     } else {
       emit_type_specifier(out, context, decl, field.second);
+      if (type_is_restrict_pointer(context, decl, field.second))
+        out << " noalias";
     }
   }
   if (decl->is_variadic) {
-    if (decl->parameters.size() > 0)
+    if (!first)
       out << ", ";
     out << "...";
   }
-  out << ")" << std::endl;
+  out << ")";
+  emit_function_attributes(out, context, decl);
+  out << '\n';
   return out;
 }
 
 std::ostream& emit_parameters(std::ostream& out, CGContext& context, Markers& markers, Declaration* func) {
   for (std::uintmax_t param_index = 0; param_index < func->parameters.size(); ++param_index) {
     std::pair<std::string, Type*>* param = func->parameters.data() + param_index;
-    if (type_is_struct(context, func, param->second) && context.size_cache.compute_size_of(context.symbol_cache, func, param->second) > API::STRUCT_PASSED_AS_INLINE_SIZE_LIMIT) {
+    std::pair<abi_pass_t, std::string> abi = classify_abi(context, func, param->second);
+    if (abi.first == ABI_MEMORY) {
+    } else if (abi.first == ABI_COERCED) {
+      // the coerced registers are spilled, the slot is then accessed as the struct
+      markers.add_param(param);
+      std::string param_marker = markers.get_param(param);
+      out << param_marker << " = alloca " << abi.second << ", align 8" << '\n';
+      out << "store " << abi.second << " %" << param->first << ", ptr " << param_marker << ", align 8" << '\n';
     } else {
       markers.add_param(param);
       std::string param_marker = markers.get_param(param);
 
+      std::uintmax_t alignment = std::max<std::uintmax_t>(8, compute_abi_layout(context, func, param->second).second);
       out << param_marker << " = alloca ";
       emit_type_specifier(out, context, func, param->second);
-      out << ", align 8" << std::endl;
+      out << ", align " << alignment << '\n';
 
       // TODO: ALIGN
       out << "store ";
       emit_type_specifier(out, context, func, param->second);
-      out << " %" << param->first << ", ptr " << param_marker << ", align 8" << std::endl;
+      out << " %" << param->first << ", ptr " << param_marker << ", align 8" << craft_tbaa_metadata(context, func, nullptr, param->second) << '\n';
     }
   }
   return out;
 }
 
 std::ostream& emit_variadic_start(std::ostream& out) {
-  out << "%valist = alloca %llvm.va_list" << std::endl;
-  out << "call void @llvm.va_start(ptr %valist)" << std::endl;
+  out << "%valist = alloca %llvm.va_list" << '\n';
+  out << "call void @llvm.va_start(ptr %valist)" << '\n';
   return out;
 }
 
 std::ostream& emit_variadic_end(std::ostream& out) {
-  out << "call void @llvm.va_end(ptr %valist)" << std::endl;
+  out << "call void @llvm.va_end(ptr %valist)" << '\n';
   return out;
 }
 
 std::ostream& emit_function_definition(std::ostream& out, CGContext& context, Declaration* decl) {
   out << "define ";
-  emit_type_specifier(out, context, decl, decl->type);
+  emit_return_type_specifier(out, context, decl);
   out << " @";
   emit_decl_label(out, decl);
   out  << "(";
   bool first = true;
-  for (auto param : decl->parameters) {
+  if (classify_abi(context, decl, decl->type).first == ABI_MEMORY) {
+    emit_sret_parameter(out, context, decl) << " %.sret";
+    first = false;
+  }
+  const FunctionSummary* summary = context.attribute_cache.get_summary(decl);
+  for (std::uintmax_t param_index = 0; param_index < decl->parameters.size(); ++param_index) {
+    auto& param = decl->parameters[param_index];
     if (first) {
       first = false;
     } else {
       out << ", ";
     }
-    if (type_is_struct(context, decl, param.second) && context.size_cache.compute_size_of(context.symbol_cache, decl, param.second) > API::STRUCT_PASSED_AS_INLINE_SIZE_LIMIT) {
+    std::pair<abi_pass_t, std::string> abi = classify_abi(context, decl, param.second);
+    if (abi.first == ABI_MEMORY) {
       emit_type_specifier(out << "ptr byval(", context, decl, param.second) << ") align 8";
+    } else if (abi.first == ABI_COERCED) {
+      out << abi.second;
     } else {
       emit_type_specifier(out, context, decl, param.second);
+      if (type_is_restrict_pointer(context, decl, param.second))
+        out << " noalias";
+      if (summary != nullptr && summary->nocapture[param_index])
+        out << " nocapture";
     }
     out << " %" << param.first;
   }
   if (decl->is_variadic) {
-    if (decl->parameters.size() > 0)
+    if (!first)
       out << ", ";
     out << "...";
   }
-  out << ") {" << std::endl;
+  out << ")";
+  emit_function_attributes(out, context, decl);
+  out << " {" << '\n';
+  register_restrict_scopes(context, decl);
   Markers markers;
   emit_parameters(out, context, markers, decl);
   if (decl->is_variadic)
     emit_variadic_start(out);
-  emit_statement(out, context, decl, markers, decl->body);
+  // the body is held back until every slot it needs is known
+  std::ostringstream body;
+  emit_statement(body, context, decl, markers, decl->body);
   if (decl->is_variadic)
-    emit_variadic_end(out);
-  emit_automatic_return_statement(out, context, decl, markers);
-  out << "}" << std::endl;
+    emit_variadic_end(body);
+  emit_automatic_return_statement(body, context, decl, markers);
+  out << markers.entry_allocas;
+  out << std::move(body).str();
+  out << "}" << '\n';
   return out;
 }
 
+// folded value of a static variable, nullptr is zero
+std::string craft_constant_initializer(CGContext& context, Declaration* decl, Type* type, Expression* value) {
+  if (value == nullptr) {
+    return "zeroinitializer";
+  }
+  std::pair<Declaration*, Type*> solved = resolve_type_if_symbol(context, decl, type);
+  if (value->kind == AGGREGATE_LITERAL_EXPR) {
+    if (value->arguments.empty()) {
+      return "zeroinitializer";
+    }
+    bool is_array = solved.second->kind == ARRAY_TYPE;
+    std::uintmax_t count = is_array ? solved.second->size : solved.second->fields.size();
+    std::string result = is_array ? "[" : "{";
+    for (std::uintmax_t index = 0; index < count; ++index) {
+      Type* slot_type = is_array ? solved.second->subtype : solved.second->fields[index].second;
+      Expression* element = index < value->arguments.size() ? value->arguments[index] : nullptr;
+      result += index > 0 ? ", " : " ";
+      result += craft_type_specifier(context, solved.first, slot_type) + " " + craft_constant_initializer(context, solved.first, slot_type, element);
+    }
+    return result + (is_array ? " ]" : " }");
+  }
+  // literals are folded without casts, llvm wants them spelled as the slot type
+  if (solved.second->kind == DOUBLE_TYPE && value->kind == DOUBLE_EXPR) {
+    return context.literal_store.get_float_literal(value->decimal_literal, solved.second->size);
+  }
+  if (solved.second->kind == DOUBLE_TYPE) {
+    // an integer is rounded to the nearest value of the slot, as sitofp would, then spelled exactly
+    return context.literal_store.get_float_literal(value->kind == BOOLEAN_EXPR ? value->boolean_literal : value->integer_literal, solved.second->size);
+  }
+  if (solved.second->kind == INTEGER_TYPE && value->kind == DOUBLE_EXPR) {
+    // checked to fit when the initializer was folded
+    return context.literal_store.get_int_literal(truncate_decimal_to_integer(value->decimal_literal));
+  }
+  Markers markers;
+  std::string output_marker;
+  std::ostringstream discarded;
+  emit_expression_as_rvalue(discarded, context, decl, markers, value, output_marker);
+  return output_marker;
+}
+
 std::ostream& emit_static_variable_declaration(std::ostream& out, CGContext& context, Declaration* decl) {
   out << "@";
   emit_decl_label(out, decl);
@@ -1384,40 +2597,44 @@ std::ostream& emit_static_variable_declaration(std::ostream& out, CGContext& con
   switch (decl->modifier) {
     case modifier_t::MODIFIER_NONE:
       {
-        out << "internal dso_local global ";
+        out << "internal dso_local ";
+        // the address of an internal constant is never observed to be distinct
+        if (decl->is_const)
+          out << "unnamed_addr ";
         break;
       }
     case modifier_t::MODIFIER_EXTERN:
       {
-        out << "external dso_local global ";
+        out << "external dso_local ";
         break;
       }
     case modifier_t::MODIFIER_GLOBAL:
       {
-        out << "dso_local global ";
+        out << "dso_local ";
+        // other modules may compare its address
+        if (decl->is_const)
+          out << "local_unnamed_addr ";
         break;
       }
   }
+  out << (decl->is_const ? "constant " : "global ");
   emit_type_specifier(out, context, decl, decl->type);
-  
-  if (decl->value != nullptr) {
-    Markers markers;
-    std::string output_marker;
-    Expression* value = context.constant_cache.constants[decl];
-    emit_expression_as_rvalue(out << " ", context, decl, markers, value, output_marker);
-    out << output_marker;
+
+  if (decl->modifier != modifier_t::MODIFIER_EXTERN) {
+    Expression* value = decl->value != nullptr ? context.constant_cache.constants[decl] : nullptr;
+    out << " " << craft_constant_initializer(context, decl, decl->type, value);
   }
 
-  out << ", align 8" << std::endl;
+  out << ", align 8" << '\n';
   return out;
 }
 
-void emit_declaration(std::ostream& out, CGContext& context, Declaration* decl) {
+void emit_declaration(std::ostream& out, CGContext& context, Declaration* decl, bool with_definitions = true) {
   switch (decl->kind) {
     case MODULE_DECL:
       {
         for (Declaration* child : decl->children) {
-          emit_declaration(out, context, child);
+          emit_declaration(out, context, child, with_definitions);
         }
         break;
       };
@@ -1430,7 +2647,7 @@ void emit_declaration(std::ostream& out, CGContext& context, Declaration* decl)
       {
         if (decl->body == nullptr) {
           emit_function_declaration(out, context, decl);
-        } else {
+        } else if (with_definitions) {
           emit_function_definition(out, context, decl);
         }
         break;
@@ -1445,13 +2662,35 @@ void emit_declaration(std::ostream& out, CGContext& context, Declaration* decl)
 
 void emit_literal_store(std::ostream& out, CGContext& context) {
   for (auto item : context.literal_store.string_literals) {
-    out << context.literal_store.serialize(item.second) << " = private constant [" << item.first.size() + 1 << " x i8] c" << dump_unescaped_string(item.first, true) << ", align 1" << std::endl;
+    out << context.literal_store.serialize(item.second) << " = private constant [" << item.first.size() + 1 << " x i8] c" << dump_unescaped_string(item.first, true) << ", align 1" << '\n';
   }
   for (auto item : context.literal_store.int_literals) {
-    out << context.literal_store.serialize(item.second) << " = private constant i64 " << item.first << ", align 1" << std::endl;
+    out << context.literal_store.serialize(item.second) << " = private constant i64 " << item.first << ", align 1" << '\n';
   }
   for (auto item : context.literal_store.float_literals) {
-    out << context.literal_store.serialize(item.second) << " = private constant double " << item.first << ", align 1" << std::endl;
+    out << context.literal_store.serialize(item.second) << " = private constant double " << item.first << ", align 1" << '\n';
+  }
+}
+
+void emit_attribute_store(std::ostream& out, CGContext& context) {
+  std::vector<const std::string*> groups(context.attribute_store.groups.size());
+  for (const auto& [attributes, group] : context.attribute_store.groups) {
+    groups[group] = &attributes;
+  }
+  for (std::uintmax_t group = 0; group < groups.size(); ++group) {
+    out << "attributes #" << group << " = { " << *groups[group] << " }" << '\n';
+  }
+}
+
+void emit_metadata_store(std::ostream& out, CGContext& context) {
+  for (std::uintmax_t node = 0; node < context.metadata_store.nodes.size(); ++node) {
+    out << "!" << node << " = " << context.metadata_store.nodes[node] << '\n';
+  }
+}
+
+void emit_intrinsic_store(std::ostream& out, CGContext& context) {
+  for (const std::string& declaration : context.intrinsic_store.declarations) {
+    out << declaration << '\n';
   }
 }
 
@@ -1513,7 +2752,7 @@ void emit_type_declarations(std::ostream& out, CGContext& context, Declaration*
           processed_types[decl] = true;
           emit_dependencies_of_type_declarations(out, context, decl, processed_types, decl->type);
           auto found = resolve_type_if_symbol(context, decl, decl->type);
-          emit_type_specifier(emit_decl_label(out << "%", decl) << " = type ", context, decl, found.second) << std::endl;
+          emit_type_specifier(emit_decl_label(out << "%", decl) << " = type ", context, decl, found.second) << '\n';
         }
         break;
       };
@@ -1529,11 +2768,11 @@ void emit_type_declarations(std::ostream& out, CGContext& context, Declaration*
 }
 
 std::ostream& emit_variadic_utils(std::ostream& out) {
-  out << "%llvm.va_list = type { ptr }" << std::endl;
-  out << "declare void @llvm.va_start(ptr)" << std::endl;
-  out << "declare void @llvm.va_copy(ptr, ptr)" << std::endl;
-  out << "declare void @llvm.va_end(ptr)" << std::endl;
-  return out << std::endl;
+  out << "%llvm.va_list = type { ptr }" << '\n';
+  out << "declare void @llvm.va_start(ptr)" << '\n';
+  out << "declare void @llvm.va_copy(ptr, ptr)" << '\n';
+  out << "declare void @llvm.va_end(ptr)" << '\n';
+  return out << '\n';
 }
 
 void emit_llvm(std::ostream& out, CGContext& context, Declaration* decl_tree) {
@@ -1541,5 +2780,19 @@ void emit_llvm(std::ostream& out, CGContext& context, Declaration* decl_tree) {
   emit_variadic_utils(out);
   emit_type_declarations(out, context, decl_tree, processed_types);
   emit_declaration(out, context, decl_tree);
+  emit_llvm_epilogue(out, context);
+}
+
+void emit_llvm_prologue(std::ostream& out, CGContext& context, Declaration* decl_tree) {
+  std::unordered_map<Declaration*, bool> processed_types;
+  emit_variadic_utils(out);
+  emit_type_declarations(out, context, decl_tree, processed_types);
+  emit_declaration(out, context, decl_tree, false);
+}
+
+void emit_llvm_epilogue(std::ostream& out, CGContext& context) {
   emit_literal_store(out, context);
+  emit_intrinsic_store(out, context);
+  emit_attribute_store(out, context);
+  emit_metadata_store(out, context);
 }
@@ -0,0 +1,6 @@
+#include <lartc/codegen/intrinsic_store.hh>
+
+std::string IntrinsicStore::get_intrinsic(const std::string& return_type, const std::string& name, const std::string& parameter_types) {
+  declarations.insert("declare " + return_type + " @" + name + "(" + parameter_types + ")");
+  return "@" + name;
+}
@@ -0,0 +1,74 @@
+#include <lartc/codegen/ir_writer.hh>
+#include <algorithm>
+#include <cstring>
+
+bool IRWriter::open(const std::string& filepath) {
+  file = std::fopen(filepath.c_str(), "w");
+  if (file == nullptr) {
+    ok = false;
+    return false;
+  }
+  // the block already batches the writes
+  std::setvbuf(file, nullptr, _IONBF, 0);
+  block = std::make_unique<char[]>(BLOCK_SIZE);
+  setp(block.get(), block.get() + BLOCK_SIZE);
+  ok = true;
+  return true;
+}
+
+bool IRWriter::close() {
+  if (file != nullptr) {
+    write_block();
+    ok &= std::fclose(file) == 0;
+    file = nullptr;
+    block.reset();
+    setp(nullptr, nullptr);
+  }
+  return ok;
+}
+
+IRWriter::~IRWriter() {
+  close();
+}
+
+void IRWriter::write_block() {
+  std::size_t size = pptr() - pbase();
+  if (size > 0 && std::fwrite(pbase(), 1, size, file) != size) {
+    ok = false;
+  }
+  setp(block.get(), block.get() + BLOCK_SIZE);
+}
+
+IRWriter::int_type IRWriter::overflow(int_type ch) {
+  if (file == nullptr) {
+    return traits_type::eof();
+  }
+  write_block();
+  if (!traits_type::eq_int_type(ch, traits_type::eof())) {
+    *pptr() = traits_type::to_char_type(ch);
+    pbump(1);
+  }
+  return traits_type::not_eof(ch);
+}
+
+std::streamsize IRWriter::xsputn(const char* data, std::streamsize size) {
+  if (file == nullptr) {
+    return 0;
+  }
+  std::streamsize written = 0;
+  while (written < size) {
+    if (pptr() == epptr()) {
+      write_block();
+    }
+    std::streamsize chunk = std::min<std::streamsize>(size - written, epptr() - pptr());
+    std::memcpy(pptr(), data + written, chunk);
+    pbump((int)chunk);
+    written += chunk;
+  }
+  return written;
+}
+
+// flushes are absorbed by the block, it is written when full or when closed
+int IRWriter::sync() {
+  return 0;
+}
@@ -1,6 +1,7 @@
-#include <iomanip>
 #include <lartc/codegen/literal_store.hh>
-#include <sstream>
+#include <cctype>
+#include <charconv>
+#include <cstring>
 
 std::string LiteralStore::get_string_literal(const std::string& literal) {
   std::uintmax_t marker;
@@ -17,9 +18,19 @@ std::string LiteralStore::get_int_literal(std::intmax_t literal) {
   return std::to_string(literal);
 }
 
-std::string LiteralStore::get_float_literal(double_t literal) {
-  std::ostringstream out;
-  out << std::fixed << std::setprecision(19);
-  out << literal;
-  return out.str();
+// hex spells the exact bits, llvm wants the double pattern of the rounded value for a float
+std::string LiteralStore::get_float_literal(double_t literal, std::uintmax_t size) {
+  if (size <= 32) {
+    literal = (float)literal;
+  }
+  std::uint64_t bits;
+  std::memcpy(&bits, &literal, sizeof(bits));
+  char buffer[19] = {'0', 'x'};
+  char* end = std::to_chars(buffer + 2, buffer + sizeof(buffer), bits, 16).ptr;
+  std::string result = "0x";
+  result.append(16 - (end - buffer - 2), '0');
+  for (char* digit = buffer + 2; digit != end; ++digit) {
+    result += (char)std::toupper(*digit);
+  }
+  return result;
 }
@@ -70,3 +70,14 @@ std::string Markers::get_param(std::pair<std::string, Type*>* param) {
 void Markers::clear_params() {
   params.clear();
 }
+
+std::string Markers::new_entry_slot(const std::string& type_specifier, std::uintmax_t alignment) {
+  std::string slot = new_marker();
+  entry_allocas += slot;
+  entry_allocas += " = alloca ";
+  entry_allocas += type_specifier;
+  entry_allocas += ", align ";
+  entry_allocas += std::to_string(alignment);
+  entry_allocas += '\n';
+  return slot;
+}
@@ -0,0 +1,21 @@
+#include <lartc/codegen/metadata_store.hh>
+
+std::uintmax_t MetadataStore::add_node(const std::string& node) {
+  nodes.push_back(node);
+  return nodes.size() - 1;
+}
+
+std::uintmax_t MetadataStore::add_unique_node(const std::string& node) {
+  auto it = unique_nodes.find(node);
+  if (it != unique_nodes.end())
+    return it->second;
+  std::uintmax_t id = add_node(node);
+  unique_nodes[node] = id;
+  return id;
+}
+
+std::uintmax_t MetadataStore::add_distinct_node(const std::string& rest) {
+  std::uintmax_t id = nodes.size();
+  nodes.push_back("distinct !{!" + std::to_string(id) + rest + "}");
+  return id;
+}
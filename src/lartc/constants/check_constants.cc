@@ -1,9 +1,15 @@
 #include <cassert>
+#include <cmath>
 #include <iostream>
+#include <limits>
+#include <vector>
 #include <lartc/ast/operator.hh>
 #include <lartc/constants/check_constants.hh>
 #include <lartc/external_errors.hh>
 #include <lartc/internal_errors.hh>
+#include <lartc/api/config.hh>
+#include <lartc/typecheck/casting.hh>
+#include <lartc/typecheck/check_types.hh>
 
 std::pair<bool, std::pair<Expression*, Expression*>> cast_to_binexp_operands(Expression* left, Expression* right) {
   Expression* new_left = nullptr;
@@ -101,6 +107,308 @@ std::pair<bool, Expression*> cast_monexp_operand(Expression* expr) {
   return {ok, result};
 }
 
+std::intmax_t wrap_integer(std::intmax_t value, std::uintmax_t size, bool is_signed) {
+  if (size >= 64) {
+    return value;
+  }
+  std::uintmax_t mask = ((std::uintmax_t)1 << size) - 1;
+  std::uintmax_t bits = (std::uintmax_t)value & mask;
+  if (is_signed && ((bits >> (size - 1)) & 1)) {
+    bits |= ~mask;
+  }
+  return (std::intmax_t)bits;
+}
+
+// folds add, sub and mul into the width of the expression type, following the overflow mode
+bool fold_integer_arithmetic(FileDB& file_db, TypeCache& type_cache, Declaration* decl, Expression* expr, std::intmax_t left, std::intmax_t right, std::intmax_t& result) {
+  std::uintmax_t size = 64;
+  bool is_signed = true;
+  auto it = type_cache.expression_types.find(expr);
+  if (it != type_cache.expression_types.end() && it->second->kind == type_t::INTEGER_TYPE) {
+    size = it->second->size;
+    is_signed = it->second->is_signed;
+  }
+
+  bool overflowed = false;
+  if (is_signed) {
+    switch (expr->operator_) {
+      case ADD_OP: overflowed = __builtin_add_overflow(left, right, &result); break;
+      case SUB_OP: overflowed = __builtin_sub_overflow(left, right, &result); break;
+      case MUL_OP: overflowed = __builtin_mul_overflow(left, right, &result); break;
+      default: assert(false);
+    }
+  } else {
+    std::uintmax_t unsigned_result = 0;
+    switch (expr->operator_) {
+      case ADD_OP: overflowed = __builtin_add_overflow((std::uintmax_t)left, (std::uintmax_t)right, &unsigned_result); break;
+      case SUB_OP: overflowed = __builtin_sub_overflow((std::uintmax_t)left, (std::uintmax_t)right, &unsigned_result); break;
+      case MUL_OP: overflowed = __builtin_mul_overflow((std::uintmax_t)left, (std::uintmax_t)right, &unsigned_result); break;
+      default: assert(false);
+    }
+    result = (std::intmax_t)unsigned_result;
+  }
+
+  if (!overflowed && size < 64) {
+    if (is_signed) {
+      overflowed = result < -((std::intmax_t)1 << (size - 1)) || result >= ((std::intmax_t)1 << (size - 1));
+    } else {
+      overflowed = ((std::uintmax_t)result >> size) != 0;
+    }
+  }
+  if (!overflowed) {
+    return true;
+  }
+
+  if (API::OVERFLOW_MODE == API::TRAP_OVERFLOW || (API::OVERFLOW_MODE == API::UNDEFINED_OVERFLOW && is_signed)) {
+    throw_integer_overflow_in_constant_expression(file_db, file_db.expression_point(expr), decl);
+    return false;
+  }
+
+  // wrap around
+  result = wrap_integer(result, size, is_signed);
+  return true;
+}
+
+Type* resolve_constant_type(SymbolCache& symbol_cache, Declaration* context, Type* type) {
+  while (type != nullptr && type->kind == type_t::SYMBOL_TYPE)
+    type = resolve_symbol_type(symbol_cache, context, type).first;
+  return type;
+}
+
+// zero value of a type, as folded constants represent it
+Expression* make_zero_constant(SymbolCache& symbol_cache, Declaration* context, Type* type) {
+  Expression* result = nullptr;
+  type = resolve_constant_type(symbol_cache, context, type);
+  switch (type->kind) {
+    case type_t::INTEGER_TYPE:
+      result = Expression::New(INTEGER_EXPR);
+      break;
+    case type_t::DOUBLE_TYPE:
+      result = Expression::New(DOUBLE_EXPR);
+      break;
+    case type_t::BOOLEAN_TYPE:
+      result = Expression::New(BOOLEAN_EXPR);
+      break;
+    case type_t::POINTER_TYPE:
+    case type_t::FUNCTION_TYPE:
+      result = Expression::New(NULLPTR_EXPR);
+      break;
+    case type_t::ARRAY_TYPE:
+    case type_t::STRUCT_TYPE:
+    case type_t::VECTOR_TYPE:
+      result = Expression::New(AGGREGATE_LITERAL_EXPR);
+      result->type = Type::Clone(type);
+      break;
+    case type_t::VOID_TYPE:
+    case type_t::SYMBOL_TYPE:
+      result = Expression::New(INTEGER_EXPR);
+      break;
+  }
+  return result;
+}
+
+bool decimal_fits_in_integer(double_t decimal, std::uintmax_t size, bool is_signed) {
+  if (!std::isfinite(decimal))
+    return false;
+  double_t truncated = std::trunc(decimal);
+  if (is_signed)
+    return truncated >= -std::ldexp(1.0, size - 1) && truncated < std::ldexp(1.0, size - 1);
+  return truncated >= 0 && truncated < std::ldexp(1.0, size);
+}
+
+std::intmax_t truncate_decimal_to_integer(double_t decimal) {
+  if (decimal_fits_in_integer(decimal, 64, true))
+    return (std::intmax_t)decimal;
+  if (decimal_fits_in_integer(decimal, 64, false))
+    return (std::intmax_t)(std::uintmax_t)decimal;
+  return 0;
+}
+
+// whether cast_constant_to_type gives a value, a float out of the range of an integer type has none
+bool constant_converts_to_type(SymbolCache& symbol_cache, Declaration* context, Expression* value, Type* type) {
+  type = resolve_constant_type(symbol_cache, context, type);
+  if (type == nullptr || type->kind != type_t::INTEGER_TYPE || value->kind != DOUBLE_EXPR)
+    return true;
+  return decimal_fits_in_integer(value->decimal_literal, type->size, type->is_signed);
+}
+
+// every float stored into an integer slot of an initializer has to fit it
+bool constant_converts_to_slots(SymbolCache& symbol_cache, Declaration* context, Expression* value, Type* type) {
+  while (type != nullptr && type->kind == type_t::SYMBOL_TYPE) {
+    auto solved = resolve_symbol_type(symbol_cache, context, type);
+    type = solved.first;
+    context = solved.second;
+  }
+  if (value == nullptr || type == nullptr)
+    return true;
+  if (value->kind != AGGREGATE_LITERAL_EXPR)
+    return constant_converts_to_type(symbol_cache, context, value, type);
+  bool ok = true;
+  for (std::uintmax_t index = 0; index < value->arguments.size(); ++index) {
+    if (type->kind == type_t::ARRAY_TYPE || type->kind == type_t::VECTOR_TYPE)
+      ok &= constant_converts_to_slots(symbol_cache, context, value->arguments[index], type->subtype);
+    else if (type->kind == type_t::STRUCT_TYPE && index < type->fields.size())
+      ok &= constant_converts_to_slots(symbol_cache, context, value->arguments[index], type->fields[index].second);
+  }
+  return ok;
+}
+
+// implicit conversion of a folded scalar to the kind and width of a type
+Expression* cast_constant_to_type(SymbolCache& symbol_cache, Declaration* context, Expression* value, Type* type) {
+  type = resolve_constant_type(symbol_cache, context, type);
+  bool is_numeric = value->kind == INTEGER_EXPR || value->kind == CHARACTER_EXPR || value->kind == DOUBLE_EXPR || value->kind == BOOLEAN_EXPR;
+  if (type == nullptr || !is_numeric) {
+    return Expression::Clone(value);
+  }
+  double_t decimal = value->kind == DOUBLE_EXPR ? value->decimal_literal : value->kind == BOOLEAN_EXPR ? value->boolean_literal : value->integer_literal;
+  std::intmax_t integer = value->kind == DOUBLE_EXPR ? truncate_decimal_to_integer(value->decimal_literal) : value->kind == BOOLEAN_EXPR ? value->boolean_literal : value->integer_literal;
+  Expression* result = nullptr;
+  if (type->kind == type_t::INTEGER_TYPE) {
+    result = Expression::New(INTEGER_EXPR);
+    result->integer_literal = wrap_integer(integer, type->size, type->is_signed);
+  } else if (type->kind == type_t::DOUBLE_TYPE) {
+    result = Expression::New(DOUBLE_EXPR);
+    result->decimal_literal = type->size <= 32 ? (float)decimal : decimal;
+  } else if (type->kind == type_t::BOOLEAN_TYPE) {
+    result = Expression::New(BOOLEAN_EXPR);
+    result->boolean_literal = value->kind == DOUBLE_EXPR ? decimal != 0 : integer != 0;
+  } else {
+    result = Expression::Clone(value);
+  }
+  return result;
+}
+
+// bits of the integer type of an expression, the widest integer when it is unknown
+std::uintmax_t compute_constant_bit_width(SymbolCache& symbol_cache, TypeCache& type_cache, Declaration* decl, Expression* expr) {
+  auto it = type_cache.expression_types.find(expr);
+  Type* type = it == type_cache.expression_types.end() ? nullptr : resolve_constant_type(symbol_cache, decl, it->second);
+  return type != nullptr && type->kind == type_t::INTEGER_TYPE ? type->size : 64;
+}
+
+// a shift by a negative amount or by the width of its operand or more has no value
+bool is_shift_amount_in_range(Expression* amount, std::uintmax_t width) {
+  if (amount->kind == DOUBLE_EXPR)
+    return amount->decimal_literal >= 0 && amount->decimal_literal < width;
+  if (amount->kind == BOOLEAN_EXPR)
+    return true;
+  return amount->integer_literal >= 0 && (std::uintmax_t)amount->integer_literal < width;
+}
+
+// an integer division by zero, or of the smallest integer by -1, has no value
+bool is_integer_division_defined(Expression* dividend, Expression* divisor) {
+  if (divisor->kind == DOUBLE_EXPR)
+    return true;
+  if (divisor->kind == BOOLEAN_EXPR)
+    return divisor->boolean_literal;
+  return divisor->integer_literal != 0 && !(divisor->integer_literal == -1 && dividend->integer_literal == std::numeric_limits<std::intmax_t>::min());
+}
+
+// folded floats keep the precision of their type, at every step
+void round_constant_to_type(SymbolCache& symbol_cache, TypeCache& type_cache, Declaration* decl, Expression* expr, Expression* value) {
+  auto it = type_cache.expression_types.find(expr);
+  if (value->kind != DOUBLE_EXPR || it == type_cache.expression_types.end())
+    return;
+  Type* type = resolve_constant_type(symbol_cache, decl, it->second);
+  if (type != nullptr && type->kind == type_t::DOUBLE_TYPE && type->size <= 32)
+    value->decimal_literal = (float)value->decimal_literal;
+}
+
+enum evaluation_flow_t {
+  FLOW_NORMAL,
+  FLOW_BREAK,
+  FLOW_CONTINUE,
+  FLOW_RETURN,
+  FLOW_FAILED
+};
+
+std::pair<bool, Expression*> check_constants(FileDB& file_db, SymbolCache& symbol_cache, SizeCache& size_cache, TypeCache& type_cache, ConstantCache& constant_cache, Declaration* decl, Expression* expr);
+std::pair<bool, Expression*> evaluate_function_call(FileDB& file_db, SymbolCache& symbol_cache, SizeCache& size_cache, TypeCache& type_cache, ConstantCache& constant_cache, Expression* call, Declaration* function, std::vector<Expression*>& arguments);
+
+// the value a local place holds inside of the evaluated frame, nullptr when it is not a local place
+Expression** find_constant_slot(FileDB& file_db, SymbolCache& symbol_cache, SizeCache& size_cache, TypeCache& type_cache, ConstantCache& constant_cache, Declaration* function, Expression* place) {
+  switch (place->kind) {
+    case SYMBOL_EXPR:
+      {
+        ConstantFrame& frame = constant_cache.frames.back();
+        if (Statement* var = symbol_cache.get_statement(place)) {
+          return frame.variables.contains(var) ? &frame.variables[var] : nullptr;
+        }
+        if (std::pair<std::string, Type*>* param = symbol_cache.get_parameter(place)) {
+          return frame.parameters.contains(param) ? &frame.parameters[param] : nullptr;
+        }
+        return nullptr;
+      }
+    case ARRAY_ACCESS_EXPR:
+      {
+        // the index is evaluated before the slot is taken, as it may call functions
+        auto index = check_constants(file_db, symbol_cache, size_cache, type_cache, constant_cache, function, place->right);
+        std::intmax_t position = index.second->integer_literal;
+        bool is_index = index.first && (index.second->kind == INTEGER_EXPR || index.second->kind == CHARACTER_EXPR);
+        Expression::Delete(index.second);
+        Type* array_type = resolve_constant_type(symbol_cache, function, type_cache.expression_types[place->left]);
+        if (!is_index || array_type == nullptr || (array_type->kind != type_t::ARRAY_TYPE && array_type->kind != type_t::VECTOR_TYPE))
+          return nullptr;
+        if (position < 0 || (std::uintmax_t)position >= array_type->size)
+          return nullptr;
+        Expression** base = find_constant_slot(file_db, symbol_cache, size_cache, type_cache, constant_cache, function, place->left);
+        if (base == nullptr || (*base)->kind != AGGREGATE_LITERAL_EXPR)
+          return nullptr;
+        while ((*base)->arguments.size() < array_type->size)
+          (*base)->arguments.push_back(make_zero_constant(symbol_cache, function, array_type->subtype));
+        return &(*base)->arguments[position];
+      }
+    case BINARY_EXPR:
+      {
+        if (place->operator_ != DOT_OP)
+          return nullptr;
+        Type* struct_type = resolve_constant_type(symbol_cache, function, type_cache.expression_types[place->left]);
+        if (struct_type == nullptr || struct_type->kind != type_t::STRUCT_TYPE)
+          return nullptr;
+        std::intmax_t field_index = Type::ExtractFieldIndex(struct_type, place->right->symbol);
+        Expression** base = find_constant_slot(file_db, symbol_cache, size_cache, type_cache, constant_cache, function, place->left);
+        if (field_index < 0 || base == nullptr || (*base)->kind != AGGREGATE_LITERAL_EXPR)
+          return nullptr;
+        while ((*base)->arguments.size() < struct_type->fields.size())
+          (*base)->arguments.push_back(make_zero_constant(symbol_cache, function, struct_type->fields[(*base)->arguments.size()].second));
+        return &(*base)->arguments[field_index];
+      }
+    default:
+      return nullptr;
+  }
+}
+
+// whether a place is a local of the evaluated frame, or an element or field of one
+bool is_local_constant_place(SymbolCache& symbol_cache, ConstantCache& constant_cache, Expression* place) {
+  while (place->kind == ARRAY_ACCESS_EXPR || (place->kind == BINARY_EXPR && place->operator_ == DOT_OP))
+    place = place->left;
+  if (place->kind != SYMBOL_EXPR || constant_cache.frames.empty())
+    return false;
+  ConstantFrame& frame = constant_cache.frames.back();
+  if (Statement* var = symbol_cache.get_statement(place))
+    return frame.variables.contains(var);
+  if (std::pair<std::string, Type*>* param = symbol_cache.get_parameter(place))
+    return frame.parameters.contains(param);
+  return false;
+}
+
+// an element or field of a local is read in place, without copying the whole local
+std::pair<bool, Expression*> read_local_constant_place(FileDB& file_db, SymbolCache& symbol_cache, SizeCache& size_cache, TypeCache& type_cache, ConstantCache& constant_cache, Declaration* decl, Expression* place) {
+  Expression** slot = find_constant_slot(file_db, symbol_cache, size_cache, type_cache, constant_cache, decl, place);
+  if (slot == nullptr) {
+    throw_expression_is_used_in_constant_context_but_is_not_constant(file_db, file_db.expression_point(place), decl);
+    return {false, Expression::Clone(place)};
+  }
+  return {true, Expression::Clone(*slot)};
+}
+
+// element of a folded array or struct, zero when it was left out of the literal
+Expression* extract_constant_element(SymbolCache& symbol_cache, Declaration* decl, Expression* aggregate, std::uintmax_t index, Type* element_type) {
+  if (index < aggregate->arguments.size()) {
+    return Expression::Clone(aggregate->arguments[index]);
+  }
+  return make_zero_constant(symbol_cache, decl, element_type);
+}
+
 std::pair<bool, Expression*> check_constants(FileDB& file_db, SymbolCache& symbol_cache, SizeCache& size_cache, TypeCache& type_cache, ConstantCache& constant_cache, Declaration* decl, Expression* expr) {
   Expression* result = nullptr;
   bool ok = true;
@@ -112,24 +420,79 @@ std::pair<bool, Expression*> check_constants(FileDB& file_db, SymbolCache& symbo
 
   switch (expr->kind) {
     case VANEXT_EXPR:
+    case VECTOR_LOAD_EXPR:
+    case VECTOR_STORE_EXPR:
+    case VECTOR_SHUFFLE_EXPR:
       {
         ok = false;
-        throw_expression_is_used_in_constant_context_but_is_not_constant(file_db, file_db.expression_points[expr], decl);
+        throw_expression_is_used_in_constant_context_but_is_not_constant(file_db, file_db.expression_point(expr), decl);
         result = Expression::Clone(expr);
         break;
       }
     case CALL_EXPR:
       {
-        ok = false;
-        throw_expression_is_used_in_constant_context_but_is_not_constant(file_db, file_db.expression_points[expr], decl);
-        result = Expression::Clone(expr);
+        // lart functions with a body are evaluated at compile time
+        Declaration* function = nullptr;
+        if (expr->callable->kind == SYMBOL_EXPR && symbol_cache.get_builtin(expr->callable) == nullptr) {
+          Declaration* reference = symbol_cache.get_declaration(decl, expr->callable->symbol);
+          if (reference != nullptr && reference->kind == declaration_t::FUNCTION_DECL && reference->body != nullptr && !reference->is_variadic) {
+            function = reference;
+          }
+        }
+        if (function == nullptr) {
+          ok = false;
+          throw_expression_is_used_in_constant_context_but_is_not_constant(file_db, file_db.expression_point(expr), decl);
+          result = Expression::Clone(expr);
+          break;
+        }
+        std::vector<Expression*> arguments;
+        for (Expression* argument : expr->arguments) {
+          auto checked = check_constants(file_db, symbol_cache, size_cache, type_cache, constant_cache, decl, argument);
+          ok &= checked.first;
+          arguments.push_back(checked.second);
+        }
+        // when streaming, the body of the callee may not have been reached yet
+        if (ok && API::STREAM_FUNCTIONS) {
+          ok &= check_function_types(file_db, symbol_cache, type_cache, function);
+        }
+        if (ok) {
+          auto evaluated = evaluate_function_call(file_db, symbol_cache, size_cache, type_cache, constant_cache, expr, function, arguments);
+          ok &= evaluated.first;
+          result = evaluated.second;
+        } else {
+          result = Expression::Clone(expr);
+        }
+        for (Expression*& argument : arguments) {
+          Expression::Delete(argument);
+        }
         break;
       }
     case ARRAY_ACCESS_EXPR:
       {
-        ok = false;
-        throw_expression_is_used_in_constant_context_but_is_not_constant(file_db, file_db.expression_points[expr], decl);
-        result = Expression::Clone(expr);
+        if (is_local_constant_place(symbol_cache, constant_cache, expr)) {
+          auto read = read_local_constant_place(file_db, symbol_cache, size_cache, type_cache, constant_cache, decl, expr);
+          ok &= read.first;
+          result = read.second;
+          break;
+        }
+        auto left = check_constants(file_db, symbol_cache, size_cache, type_cache, constant_cache, decl, expr->left);
+        auto right = check_constants(file_db, symbol_cache, size_cache, type_cache, constant_cache, decl, expr->right);
+        ok &= left.first && right.first;
+        Type* array_type = resolve_constant_type(symbol_cache, decl, type_cache.expression_types[expr->left]);
+        bool in_bounds = ok && left.second->kind == AGGREGATE_LITERAL_EXPR
+                      && (right.second->kind == INTEGER_EXPR || right.second->kind == CHARACTER_EXPR)
+                      && array_type != nullptr && (array_type->kind == type_t::ARRAY_TYPE || array_type->kind == type_t::VECTOR_TYPE)
+                      && right.second->integer_literal >= 0 && (std::uintmax_t)right.second->integer_literal < array_type->size;
+        if (in_bounds) {
+          result = extract_constant_element(symbol_cache, decl, left.second, right.second->integer_literal, array_type->subtype);
+        } else {
+          if (ok)
+            throw_expression_is_used_in_constant_context_but_is_not_constant(file_db, file_db.expression_point(expr), decl);
+          ok = false;
+          result = Expression::Clone(expr);
+        }
+        Expression::Delete(left.second);
+        Expression::Delete(right.second);
         break;
       }
     case INTEGER_EXPR:
@@ -170,10 +533,29 @@ std::pair<bool, Expression*> check_constants(FileDB& file_db, SymbolCache& symbo
       }
     case SYMBOL_EXPR:
       {
+        if (!constant_cache.frames.empty()) {
+          if (Expression** slot = find_constant_slot(file_db, symbol_cache, size_cache, type_cache, constant_cache, decl, expr)) {
+            result = Expression::Clone(*slot);
+            break;
+          }
+        }
         Declaration* reference = symbol_cache.get_declaration(decl, expr->symbol);
-        if (reference->kind == declaration_t::STATIC_VARIABLE_DECL) {
+        if (reference == nullptr) {
+          ok = false;
+          throw_expression_is_used_in_constant_context_but_is_not_constant(file_db, file_db.expression_point(expr), decl);
+          result = Expression::Clone(expr);
+        } else if (reference->kind == declaration_t::STATIC_VARIABLE_DECL && reference->value == nullptr) {
+          // statics without a value are zero initialized, extern ones are unknown
+          if (reference->modifier == MODIFIER_EXTERN) {
+            ok = false;
+            throw_expression_is_used_in_constant_context_but_is_not_constant(file_db, file_db.expression_point(expr), decl);
+            result = Expression::Clone(expr);
+          } else {
+            result = make_zero_constant(symbol_cache, reference, reference->type);
+          }
+        } else if (reference->kind == declaration_t::STATIC_VARIABLE_DECL) {
             if (constant_cache.staging[reference]) {
-              throw_cyclic_dependency_between_static_variables_is_not_protected_by_usage_of_pointers(file_db, file_db.expression_points[expr], decl, reference);
+              throw_cyclic_dependency_between_static_variables_is_not_protected_by_usage_of_pointers(file_db, file_db.expression_point(expr), decl, reference);
               result = Expression::Clone(expr);
               ok = false;
             } else {
@@ -199,7 +581,66 @@ std::pair<bool, Expression*> check_constants(FileDB& file_db, SymbolCache& symbo
       }
     case BINARY_EXPR:
       {
+        if (expr->operator_ == DOT_OP && is_local_constant_place(symbol_cache, constant_cache, expr)) {
+          auto read = read_local_constant_place(file_db, symbol_cache, size_cache, type_cache, constant_cache, decl, expr);
+          ok &= read.first;
+          result = read.second;
+          break;
+        }
+        if (expr->operator_ == DOT_OP) {
+          auto left = check_constants(file_db, symbol_cache, size_cache, type_cache, constant_cache, decl, expr->left);
+          ok &= left.first;
+          Type* struct_type = resolve_constant_type(symbol_cache, decl, type_cache.expression_types[expr->left]);
+          std::intmax_t field_index = -1;
+          if (struct_type != nullptr && struct_type->kind == type_t::STRUCT_TYPE)
+            field_index = Type::ExtractFieldIndex(struct_type, expr->right->symbol);
+          if (ok && left.second->kind == AGGREGATE_LITERAL_EXPR && field_index >= 0) {
+            result = extract_constant_element(symbol_cache, decl, left.second, field_index, struct_type->fields[field_index].second);
+          } else {
+            if (ok)
+              throw_expression_is_used_in_constant_context_but_is_not_constant(file_db, file_db.expression_point(expr), decl);
+            ok = false;
+            result = Expression::Clone(expr);
+          }
+          Expression::Delete(left.second);
+          break;
+        }
+        if (expr->operator_ == ASS_OP) {
+          // only the locals of a compile-time evaluated function can be assigned
+          auto right = check_constants(file_db, symbol_cache, size_cache, type_cache, constant_cache, decl, expr->right);
+          ok &= right.first;
+          Expression** slot = nullptr;
+          if (ok && !constant_cache.frames.empty())
+            slot = find_constant_slot(file_db, symbol_cache, size_cache, type_cache, constant_cache, decl, expr->left);
+          if (slot != nullptr && !constant_converts_to_type(symbol_cache, decl, right.second, type_cache.expression_types[expr->left])) {
+            throw_float_does_not_fit_integer_in_constant_expression(file_db, file_db.expression_point(expr->right), decl);
+            ok = false;
+            result = Expression::Clone(expr);
+          } else if (slot != nullptr) {
+            Expression::Delete(*slot);
+            *slot = cast_constant_to_type(symbol_cache, decl, right.second, type_cache.expression_types[expr->left]);
+            result = Expression::Clone(*slot);
+          } else {
+            if (ok)
+              throw_expression_is_used_in_constant_context_but_is_not_constant(file_db, file_db.expression_point(expr), decl);
+            ok = false;
+            result = Expression::Clone(expr);
+          }
+          Expression::Delete(right.second);
+          break;
+        }
         auto left = check_constants(file_db, symbol_cache, size_cache, type_cache, constant_cache, decl, expr->left);
+        if ((expr->operator_ == SCA_OP || expr->operator_ == SCO_OP) && left.first) {
+          // short circuit, the right operand may not be evaluable
+          bool is_known = left.second->kind == BOOLEAN_EXPR || left.second->kind == INTEGER_EXPR || left.second->kind == CHARACTER_EXPR;
+          bool truth = left.second->kind == BOOLEAN_EXPR ? left.second->boolean_literal : left.second->integer_literal != 0;
+          if (is_known && truth == (expr->operator_ == SCO_OP)) {
+            result = Expression::New(BOOLEAN_EXPR);
+            result->boolean_literal = truth;
+            Expression::Delete(left.second);
+            break;
+          }
+        }
         auto right = check_constants(file_db, symbol_cache, size_cache, type_cache, constant_cache, decl, expr->right);
         ok &= left.first;
         ok &= right.first;
@@ -207,7 +648,19 @@ std::pair<bool, Expression*> check_constants(FileDB& file_db, SymbolCache& symbo
           auto casting = cast_to_binexp_operands(left.second, right.second);
           ok &= casting.first;
           auto operands = casting.second;
-          if (ok) {
+          if (ok && (expr->operator_ == LROT_OP || expr->operator_ == RROT_OP) && !is_shift_amount_in_range(operands.second, compute_constant_bit_width(symbol_cache, type_cache, decl, expr))) {
+            throw_expression_is_used_in_constant_context_but_is_not_constant(file_db, file_db.expression_point(expr), decl);
+            ok = false;
+            result = Expression::Clone(expr);
+            Expression::Delete(operands.first);
+            Expression::Delete(operands.second);
+          } else if (ok && (expr->operator_ == DIV_OP || expr->operator_ == MOD_OP) && !is_integer_division_defined(operands.first, operands.second)) {
+            throw_expression_is_used_in_constant_context_but_is_not_constant(file_db, file_db.expression_point(expr), decl);
+            ok = false;
+            result = Expression::Clone(expr);
+            Expression::Delete(operands.first);
+            Expression::Delete(operands.second);
+          } else if (ok) {
             switch (expr->operator_) {
               case XOR_OP:
                 {
@@ -229,7 +682,7 @@ std::pair<bool, Expression*> check_constants(FileDB& file_db, SymbolCache& symbo
                   if (operands.first->kind == expression_t::DOUBLE_EXPR) {
                     result->decimal_literal = operands.first->decimal_literal * operands.second->decimal_literal;
                   } else if (operands.first->kind == expression_t::INTEGER_EXPR) {
-                    result->integer_literal = operands.first->integer_literal * operands.second->integer_literal;
+                    ok &= fold_integer_arithmetic(file_db, type_cache, decl, expr, operands.first->integer_literal, operands.second->integer_literal, result->integer_literal);
                   } else if (operands.first->kind == expression_t::BOOLEAN_EXPR) {
                     result->boolean_literal = operands.first->boolean_literal & operands.second->boolean_literal;
                   } else {
@@ -255,7 +708,7 @@ std::pair<bool, Expression*> check_constants(FileDB& file_db, SymbolCache& symbo
                 {
                   result = Expression::Clone(operands.first);
                   if (operands.first->kind == expression_t::DOUBLE_EXPR) {
-                    result->decimal_literal = (intmax_t)(operands.first->decimal_literal) % ((intmax_t)operands.second->decimal_literal);
+                    result->decimal_literal = std::fmod(operands.first->decimal_literal, operands.second->decimal_literal);
                   } else if (operands.first->kind == expression_t::INTEGER_EXPR) {
                     result->integer_literal = operands.first->integer_literal % operands.second->integer_literal;
                   } else if (operands.first->kind == expression_t::BOOLEAN_EXPR) {
@@ -271,7 +724,7 @@ std::pair<bool, Expression*> check_constants(FileDB& file_db, SymbolCache& symbo
                   if (operands.first->kind == expression_t::DOUBLE_EXPR) {
                     result->decimal_literal = operands.first->decimal_literal + operands.second->decimal_literal;
                   } else if (operands.first->kind == expression_t::INTEGER_EXPR) {
-                    result->integer_literal = operands.first->integer_literal + operands.second->integer_literal;
+                    ok &= fold_integer_arithmetic(file_db, type_cache, decl, expr, operands.first->integer_literal, operands.second->integer_literal, result->integer_literal);
                   } else if (operands.first->kind == expression_t::BOOLEAN_EXPR) {
                     result->boolean_literal = operands.first->boolean_literal + operands.second->boolean_literal;
                   } else {
@@ -285,7 +738,7 @@ std::pair<bool, Expression*> check_constants(FileDB& file_db, SymbolCache& symbo
                   if (operands.first->kind == expression_t::DOUBLE_EXPR) {
                     result->decimal_literal = operands.first->decimal_literal - operands.second->decimal_literal;
                   } else if (operands.first->kind == expression_t::INTEGER_EXPR) {
-                    result->integer_literal = operands.first->integer_literal - operands.second->integer_literal;
+                    ok &= fold_integer_arithmetic(file_db, type_cache, decl, expr, operands.first->integer_literal, operands.second->integer_literal, result->integer_literal);
                   } else if (operands.first->kind == expression_t::BOOLEAN_EXPR) {
                     result->boolean_literal = operands.first->boolean_literal - operands.second->boolean_literal;
                   } else {
@@ -463,7 +916,7 @@ std::pair<bool, Expression*> check_constants(FileDB& file_db, SymbolCache& symbo
                 }
               default:
                 {
-                  throw_expression_is_used_in_constant_context_but_is_not_constant(file_db, file_db.expression_points[expr], decl);
+                  throw_expression_is_used_in_constant_context_but_is_not_constant(file_db, file_db.expression_point(expr), decl);
                   ok = false;
                   result = Expression::Clone(expr);
                 }
@@ -471,7 +924,7 @@ std::pair<bool, Expression*> check_constants(FileDB& file_db, SymbolCache& symbo
             Expression::Delete(operands.first);
             Expression::Delete(operands.second);
           } else {
-            throw_was_not_able_to_deduce_binexp_types(file_db, file_db.expression_points[expr], decl, expr->left, expr->right);
+            throw_was_not_able_to_deduce_binexp_types(file_db, file_db.expression_point(expr), decl, expr->left, expr->right);
           }
         } else {
           result = Expression::Clone(expr);
@@ -537,14 +990,14 @@ std::pair<bool, Expression*> check_constants(FileDB& file_db, SymbolCache& symbo
                 }
               default:
                 {
-                  throw_expression_is_used_in_constant_context_but_is_not_constant(file_db, file_db.expression_points[expr], decl);
+                  throw_expression_is_used_in_constant_context_but_is_not_constant(file_db, file_db.expression_point(expr), decl);
                   ok = false;
                   result = Expression::Clone(expr);
                 }
             }
             Expression::Delete(operand);
           } else {
-            throw_was_not_able_to_deduce_monexp_types(file_db, file_db.expression_points[expr], decl, value.second);
+            throw_was_not_able_to_deduce_monexp_types(file_db, file_db.expression_point(expr), decl, value.second);
           }
         } else {
           result = Expression::Clone(expr);
@@ -555,12 +1008,21 @@ std::pair<bool, Expression*> check_constants(FileDB& file_db, SymbolCache& symbo
       {
         auto checked = check_constants(file_db, symbol_cache, size_cache, type_cache, constant_cache, decl, expr->value);
         ok &= checked.first;
-        if (ok) {
+        Type* casted_type = resolve_constant_type(symbol_cache, decl, expr->type);
+        bool is_scalar = casted_type->kind == type_t::INTEGER_TYPE || casted_type->kind == type_t::DOUBLE_TYPE || casted_type->kind == type_t::BOOLEAN_TYPE;
+        if (ok && is_scalar && !constant_converts_to_type(symbol_cache, decl, checked.second, expr->type)) {
+          throw_float_does_not_fit_integer_in_constant_expression(file_db, file_db.expression_point(expr), decl);
+          ok = false;
+          result = Expression::Clone(expr);
+        } else if (ok && is_scalar) {
+          result = cast_constant_to_type(symbol_cache, decl, checked.second, expr->type);
+        } else if (ok) {
           // to trigger not implemented
           result = nullptr;
         } else {
           result = Expression::Clone(expr);
         }
+        Expression::Delete(checked.second);
         break;
       }
     case BITCAST_EXPR:
@@ -575,16 +1037,404 @@ std::pair<bool, Expression*> check_constants(FileDB& file_db, SymbolCache& symbo
         }
         break;
       }
+    case AGGREGATE_LITERAL_EXPR:
+      {
+        // constant when each of its elements is
+        result = Expression::New(AGGREGATE_LITERAL_EXPR);
+        result->type = Type::Clone(expr->type);
+        for (Expression* element : expr->arguments) {
+          auto checked = check_constants(file_db, symbol_cache, size_cache, type_cache, constant_cache, decl, element);
+          ok &= checked.first;
+          result->arguments.push_back(checked.second);
+        }
+        break;
+      }
   }
   if (result == nullptr) {
-    throw_constant_expression_is_not_implemented(file_db, file_db.expression_points[expr], decl);
+    throw_constant_expression_is_not_implemented(file_db, file_db.expression_point(expr), decl);
     result = Expression::Clone(expr);
     ok = false;
   }
   assert(result != nullptr);
+  if (ok)
+    round_constant_to_type(symbol_cache, type_cache, decl, expr, result);
+  return {ok, result};
+}
+
+bool consume_evaluation_step(FileDB& file_db, ConstantCache& constant_cache, Declaration* function, Expression* at) {
+  if (++constant_cache.evaluation_steps <= API::CONSTANT_EVALUATION_STEP_LIMIT) {
+    return true;
+  }
+  throw_constant_evaluation_exceeded_its_budget(file_db, file_db.expression_point(at), function);
+  return false;
+}
+
+// false when the condition cannot be folded
+bool evaluate_constant_condition(FileDB& file_db, SymbolCache& symbol_cache, SizeCache& size_cache, TypeCache& type_cache, ConstantCache& constant_cache, Declaration* function, Expression* condition, bool& truth) {
+  auto checked = check_constants(file_db, symbol_cache, size_cache, type_cache, constant_cache, function, condition);
+  bool ok = checked.first;
+  if (ok) {
+    switch (checked.second->kind) {
+      case BOOLEAN_EXPR:
+        truth = checked.second->boolean_literal;
+        break;
+      case INTEGER_EXPR:
+      case CHARACTER_EXPR:
+        truth = checked.second->integer_literal != 0;
+        break;
+      case DOUBLE_EXPR:
+        truth = checked.second->decimal_literal != 0;
+        break;
+      case NULLPTR_EXPR:
+        truth = false;
+        break;
+      default:
+        throw_expression_is_used_in_constant_context_but_is_not_constant(file_db, file_db.expression_point(condition), function);
+        ok = false;
+    }
+  }
+  Expression::Delete(checked.second);
+  return ok;
+}
+
+evaluation_flow_t execute_constant_statement(FileDB& file_db, SymbolCache& symbol_cache, SizeCache& size_cache, TypeCache& type_cache, ConstantCache& constant_cache, Declaration* function, Statement* stmt) {
+  switch (stmt->kind) {
+    case statement_t::LET_STMT:
+      {
+        Expression* value = nullptr;
+        if (stmt->expr != nullptr) {
+          auto checked = check_constants(file_db, symbol_cache, size_cache, type_cache, constant_cache, function, stmt->expr);
+          if (checked.first && !constant_converts_to_type(symbol_cache, function, checked.second, stmt->type)) {
+            throw_float_does_not_fit_integer_in_constant_expression(file_db, file_db.expression_point(stmt->expr), function);
+            checked.first = false;
+          }
+          if (!checked.first) {
+            Expression::Delete(checked.second);
+            return FLOW_FAILED;
+          }
+          value = cast_constant_to_type(symbol_cache, function, checked.second, stmt->type);
+          Expression::Delete(checked.second);
+        } else {
+          value = make_zero_constant(symbol_cache, function, stmt->type);
+        }
+        // a let inside of a loop is executed more than once
+        Expression*& slot = constant_cache.frames.back().variables[stmt];
+        Expression::Delete(slot);
+        slot = value;
+        return FLOW_NORMAL;
+      }
+    case statement_t::BLOCK_STMT:
+      {
+        for (Statement* child : stmt->children) {
+          evaluation_flow_t flow = execute_constant_statement(file_db, symbol_cache, size_cache, type_cache, constant_cache, function, child);
+          if (flow != FLOW_NORMAL)
+            return flow;
+        }
+        return FLOW_NORMAL;
+      }
+    case statement_t::EXPRESSION_STMT:
+      {
+        auto checked = check_constants(file_db, symbol_cache, size_cache, type_cache, constant_cache, function, stmt->expr);
+        Expression::Delete(checked.second);
+        return checked.first ? FLOW_NORMAL : FLOW_FAILED;
+      }
+    case statement_t::IF_ELSE_STMT:
+      {
+        bool truth = false;
+        if (!evaluate_constant_condition(file_db, symbol_cache, size_cache, type_cache, constant_cache, function, stmt->condition, truth))
+          return FLOW_FAILED;
+        if (truth)
+          return execute_constant_statement(file_db, symbol_cache, size_cache, type_cache, constant_cache, function, stmt->then);
+        if (stmt->else_ != nullptr)
+          return execute_constant_statement(file_db, symbol_cache, size_cache, type_cache, constant_cache, function, stmt->else_);
+        return FLOW_NORMAL;
+      }
+    case statement_t::WHILE_STMT:
+      {
+        while (true) {
+          bool truth = false;
+          if (!evaluate_constant_condition(file_db, symbol_cache, size_cache, type_cache, constant_cache, function, stmt->condition, truth))
+            return FLOW_FAILED;
+          if (!truth)
+            return FLOW_NORMAL;
+          if (!consume_evaluation_step(file_db, constant_cache, function, stmt->condition))
+            return FLOW_FAILED;
+          evaluation_flow_t flow = execute_constant_statement(file_db, symbol_cache, size_cache, type_cache, constant_cache, function, stmt->body);
+          if (flow == FLOW_FAILED || flow == FLOW_RETURN)
+            return flow;
+          if (flow == FLOW_BREAK)
+            return FLOW_NORMAL;
+        }
+      }
+    case statement_t::FOR_STMT:
+      {
+        evaluation_flow_t flow = execute_constant_statement(file_db, symbol_cache, size_cache, type_cache, constant_cache, function, stmt->init);
+        if (flow != FLOW_NORMAL)
+          return flow;
+        while (true) {
+          bool truth = false;
+          if (!evaluate_constant_condition(file_db, symbol_cache, size_cache, type_cache, constant_cache, function, stmt->condition, truth))
+            return FLOW_FAILED;
+          if (!truth)
+            return FLOW_NORMAL;
+          if (!consume_evaluation_step(file_db, constant_cache, function, stmt->condition))
+            return FLOW_FAILED;
+          flow = execute_constant_statement(file_db, symbol_cache, size_cache, type_cache, constant_cache, function, stmt->body);
+          if (flow == FLOW_FAILED || flow == FLOW_RETURN)
+            return flow;
+          if (flow == FLOW_BREAK)
+            return FLOW_NORMAL;
+          auto step = check_constants(file_db, symbol_cache, size_cache, type_cache, constant_cache, function, stmt->step);
+          Expression::Delete(step.second);
+          if (!step.first)
+            return FLOW_FAILED;
+        }
+      }
+    case statement_t::BREAK_STMT:
+      return FLOW_BREAK;
+    case statement_t::CONTINUE_STMT:
+      return FLOW_CONTINUE;
+    case statement_t::RETURN_STMT:
+      {
+        if (stmt->expr != nullptr) {
+          auto checked = check_constants(file_db, symbol_cache, size_cache, type_cache, constant_cache, function, stmt->expr);
+          if (!checked.first) {
+            Expression::Delete(checked.second);
+            return FLOW_FAILED;
+          }
+          constant_cache.frames.back().return_value = checked.second;
+        }
+        return FLOW_RETURN;
+      }
+  }
+  assert(false);
+  return FLOW_FAILED;
+}
+
+std::pair<bool, Expression*> evaluate_function_call(FileDB& file_db, SymbolCache& symbol_cache, SizeCache& size_cache, TypeCache& type_cache, ConstantCache& constant_cache, Expression* call, Declaration* function, std::vector<Expression*>& arguments) {
+  if (constant_cache.frames.empty()) {
+    constant_cache.evaluation_steps = 0;
+  }
+  if (constant_cache.frames.size() >= API::CONSTANT_EVALUATION_DEPTH_LIMIT || !consume_evaluation_step(file_db, constant_cache, function, call)) {
+    if (constant_cache.frames.size() >= API::CONSTANT_EVALUATION_DEPTH_LIMIT)
+      throw_constant_evaluation_exceeded_its_budget(file_db, file_db.expression_point(call), function);
+    return {false, Expression::Clone(call)};
+  }
+
+  ConstantFrame frame = {
+    .function = function,
+    .variables = {},
+    .parameters = {},
+    .return_value = nullptr
+  };
+  for (std::uintmax_t index = 0; index < function->parameters.size() && index < arguments.size(); ++index) {
+    std::pair<std::string, Type*>* param = function->parameters.data() + index;
+    if (!constant_converts_to_type(symbol_cache, function, arguments[index], param->second)) {
+      throw_float_does_not_fit_integer_in_constant_expression(file_db, file_db.expression_point(call->arguments[index]), function);
+      for (auto& item : frame.parameters) {
+        Expression::Delete(item.second);
+      }
+      return {false, Expression::Clone(call)};
+    }
+    frame.parameters[param] = cast_constant_to_type(symbol_cache, function, arguments[index], param->second);
+  }
+  constant_cache.frames.push_back(std::move(frame));
+  evaluation_flow_t flow = execute_constant_statement(file_db, symbol_cache, size_cache, type_cache, constant_cache, function, function->body);
+  frame = std::move(constant_cache.frames.back());
+  constant_cache.frames.pop_back();
+
+  for (auto& item : frame.variables) {
+    Expression::Delete(item.second);
+  }
+  for (auto& item : frame.parameters) {
+    Expression::Delete(item.second);
+  }
+
+  Type* return_type = resolve_constant_type(symbol_cache, function, function->type);
+  bool ok = flow != FLOW_FAILED;
+  if (ok && frame.return_value == nullptr && return_type->kind != type_t::VOID_TYPE) {
+    // fell off the end of a non-void function
+    throw_expression_is_used_in_constant_context_but_is_not_constant(file_db, file_db.expression_point(call), function);
+    ok = false;
+  }
+  if (ok && frame.return_value != nullptr && !constant_converts_to_type(symbol_cache, function, frame.return_value, function->type)) {
+    throw_float_does_not_fit_integer_in_constant_expression(file_db, file_db.expression_point(call), function);
+    ok = false;
+  }
+  Expression* result = nullptr;
+  if (!ok) {
+    result = Expression::Clone(call);
+  } else if (frame.return_value == nullptr) {
+    result = make_zero_constant(symbol_cache, function, function->type);
+  } else {
+    result = cast_constant_to_type(symbol_cache, function, frame.return_value, function->type);
+  }
+  Expression::Delete(frame.return_value);
   return {ok, result};
 }
 
+bool is_scalar_constant_type(SymbolCache& symbol_cache, Declaration* decl, Type* type) {
+  type = resolve_constant_type(symbol_cache, decl, type);
+  return type != nullptr && (type->kind == type_t::INTEGER_TYPE || type->kind == type_t::DOUBLE_TYPE || type->kind == type_t::BOOLEAN_TYPE);
+}
+
+// whether an expression of a function body folds without side effects nor diagnostics
+// the operands were decided before expr, so only the node itself is inspected
+bool is_foldable_node(SymbolCache& symbol_cache, TypeCache& type_cache, Declaration* function, Expression* expr) {
+  auto it = type_cache.expression_types.find(expr);
+  if (it == type_cache.expression_types.end() || !is_scalar_constant_type(symbol_cache, function, it->second)) {
+    return false;
+  }
+  switch (expr->kind) {
+    case INTEGER_EXPR:
+    case DOUBLE_EXPR:
+    case BOOLEAN_EXPR:
+    case CHARACTER_EXPR:
+    case SIZEOF_EXPR:
+      return true;
+    case SYMBOL_EXPR:
+      {
+        if (symbol_cache.get_statement(expr) != nullptr || symbol_cache.get_parameter(expr) != nullptr) {
+          return false;
+        }
+        // only const statics keep their initial value at runtime
+        Declaration* reference = symbol_cache.get_declaration(function, expr->symbol);
+        return reference != nullptr && reference->kind == declaration_t::STATIC_VARIABLE_DECL && reference->is_const
+            && reference->value != nullptr && reference->modifier != MODIFIER_EXTERN;
+      }
+    case MONARY_EXPR:
+      {
+        switch (expr->operator_) {
+          case ADD_OP:
+          case SUB_OP:
+          case NOT_OP:
+          case TILDE_OP:
+            return type_cache.foldable.contains(expr->value);
+          default:
+            return false;
+        }
+      }
+    case BINARY_EXPR:
+      {
+        bool is_integer = resolve_constant_type(symbol_cache, function, it->second)->kind == type_t::INTEGER_TYPE;
+        switch (expr->operator_) {
+          case DOT_OP:
+          case ARR_OP:
+          case ASS_OP:
+          case INC_OP:
+          case DEC_OP:
+          case TILDE_OP:
+          case NOT_OP:
+            return false;
+          case ADD_OP:
+          case SUB_OP:
+          case MUL_OP:
+            // an overflow would be reported, while at runtime it may never be reached
+            if (is_integer && API::OVERFLOW_MODE != API::WRAP_OVERFLOW)
+              return false;
+            break;
+          case DIV_OP:
+            // codegen emits udiv, only fdiv folds with the same semantics
+            if (resolve_constant_type(symbol_cache, function, it->second)->kind != type_t::DOUBLE_TYPE)
+              return false;
+            break;
+          case MOD_OP:
+          case RROT_OP:
+            // codegen emits urem, frem and lshr, which are left to runtime
+            return false;
+          case LROT_OP:
+            // out of range amounts are poison at runtime, they are left to it
+            if (!((expr->right->kind == INTEGER_EXPR || expr->right->kind == CHARACTER_EXPR) && is_shift_amount_in_range(expr->right, compute_constant_bit_width(symbol_cache, type_cache, function, expr))))
+              return false;
+            break;
+          default:
+            break;
+        }
+        return type_cache.foldable.contains(expr->left) && type_cache.foldable.contains(expr->right);
+      }
+    case CAST_EXPR:
+      return type_cache.foldable.contains(expr->value);
+    default:
+      return false;
+  }
+}
+
+void mark_foldable_in_body(SymbolCache& symbol_cache, TypeCache& type_cache, Declaration* function, Expression* expr) {
+  if (is_foldable_node(symbol_cache, type_cache, function, expr)) {
+    type_cache.foldable.insert(expr);
+  }
+}
+
+// outermost foldable subtrees are folded, the walk goes on below the others from an explicit stack
+void fold_expression_in_body(FileDB& file_db, SymbolCache& symbol_cache, SizeCache& size_cache, TypeCache& type_cache, ConstantCache& constant_cache, Declaration* function, Expression* root) {
+  std::vector<Expression*> stack;
+  if (root != nullptr)
+    stack.push_back(root);
+  while (!stack.empty()) {
+    Expression* expr = stack.back();
+    stack.pop_back();
+    switch (expr->kind) {
+      case INTEGER_EXPR:
+      case DOUBLE_EXPR:
+      case BOOLEAN_EXPR:
+      case NULLPTR_EXPR:
+      case CHARACTER_EXPR:
+      case STRING_EXPR:
+      case SIZEOF_EXPR:
+        // already literals
+        continue;
+      default:
+        break;
+    }
+    if (type_cache.foldable.contains(expr)) {
+      auto checked = check_constants(file_db, symbol_cache, size_cache, type_cache, constant_cache, function, expr);
+      bool is_literal = checked.second->kind == INTEGER_EXPR || checked.second->kind == DOUBLE_EXPR || checked.second->kind == BOOLEAN_EXPR || checked.second->kind == CHARACTER_EXPR;
+      // inf and nan are left to be computed at runtime
+      bool is_finite = checked.second->kind != DOUBLE_EXPR || std::isfinite(checked.second->decimal_literal);
+      // so are floats that do not fit the integer they are converted to
+      bool converts = checked.first && constant_converts_to_type(symbol_cache, function, checked.second, type_cache.expression_types[expr]);
+      if (checked.first && is_literal && is_finite && converts) {
+        constant_cache.folded[expr] = cast_constant_to_type(symbol_cache, function, checked.second, type_cache.expression_types[expr]);
+      }
+      Expression::Delete(checked.second);
+      continue;
+    }
+    if (expr->kind == MONARY_EXPR && expr->operator_ == AND_OP) {
+      // the operand is a place
+      continue;
+    }
+    if (expr->value != nullptr)
+      stack.push_back(expr->value);
+    // the right of a field access is the name of the field
+    if (expr->right != nullptr && (expr->kind != BINARY_EXPR || expr->operator_ != DOT_OP))
+      stack.push_back(expr->right);
+    if (expr->left != nullptr)
+      stack.push_back(expr->left);
+    for (auto it = expr->arguments.rbegin(); it != expr->arguments.rend(); ++it) {
+      if (*it != nullptr)
+        stack.push_back(*it);
+    }
+    if (expr->callable != nullptr)
+      stack.push_back(expr->callable);
+  }
+}
+
+void fold_statement_in_body(FileDB& file_db, SymbolCache& symbol_cache, SizeCache& size_cache, TypeCache& type_cache, ConstantCache& constant_cache, Declaration* function, Statement* stmt) {
+  if (stmt == nullptr) {
+    return;
+  }
+  fold_expression_in_body(file_db, symbol_cache, size_cache, type_cache, constant_cache, function, stmt->expr);
+  fold_expression_in_body(file_db, symbol_cache, size_cache, type_cache, constant_cache, function, stmt->condition);
+  fold_expression_in_body(file_db, symbol_cache, size_cache, type_cache, constant_cache, function, stmt->step);
+  fold_statement_in_body(file_db, symbol_cache, size_cache, type_cache, constant_cache, function, stmt->init);
+  fold_statement_in_body(file_db, symbol_cache, size_cache, type_cache, constant_cache, function, stmt->then);
+  fold_statement_in_body(file_db, symbol_cache, size_cache, type_cache, constant_cache, function, stmt->else_);
+  fold_statement_in_body(file_db, symbol_cache, size_cache, type_cache, constant_cache, function, stmt->body);
+  for (Statement* child : stmt->children) {
+    fold_statement_in_body(file_db, symbol_cache, size_cache, type_cache, constant_cache, function, child);
+  }
+}
+
 bool check_constants(FileDB& file_db, SymbolCache& symbol_cache, SizeCache& size_cache, TypeCache& type_cache, ConstantCache& constant_cache, Declaration* decl) {
   bool declared_types_ok = true;
   switch (decl->kind) {
@@ -598,6 +1448,10 @@ bool check_constants(FileDB& file_db, SymbolCache& symbol_cache, SizeCache& size
         constant_cache.staging[decl] = true;
         if (decl->value != nullptr) {
           auto checked = check_constants(file_db, symbol_cache, size_cache, type_cache, constant_cache, decl, decl->value);
+          if (checked.first && !constant_converts_to_slots(symbol_cache, decl, checked.second, decl->type)) {
+            throw_float_does_not_fit_integer_in_constant_expression(file_db, file_db.expression_point(decl->value), decl);
+            checked.first = false;
+          }
           constant_cache.constants[decl] = checked.second;
           declared_types_ok &= checked.first;
         }
@@ -605,9 +1459,16 @@ bool check_constants(FileDB& file_db, SymbolCache& symbol_cache, SizeCache& size
       }
       break;
     case declaration_t::FUNCTION_DECL:
+      // bodies are folded as they flow through the pipeline
+      if (!API::STREAM_FUNCTIONS)
+        fold_statement_in_body(file_db, symbol_cache, size_cache, type_cache, constant_cache, decl, decl->body);
       break;
     case declaration_t::TYPE_DECL:
       break;
   }
   return declared_types_ok;
 }
+
+void fold_function_constants(FileDB& file_db, SymbolCache& symbol_cache, SizeCache& size_cache, TypeCache& type_cache, ConstantCache& constant_cache, Declaration* function) {
+  fold_statement_in_body(file_db, symbol_cache, size_cache, type_cache, constant_cache, function, function->body);
+}
@@ -14,4 +14,8 @@ void ConstantCache::Delete(ConstantCache& constant_cache) {
     Expression::Delete(item.second);
   }
   constant_cache.constants = {};
+  for (auto item : constant_cache.folded) {
+    Expression::Delete(item.second);
+  }
+  constant_cache.folded = {};
 }
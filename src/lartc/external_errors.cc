@@ -1,8 +1,19 @@
 #include <cstdlib>
 #include <lartc/external_errors.hh>
+#include <lartc/api/config.hh>
 #include <iostream>
 
-#define CERR std::cerr
+#define CERR diagnostic_stream()
+
+thread_local std::ostream* diagnostic_output = nullptr;
+
+std::ostream& diagnostic_stream() {
+  return diagnostic_output != nullptr ? *diagnostic_output : std::cerr;
+}
+
+void redirect_diagnostics(std::ostream* stream) {
+  diagnostic_output = stream;
+}
 
 inline std::uintmax_t find_next_newline(const char* source_code, std::uintmax_t byte_start) {
   while(source_code[byte_start] != '\0' && source_code[byte_start] != '\n')
@@ -19,6 +30,11 @@ std::ostream& print_line_of_source_code_point(const char* source_code, Point& po
   return CERR << std::string(point.column, ' ') << "^" << std::endl;
 }
 
+std::ostream& print_line_of_source_code_point(const FileDB& file_db, const FileDB::Point& point) {
+  FileDB::Location location = file_db.locate(point);
+  return print_line_of_source_code_point(file_db.files[location.file].source_code, location, location.byte_start);
+}
+
 // Cst Checking
 void throw_syntax_error(const char* filepath, TSPoint& point, const char* node_symbol_name, const char* source_code, std::uintmax_t byte_start) {
   CERR << filepath << ":" << point.row+1 << ":" << point.column+1 << ": " << RED_TEXT << "syntax error" << NORMAL_TEXT << ": unexpected token inside of " << node_symbol_name << std::endl;
@@ -34,87 +50,110 @@ void throw_extern_static_variables_cannot_have_a_defined_value(const char* filep
   print_line_of_source_code_point(source_code, point, byte_start);
   std::exit(1);
 }
+void throw_unknown_function_attribute(const char* filepath, TSPoint& point, const std::string& name, const char* source_code, std::uintmax_t byte_start) {
+  CERR << filepath << ":" << point.row+1 << ":" << point.column+1 << ": " << RED_TEXT << "parsing error" << NORMAL_TEXT << ": unknown function attribute '" << name << "'" << std::endl;
+  print_line_of_source_code_point(source_code, point, byte_start);
+}
+void throw_conflicting_function_attributes(const char* filepath, TSPoint& point, const char* first, const char* second, const char* source_code, std::uintmax_t byte_start) {
+  CERR << filepath << ":" << point.row+1 << ":" << point.column+1 << ": " << RED_TEXT << "parsing error" << NORMAL_TEXT << ": function attributes '" << first << "' and '" << second << "' cannot be used together" << std::endl;
+  print_line_of_source_code_point(source_code, point, byte_start);
+}
+void throw_vector_should_have_at_least_one_lane(const char* filepath, TSPoint& point, const char* source_code, std::uintmax_t byte_start) {
+  CERR << filepath << ":" << point.row+1 << ":" << point.column+1 << ": " << RED_TEXT << "parsing error" << NORMAL_TEXT << ": a vector should have at least one lane" << std::endl;
+  print_line_of_source_code_point(source_code, point, byte_start);
+  std::exit(1);
+}
 
 // Duplicate Declaration/Definitions
-void throw_duplicate_declaration_matches_name_but_not_kind(FileDB& file_db, FileDB::Point& older_point, FileDB::Point& latest_point) {
+void throw_duplicate_declaration_matches_name_but_not_kind(FileDB& file_db, const FileDB::Point& older_point, const FileDB::Point& latest_point) {
   FileDB::Point::Print(CERR, file_db, latest_point);
   CERR << ": " << RED_TEXT << "duplicate declaration error" << NORMAL_TEXT << ": matches name but not kind" << std::endl;
-  print_line_of_source_code_point(file_db.files[latest_point.file].source_code, latest_point, latest_point.byte_start);
+  print_line_of_source_code_point(file_db, latest_point);
 
   FileDB::Point::Print(CERR, file_db, older_point);
   CERR << ": " << AZURE_TEXT << "reference" << NORMAL_TEXT << ": already declared here" << std::endl;
-  print_line_of_source_code_point(file_db.files[older_point.file].source_code, older_point, older_point.byte_start);
+  print_line_of_source_code_point(file_db, older_point);
 }
 
-void throw_duplicate_type_definition_doesnt_match(FileDB& file_db, FileDB::Point& older_point, FileDB::Point& latest_point) {
+void throw_duplicate_type_definition_doesnt_match(FileDB& file_db, const FileDB::Point& older_point, const FileDB::Point& latest_point) {
   FileDB::Point::Print(CERR, file_db, latest_point);
   CERR << ": " << RED_TEXT << "duplicate definition error" << NORMAL_TEXT << ": defined type doesn't match" << std::endl;
-  print_line_of_source_code_point(file_db.files[latest_point.file].source_code, latest_point, latest_point.byte_start);
+  print_line_of_source_code_point(file_db, latest_point);
 
   FileDB::Point::Print(CERR, file_db, older_point);
   CERR << ": " << AZURE_TEXT << "reference" << NORMAL_TEXT << ": already defined here" << std::endl;
-  print_line_of_source_code_point(file_db.files[older_point.file].source_code, older_point, older_point.byte_start);
+  print_line_of_source_code_point(file_db, older_point);
 }
 
-void throw_duplicate_static_variable_definition(FileDB& file_db, FileDB::Point& older_point, FileDB::Point& latest_point) {
+void throw_duplicate_static_variable_definition(FileDB& file_db, const FileDB::Point& older_point, const FileDB::Point& latest_point) {
   FileDB::Point::Print(CERR, file_db, latest_point);
   CERR << ": " << RED_TEXT << "duplicate definition error" << NORMAL_TEXT << ": duplicate static-variable definition" << std::endl;
-  print_line_of_source_code_point(file_db.files[latest_point.file].source_code, latest_point, latest_point.byte_start);
+  print_line_of_source_code_point(file_db, latest_point);
 
   FileDB::Point::Print(CERR, file_db, older_point);
   CERR << ": " << AZURE_TEXT << "reference" << NORMAL_TEXT << ": already defined here" << std::endl;
-  print_line_of_source_code_point(file_db.files[older_point.file].source_code, older_point, older_point.byte_start);
+  print_line_of_source_code_point(file_db, older_point);
 }
 
-void throw_duplicate_function_definition(FileDB& file_db, FileDB::Point& older_point, FileDB::Point& latest_point) {
+void throw_duplicate_function_definition(FileDB& file_db, const FileDB::Point& older_point, const FileDB::Point& latest_point) {
   FileDB::Point::Print(CERR, file_db, latest_point);
   CERR << ": " << RED_TEXT << "duplicate definition error" << NORMAL_TEXT << ": duplicate function definition" << std::endl;
-  print_line_of_source_code_point(file_db.files[latest_point.file].source_code, latest_point, latest_point.byte_start);
+  print_line_of_source_code_point(file_db, latest_point);
 
   FileDB::Point::Print(CERR, file_db, older_point);
   CERR << ": " << AZURE_TEXT << "reference" << NORMAL_TEXT << ": already defined here" << std::endl;
-  print_line_of_source_code_point(file_db.files[older_point.file].source_code, older_point, older_point.byte_start);
+  print_line_of_source_code_point(file_db, older_point);
 }
 
-void throw_duplicate_function_declaration_return_type_doesnt_match(FileDB& file_db, FileDB::Point& older_point, FileDB::Point& latest_point) {
+void throw_duplicate_function_declaration_return_type_doesnt_match(FileDB& file_db, const FileDB::Point& older_point, const FileDB::Point& latest_point) {
   FileDB::Point::Print(CERR, file_db, latest_point);
   CERR << ": " << RED_TEXT << "duplicate declaration error" << NORMAL_TEXT << ": return type doesn't match previous declaration" << std::endl;
-  print_line_of_source_code_point(file_db.files[latest_point.file].source_code, latest_point, latest_point.byte_start);
+  print_line_of_source_code_point(file_db, latest_point);
 
   FileDB::Point::Print(CERR, file_db, older_point);
   CERR << ": " << AZURE_TEXT << "reference" << NORMAL_TEXT << ": already declared here" << std::endl;
-  print_line_of_source_code_point(file_db.files[older_point.file].source_code, older_point, older_point.byte_start);
+  print_line_of_source_code_point(file_db, older_point);
 }
 
-void throw_duplicate_function_declaration_parameter_types_dont_match(FileDB& file_db, FileDB::Point& older_point, FileDB::Point& latest_point) {
+void throw_duplicate_function_declaration_parameter_types_dont_match(FileDB& file_db, const FileDB::Point& older_point, const FileDB::Point& latest_point) {
   FileDB::Point::Print(CERR, file_db, latest_point);
   CERR << ": " << RED_TEXT << "duplicate declaration error" << NORMAL_TEXT << ": parameter types don't match previous declaration" << std::endl;
-  print_line_of_source_code_point(file_db.files[latest_point.file].source_code, latest_point, latest_point.byte_start);
+  print_line_of_source_code_point(file_db, latest_point);
 
   FileDB::Point::Print(CERR, file_db, older_point);
   CERR << ": " << AZURE_TEXT << "reference" << NORMAL_TEXT << ": already declared here" << std::endl;
-  print_line_of_source_code_point(file_db.files[older_point.file].source_code, older_point, older_point.byte_start);
+  print_line_of_source_code_point(file_db, older_point);
 }
 
-void throw_duplicate_function_declaration_wrong_parameter_number(FileDB& file_db, FileDB::Point& older_point, FileDB::Point& latest_point) {
+void throw_duplicate_function_declaration_wrong_parameter_number(FileDB& file_db, const FileDB::Point& older_point, const FileDB::Point& latest_point) {
   FileDB::Point::Print(CERR, file_db, latest_point);
   CERR << ": " << RED_TEXT << "duplicate declaration error" << NORMAL_TEXT << ": parameter number doesn't match previous declaration" << std::endl;
-  print_line_of_source_code_point(file_db.files[latest_point.file].source_code, latest_point, latest_point.byte_start);
+  print_line_of_source_code_point(file_db, latest_point);
 
   FileDB::Point::Print(CERR, file_db, older_point);
   CERR << ": " << AZURE_TEXT << "reference" << NORMAL_TEXT << ": already declared here" << std::endl;
-  print_line_of_source_code_point(file_db.files[older_point.file].source_code, older_point, older_point.byte_start);
+  print_line_of_source_code_point(file_db, older_point);
+}
+
+void throw_duplicate_function_declaration_attributes_conflict(FileDB& file_db, const FileDB::Point& older_point, const FileDB::Point& latest_point, const char* first, const char* second) {
+  FileDB::Point::Print(CERR, file_db, latest_point);
+  CERR << ": " << RED_TEXT << "duplicate declaration error" << NORMAL_TEXT << ": function attributes '" << first << "' and '" << second << "' cannot be used together across declarations" << std::endl;
+  print_line_of_source_code_point(file_db, latest_point);
+
+  FileDB::Point::Print(CERR, file_db, older_point);
+  CERR << ": " << AZURE_TEXT << "reference" << NORMAL_TEXT << ": already declared here" << std::endl;
+  print_line_of_source_code_point(file_db, older_point);
 }
 
 // Include Machanism
 void throw_unable_to_resolve_include_filepath(FileDB& file_db, const FileDB::Point& point, const std::string& filepath) {
   FileDB::Point::Print(CERR, file_db, point);
   CERR << ": " << RED_TEXT << "include error" << NORMAL_TEXT << ": unable to find " << filepath << std::endl;
-  print_line_of_source_code_point(file_db.files[point.file].source_code, point, point.byte_start);
+  print_line_of_source_code_point(file_db, point);
 }
 
 // Name Resolution
-void throw_name_resolution_error(FileDB& file_db, FileDB::Point& point, Declaration* context, Symbol& symbol) {
+void throw_name_resolution_error(FileDB& file_db, const FileDB::Point& point, Declaration* context, Symbol& symbol) {
   FileDB::Point::Print(CERR, file_db, point);
   CERR << ": " << RED_TEXT << "syntax error" << NORMAL_TEXT << ": unable to resolve symbol '";
   Symbol::Print(CERR, symbol) << "'" << std::endl;
@@ -122,11 +161,11 @@ void throw_name_resolution_error(FileDB& file_db, FileDB::Point& point, Declarat
   Declaration::PrintShort(CERR, context);
   CERR << "'" << std::endl;
 
-  print_line_of_source_code_point(file_db.files[point.file].source_code, point, point.byte_start);
+  print_line_of_source_code_point(file_db, point);
 }
 
 // Decl Type Checking
-void throw_a_type_definition_cannot_reference_a_non_type_declaration(FileDB& file_db, FileDB::Point& point, Declaration* type_decl, Declaration* non_type_decl) {
+void throw_a_type_definition_cannot_reference_a_non_type_declaration(FileDB& file_db, const FileDB::Point& point, Declaration* type_decl, Declaration* non_type_decl) {
   FileDB::Point::Print(CERR, file_db, point);
   CERR << ": " << RED_TEXT << "type checking error" << NORMAL_TEXT << ": cannot reference non-type declaration '";
   Declaration::PrintShort(CERR, non_type_decl) << "'" << std::endl;
@@ -134,10 +173,10 @@ void throw_a_type_definition_cannot_reference_a_non_type_declaration(FileDB& fil
   Declaration::PrintShort(CERR, type_decl);
   CERR << "'" << std::endl;
 
-  print_line_of_source_code_point(file_db.files[point.file].source_code, point, point.byte_start);
+  print_line_of_source_code_point(file_db, point);
 }
 
-void throw_cyclic_dependency_between_types_is_not_protected_by_usage_of_pointers(FileDB& file_db, FileDB::Point& point, Declaration* type_decl, Declaration* requested_type_decl) {
+void throw_cyclic_dependency_between_types_is_not_protected_by_usage_of_pointers(FileDB& file_db, const FileDB::Point& point, Declaration* type_decl, Declaration* requested_type_decl) {
   FileDB::Point::Print(CERR, file_db, point);
   CERR << ": " << RED_TEXT << "type checking error" << NORMAL_TEXT << ": cyclic dependency with type '";
   Declaration::PrintShort(CERR, requested_type_decl) << "'" << std::endl;
@@ -145,11 +184,22 @@ void throw_cyclic_dependency_between_types_is_not_protected_by_usage_of_pointers
   Declaration::PrintShort(CERR, type_decl);
   CERR << "' is not protected by usage of pointers" << std::endl;
 
-  print_line_of_source_code_point(file_db.files[point.file].source_code, point, point.byte_start);
+  print_line_of_source_code_point(file_db, point);
+}
+
+void throw_vector_element_type_should_be_a_scalar(FileDB& file_db, const FileDB::Point& point, Declaration* type_decl, Type* element_type) {
+  FileDB::Point::Print(CERR, file_db, point);
+  CERR << ": " << RED_TEXT << "type checking error" << NORMAL_TEXT << ": vector element type should be an integer, a double, a bool or a pointer, instead is '";
+  Type::Print(CERR, element_type) << "'" << std::endl;
+  CERR << " inside type declaration '";
+  Declaration::PrintShort(CERR, type_decl);
+  CERR << "'" << std::endl;
+
+  print_line_of_source_code_point(file_db, point);
 }
 
 // Type Checking
-void throw_type_is_not_dereferenceable_error(FileDB& file_db, FileDB::Point& point, Declaration* context, Type* type) {
+void throw_type_is_not_dereferenceable_error(FileDB& file_db, const FileDB::Point& point, Declaration* context, Type* type) {
   FileDB::Point::Print(CERR, file_db, point);
   CERR << ": " << RED_TEXT << "type checking error" << NORMAL_TEXT << ": type is not dereferenceable '";
   Type::Print(CERR, type) << "'" << std::endl;
@@ -157,10 +207,10 @@ void throw_type_is_not_dereferenceable_error(FileDB& file_db, FileDB::Point& poi
   Declaration::PrintShort(CERR, context);
   CERR << "'" << std::endl;
 
-  print_line_of_source_code_point(file_db.files[point.file].source_code, point, point.byte_start);
+  print_line_of_source_code_point(file_db, point);
 }
 
-void throw_module_has_no_type_error(FileDB& file_db, FileDB::Point& point, Declaration* context, Symbol& symbol) {
+void throw_module_has_no_type_error(FileDB& file_db, const FileDB::Point& point, Declaration* context, Symbol& symbol) {
   FileDB::Point::Print(CERR, file_db, point);
   CERR << ": " << RED_TEXT << "type checking error" << NORMAL_TEXT << ": a module has not type '";
   Symbol::Print(CERR, symbol) << "'" << std::endl;
@@ -168,10 +218,10 @@ void throw_module_has_no_type_error(FileDB& file_db, FileDB::Point& point, Decla
   Declaration::PrintShort(CERR, context);
   CERR << "'" << std::endl;
 
-  print_line_of_source_code_point(file_db.files[point.file].source_code, point, point.byte_start);
+  print_line_of_source_code_point(file_db, point);
 }
 
-void throw_type_cannot_be_algebraically_manipulated_error(FileDB& file_db, FileDB::Point& point, Declaration* context, Type* type) {
+void throw_type_cannot_be_algebraically_manipulated_error(FileDB& file_db, const FileDB::Point& point, Declaration* context, Type* type) {
   FileDB::Point::Print(CERR, file_db, point);
   CERR << ": " << RED_TEXT << "type checking error" << NORMAL_TEXT << ": type cannot be algebraically manipulated '";
   Type::Print(CERR, type) << "'" << std::endl;
@@ -179,10 +229,10 @@ void throw_type_cannot_be_algebraically_manipulated_error(FileDB& file_db, FileD
   Declaration::PrintShort(CERR, context);
   CERR << "'" << std::endl;
 
-  print_line_of_source_code_point(file_db.files[point.file].source_code, point, point.byte_start);
+  print_line_of_source_code_point(file_db, point);
 }
 
-void throw_type_is_not_callable_error(FileDB& file_db, FileDB::Point& point, Declaration* context, Type* non_callable_type) {
+void throw_type_is_not_callable_error(FileDB& file_db, const FileDB::Point& point, Declaration* context, Type* non_callable_type) {
   FileDB::Point::Print(CERR, file_db, point);
   CERR << ": " << RED_TEXT << "type checking error" << NORMAL_TEXT << ": called type '";
   Type::Print(CERR, non_callable_type) << "' is not callable" << std::endl;
@@ -190,10 +240,10 @@ void throw_type_is_not_callable_error(FileDB& file_db, FileDB::Point& point, Dec
   Declaration::PrintShort(CERR, context);
   CERR << "'" << std::endl;
 
-  print_line_of_source_code_point(file_db.files[point.file].source_code, point, point.byte_start);
+  print_line_of_source_code_point(file_db, point);
 }
 
-void throw_wrong_parameter_number_error(FileDB& file_db, FileDB::Point& point, Declaration* context, Type* fn_type) {
+void throw_wrong_parameter_number_error(FileDB& file_db, const FileDB::Point& point, Declaration* context, Type* fn_type) {
   FileDB::Point::Print(CERR, file_db, point);
   CERR << ": " << RED_TEXT << "type checking error" << NORMAL_TEXT << ": wrong parameter number for function of type '";
   Type::Print(CERR, fn_type) << "'" << std::endl;
@@ -201,10 +251,10 @@ void throw_wrong_parameter_number_error(FileDB& file_db, FileDB::Point& point, D
   Declaration::PrintShort(CERR, context);
   CERR << "'" << std::endl;
 
-  print_line_of_source_code_point(file_db.files[point.file].source_code, point, point.byte_start);
+  print_line_of_source_code_point(file_db, point);
 }
 
-void throw_type_is_not_implicitly_castable_to(FileDB& file_db, FileDB::Point& point, Declaration* context, Type* src_type, Type* dst_type) {
+void throw_type_is_not_implicitly_castable_to(FileDB& file_db, const FileDB::Point& point, Declaration* context, Type* src_type, Type* dst_type) {
   FileDB::Point::Print(CERR, file_db, point);
   CERR << ": " << RED_TEXT << "type checking error" << NORMAL_TEXT << ": type '";
   Type::Print(CERR, src_type) << "'";
@@ -214,10 +264,10 @@ void throw_type_is_not_implicitly_castable_to(FileDB& file_db, FileDB::Point& po
   Declaration::PrintShort(CERR, context);
   CERR << "'" << std::endl;
 
-  print_line_of_source_code_point(file_db.files[point.file].source_code, point, point.byte_start);
+  print_line_of_source_code_point(file_db, point);
 }
 
-void throw_return_type_is_not_implicitly_castable_to(FileDB& file_db, FileDB::Point& point, Declaration* context, Type* src_type, Type* dst_type) {
+void throw_return_type_is_not_implicitly_castable_to(FileDB& file_db, const FileDB::Point& point, Declaration* context, Type* src_type, Type* dst_type) {
   FileDB::Point::Print(CERR, file_db, point);
   CERR << ": " << RED_TEXT << "type checking error" << NORMAL_TEXT << ": statement returns a value of type '";
   Type::Print(CERR, src_type) << "'";
@@ -227,20 +277,20 @@ void throw_return_type_is_not_implicitly_castable_to(FileDB& file_db, FileDB::Po
   Declaration::PrintShort(CERR, context);
   CERR << "'" << std::endl;
 
-  print_line_of_source_code_point(file_db.files[point.file].source_code, point, point.byte_start);
+  print_line_of_source_code_point(file_db, point);
 }
 
-void throw_right_operand_of_dot_operator_should_be_a_symbol(FileDB& file_db, FileDB::Point& point, Declaration* context) {
+void throw_right_operand_of_dot_operator_should_be_a_symbol(FileDB& file_db, const FileDB::Point& point, Declaration* context) {
   FileDB::Point::Print(CERR, file_db, point);
   CERR << ": " << RED_TEXT << "type checking error" << NORMAL_TEXT << ": right operand of dot operator should be a symbol" << std::endl;
   CERR << "inside of declaration '";
   Declaration::PrintShort(CERR, context);
   CERR << "'" << std::endl;
 
-  print_line_of_source_code_point(file_db.files[point.file].source_code, point, point.byte_start);
+  print_line_of_source_code_point(file_db, point);
 }
 
-void throw_left_operand_of_dot_operator_should_be_a_struct(FileDB& file_db, FileDB::Point& point, Declaration* context, Type* non_struct_type) {
+void throw_left_operand_of_dot_operator_should_be_a_struct(FileDB& file_db, const FileDB::Point& point, Declaration* context, Type* non_struct_type) {
   FileDB::Point::Print(CERR, file_db, point);
   CERR << ": " << RED_TEXT << "type checking error" << NORMAL_TEXT << ": left operand of dot operator should be a struct, instead is '";
   Type::Print(CERR, non_struct_type) << "'" << std::endl;
@@ -248,10 +298,10 @@ void throw_left_operand_of_dot_operator_should_be_a_struct(FileDB& file_db, File
   Declaration::PrintShort(CERR, context);
   CERR << "'" << std::endl;
 
-  print_line_of_source_code_point(file_db.files[point.file].source_code, point, point.byte_start);
+  print_line_of_source_code_point(file_db, point);
 }
 
-void throw_struct_has_not_named_field(FileDB& file_db, FileDB::Point& point, Declaration* context, Type* struct_type, Symbol& field_name) {
+void throw_struct_has_not_named_field(FileDB& file_db, const FileDB::Point& point, Declaration* context, Type* struct_type, Symbol& field_name) {
   FileDB::Point::Print(CERR, file_db, point);
   CERR << ": " << RED_TEXT << "type checking error" << NORMAL_TEXT << ": struct '";
   Type::Print(CERR, struct_type);
@@ -260,20 +310,20 @@ void throw_struct_has_not_named_field(FileDB& file_db, FileDB::Point& point, Dec
   Declaration::PrintShort(CERR, context);
   CERR << "'" << std::endl;
 
-  print_line_of_source_code_point(file_db.files[point.file].source_code, point, point.byte_start);
+  print_line_of_source_code_point(file_db, point);
 }
 
-void throw_right_operand_of_arrow_operator_should_be_a_symbol(FileDB& file_db, FileDB::Point& point, Declaration* context) {
+void throw_right_operand_of_arrow_operator_should_be_a_symbol(FileDB& file_db, const FileDB::Point& point, Declaration* context) {
   FileDB::Point::Print(CERR, file_db, point);
   CERR << ": " << RED_TEXT << "type checking error" << NORMAL_TEXT << ": right operand of arrow operator should be a symbol" << std::endl;
   CERR << "inside of declaration '";
   Declaration::PrintShort(CERR, context);
   CERR << "'" << std::endl;
 
-  print_line_of_source_code_point(file_db.files[point.file].source_code, point, point.byte_start);
+  print_line_of_source_code_point(file_db, point);
 }
 
-void throw_left_operand_of_array_access_should_be_a_pointer_or_an_array(FileDB& file_db, FileDB::Point& point, Declaration* context, Type* invalid_type) {
+void throw_left_operand_of_array_access_should_be_a_pointer_or_an_array(FileDB& file_db, const FileDB::Point& point, Declaration* context, Type* invalid_type) {
   FileDB::Point::Print(CERR, file_db, point);
   CERR << ": " << RED_TEXT << "type checking error" << NORMAL_TEXT << ": left operand of an array access should be an array or a pointer";
   Type::Print(CERR << ", found instead '", invalid_type) << "'" << std::endl;
@@ -281,10 +331,10 @@ void throw_left_operand_of_array_access_should_be_a_pointer_or_an_array(FileDB&
   Declaration::PrintShort(CERR, context);
   CERR << "'" << std::endl;
 
-  print_line_of_source_code_point(file_db.files[point.file].source_code, point, point.byte_start);
+  print_line_of_source_code_point(file_db, point);
 }
 
-void throw_right_operand_of_array_access_should_be_an_integer(FileDB& file_db, FileDB::Point& point, Declaration* context, Type* invalid_type) {
+void throw_right_operand_of_array_access_should_be_an_integer(FileDB& file_db, const FileDB::Point& point, Declaration* context, Type* invalid_type) {
   FileDB::Point::Print(CERR, file_db, point);
   CERR << ": " << RED_TEXT << "type checking error" << NORMAL_TEXT << ": right operand of an array access should be an integer";
   Type::Print(CERR << ", found instead '", invalid_type) << "'" << std::endl;
@@ -292,10 +342,10 @@ void throw_right_operand_of_array_access_should_be_an_integer(FileDB& file_db, F
   Declaration::PrintShort(CERR, context);
   CERR << "'" << std::endl;
 
-  print_line_of_source_code_point(file_db.files[point.file].source_code, point, point.byte_start);
+  print_line_of_source_code_point(file_db, point);
 }
 
-void throw_left_operand_of_arrow_operator_should_be_a_pointer(FileDB& file_db, FileDB::Point& point, Declaration* context, Type* non_struct_type) {
+void throw_left_operand_of_arrow_operator_should_be_a_pointer(FileDB& file_db, const FileDB::Point& point, Declaration* context, Type* non_struct_type) {
   FileDB::Point::Print(CERR, file_db, point);
   CERR << ": " << RED_TEXT << "type checking error" << NORMAL_TEXT << ": left operand of arrow operator should be a pointer, instead is '";
   Type::Print(CERR, non_struct_type) << "'" << std::endl;
@@ -303,10 +353,10 @@ void throw_left_operand_of_arrow_operator_should_be_a_pointer(FileDB& file_db, F
   Declaration::PrintShort(CERR, context);
   CERR << "'" << std::endl;
 
-  print_line_of_source_code_point(file_db.files[point.file].source_code, point, point.byte_start);
+  print_line_of_source_code_point(file_db, point);
 }
 
-void throw_pointed_left_operand_of_arrow_operator_should_be_a_struct(FileDB& file_db, FileDB::Point& point, Declaration* context, Type* non_struct_type) {
+void throw_pointed_left_operand_of_arrow_operator_should_be_a_struct(FileDB& file_db, const FileDB::Point& point, Declaration* context, Type* non_struct_type) {
   FileDB::Point::Print(CERR, file_db, point);
   CERR << ": " << RED_TEXT << "type checking error" << NORMAL_TEXT << ": pointed left operand of arrow operator should be a struct, instead is '";
   Type::Print(CERR, non_struct_type) << "'" << std::endl;
@@ -314,10 +364,10 @@ void throw_pointed_left_operand_of_arrow_operator_should_be_a_struct(FileDB& fil
   Declaration::PrintShort(CERR, context);
   CERR << "'" << std::endl;
 
-  print_line_of_source_code_point(file_db.files[point.file].source_code, point, point.byte_start);
+  print_line_of_source_code_point(file_db, point);
 }
 
-void throw_types_cannot_be_algebraically_manipulated_error(FileDB& file_db, FileDB::Point& point, Declaration* context, Type* left_type, Type* right_type) {
+void throw_types_cannot_be_algebraically_manipulated_error(FileDB& file_db, const FileDB::Point& point, Declaration* context, Type* left_type, Type* right_type) {
   FileDB::Point::Print(CERR, file_db, point);
   CERR << ": " << RED_TEXT << "type checking error" << NORMAL_TEXT << ": types  '";
   Type::Print(CERR, left_type) << "' and '";
@@ -326,10 +376,10 @@ void throw_types_cannot_be_algebraically_manipulated_error(FileDB& file_db, File
   Declaration::PrintShort(CERR, context);
   CERR << "'" << std::endl;
 
-  print_line_of_source_code_point(file_db.files[point.file].source_code, point, point.byte_start);
+  print_line_of_source_code_point(file_db, point);
 }
 
-void throw_type_cannot_be_logically_manipulated_error(FileDB& file_db, FileDB::Point& point, Declaration* context, Type* type) {
+void throw_type_cannot_be_logically_manipulated_error(FileDB& file_db, const FileDB::Point& point, Declaration* context, Type* type) {
   FileDB::Point::Print(CERR, file_db, point);
   CERR << ": " << RED_TEXT << "type checking error" << NORMAL_TEXT << ": type cannot be logically manipulated '";
   Type::Print(CERR, type) << "'" << std::endl;
@@ -337,10 +387,10 @@ void throw_type_cannot_be_logically_manipulated_error(FileDB& file_db, FileDB::P
   Declaration::PrintShort(CERR, context);
   CERR << "'" << std::endl;
 
-  print_line_of_source_code_point(file_db.files[point.file].source_code, point, point.byte_start);
+  print_line_of_source_code_point(file_db, point);
 }
 
-void throw_types_cannot_be_logically_manipulated_error(FileDB& file_db, FileDB::Point& point, Declaration* context, Type* left_type, Type* right_type) {
+void throw_types_cannot_be_logically_manipulated_error(FileDB& file_db, const FileDB::Point& point, Declaration* context, Type* left_type, Type* right_type) {
   FileDB::Point::Print(CERR, file_db, point);
   CERR << ": " << RED_TEXT << "type checking error" << NORMAL_TEXT << ": types  '";
   Type::Print(CERR, left_type) << "' and '";
@@ -349,26 +399,166 @@ void throw_types_cannot_be_logically_manipulated_error(FileDB& file_db, FileDB::
   Declaration::PrintShort(CERR, context);
   CERR << "'" << std::endl;
 
-  print_line_of_source_code_point(file_db.files[point.file].source_code, point, point.byte_start);
+  print_line_of_source_code_point(file_db, point);
 }
 
-void throw_uncaught_type_checker_error(FileDB& file_db, FileDB::Point& point, Declaration* context, Expression* expr) {
+void throw_operand_should_be_a_vector(FileDB& file_db, const FileDB::Point& point, Declaration* context, Type* non_vector_type) {
+  FileDB::Point::Print(CERR, file_db, point);
+  CERR << ": " << RED_TEXT << "type checking error" << NORMAL_TEXT << ": operand should be a vector, instead is '";
+  Type::Print(CERR, non_vector_type) << "'" << std::endl;
+  CERR << " inside of declaration '";
+  Declaration::PrintShort(CERR, context);
+  CERR << "'" << std::endl;
+
+  print_line_of_source_code_point(file_db, point);
+}
+
+void throw_vector_operands_should_have_the_same_type(FileDB& file_db, const FileDB::Point& point, Declaration* context, Type* left_type, Type* right_type) {
+  FileDB::Point::Print(CERR, file_db, point);
+  CERR << ": " << RED_TEXT << "type checking error" << NORMAL_TEXT << ": vector operands should have the same type, found '";
+  Type::Print(CERR, left_type) << "' and '";
+  Type::Print(CERR, right_type) << "'" << std::endl;
+  CERR << " inside of declaration '";
+  Declaration::PrintShort(CERR, context);
+  CERR << "'" << std::endl;
+
+  print_line_of_source_code_point(file_db, point);
+}
+
+void throw_shuffle_mask_should_contain_constant_lane_indexes(FileDB& file_db, const FileDB::Point& point, Declaration* context, std::uintmax_t lanes) {
+  FileDB::Point::Print(CERR, file_db, point);
+  CERR << ": " << RED_TEXT << "type checking error" << NORMAL_TEXT << ": shuffle mask should contain integer literals between 0 and " << lanes - 1 << std::endl;
+  CERR << " inside of declaration '";
+  Declaration::PrintShort(CERR, context);
+  CERR << "'" << std::endl;
+
+  print_line_of_source_code_point(file_db, point);
+}
+
+void throw_shuffle_mask_should_not_be_empty(FileDB& file_db, const FileDB::Point& point, Declaration* context) {
+  FileDB::Point::Print(CERR, file_db, point);
+  CERR << ": " << RED_TEXT << "type checking error" << NORMAL_TEXT << ": shuffle mask should select at least one lane" << std::endl;
+  CERR << " inside of declaration '";
+  Declaration::PrintShort(CERR, context);
+  CERR << "'" << std::endl;
+
+  print_line_of_source_code_point(file_db, point);
+}
+
+void throw_vector_pointer_should_point_to_the_element_type(FileDB& file_db, const FileDB::Point& point, Declaration* context, Type* pointer_type, Type* element_type) {
+  FileDB::Point::Print(CERR, file_db, point);
+  CERR << ": " << RED_TEXT << "type checking error" << NORMAL_TEXT << ": vector pointer should point to the element type '";
+  Type::Print(CERR, element_type) << "', instead is '";
+  Type::Print(CERR, pointer_type) << "'" << std::endl;
+  CERR << " inside of declaration '";
+  Declaration::PrintShort(CERR, context);
+  CERR << "'" << std::endl;
+
+  print_line_of_source_code_point(file_db, point);
+}
+
+void throw_lane_of_boolean_vector_is_not_addressable(FileDB& file_db, const FileDB::Point& point, Declaration* context) {
+  FileDB::Point::Print(CERR, file_db, point);
+  CERR << ": " << RED_TEXT << "type checking error" << NORMAL_TEXT << ": lanes of a bool vector are packed bits and cannot be addressed" << std::endl;
+  CERR << " inside of declaration '";
+  Declaration::PrintShort(CERR, context);
+  CERR << "'" << std::endl;
+
+  print_line_of_source_code_point(file_db, point);
+}
+
+void throw_wrong_builtin_argument_number(FileDB& file_db, const FileDB::Point& point, Declaration* context, builtin_t builtin) {
+  FileDB::Point::Print(CERR, file_db, point);
+  CERR << ": " << RED_TEXT << "type checking error" << NORMAL_TEXT << ": builtin '" << builtin << "' requires " << get_builtin_arity(builtin) << " arguments" << std::endl;
+  CERR << " inside of declaration '";
+  Declaration::PrintShort(CERR, context);
+  CERR << "'" << std::endl;
+
+  print_line_of_source_code_point(file_db, point);
+}
+
+void throw_builtin_argument_has_wrong_type(FileDB& file_db, const FileDB::Point& point, Declaration* context, builtin_t builtin, Type* type, const char* expected) {
+  FileDB::Point::Print(CERR, file_db, point);
+  CERR << ": " << RED_TEXT << "type checking error" << NORMAL_TEXT << ": argument of builtin '" << builtin << "' should be " << expected << ", instead is '";
+  Type::Print(CERR, type) << "'" << std::endl;
+  CERR << " inside of declaration '";
+  Declaration::PrintShort(CERR, context);
+  CERR << "'" << std::endl;
+
+  print_line_of_source_code_point(file_db, point);
+}
+
+void throw_builtin_argument_should_be_an_integer_literal(FileDB& file_db, const FileDB::Point& point, Declaration* context, builtin_t builtin, std::intmax_t min, std::intmax_t max) {
+  FileDB::Point::Print(CERR, file_db, point);
+  CERR << ": " << RED_TEXT << "type checking error" << NORMAL_TEXT << ": argument of builtin '" << builtin << "' should be an integer literal between " << min << " and " << max << std::endl;
+  CERR << " inside of declaration '";
+  Declaration::PrintShort(CERR, context);
+  CERR << "'" << std::endl;
+
+  print_line_of_source_code_point(file_db, point);
+}
+
+void throw_aggregate_literal_type_should_be_an_array_or_a_struct(FileDB& file_db, const FileDB::Point& point, Declaration* context, Type* type) {
+  FileDB::Point::Print(CERR, file_db, point);
+  CERR << ": " << RED_TEXT << "type checking error" << NORMAL_TEXT << ": aggregate literal of type '";
+  Type::Print(CERR, type) << "' should be an array or a struct" << std::endl;
+  CERR << " inside of declaration '";
+  Declaration::PrintShort(CERR, context);
+  CERR << "'" << std::endl;
+
+  print_line_of_source_code_point(file_db, point);
+}
+
+void throw_aggregate_literal_has_too_many_elements(FileDB& file_db, const FileDB::Point& point, Declaration* context, Type* type, std::uintmax_t capacity) {
+  FileDB::Point::Print(CERR, file_db, point);
+  CERR << ": " << RED_TEXT << "type checking error" << NORMAL_TEXT << ": aggregate literal of type '";
+  Type::Print(CERR, type) << "' has more than " << capacity << " elements" << std::endl;
+  CERR << " inside of declaration '";
+  Declaration::PrintShort(CERR, context);
+  CERR << "'" << std::endl;
+
+  print_line_of_source_code_point(file_db, point);
+}
+
+void throw_constant_static_variable_cannot_be_assigned(FileDB& file_db, const FileDB::Point& point, Declaration* context, Declaration* constant) {
+  FileDB::Point::Print(CERR, file_db, point);
+  CERR << ": " << RED_TEXT << "type checking error" << NORMAL_TEXT << ": constant static variable '";
+  Declaration::PrintShort(CERR, constant) << "' cannot be assigned" << std::endl;
+  CERR << " inside of declaration '";
+  Declaration::PrintShort(CERR, context);
+  CERR << "'" << std::endl;
+
+  print_line_of_source_code_point(file_db, point);
+}
+
+void throw_constant_static_variable_cannot_be_addressed(FileDB& file_db, const FileDB::Point& point, Declaration* context, Declaration* constant) {
+  FileDB::Point::Print(CERR, file_db, point);
+  CERR << ": " << RED_TEXT << "type checking error" << NORMAL_TEXT << ": constant static variable '";
+  Declaration::PrintShort(CERR, constant) << "' lives in read-only memory, its address cannot be taken" << std::endl;
+  CERR << " inside of declaration '";
+  Declaration::PrintShort(CERR, context);
+  CERR << "'" << std::endl;
+
+  print_line_of_source_code_point(file_db, point);
+}
+
+void throw_uncaught_type_checker_error(FileDB& file_db, const FileDB::Point& point, Declaration* context, Expression* expr) {
   FileDB::Point::Print(CERR, file_db, point);
   CERR << ": " << RED_TEXT << "type checking error" << NORMAL_TEXT << " with expression '";
   Expression::Print(CERR, expr) << "' inside of declaration '";
   Declaration::PrintShort(CERR, context);
   CERR << "'" << std::endl;
-  print_line_of_source_code_point(file_db.files[point.file].source_code, point, point.byte_start);
+  print_line_of_source_code_point(file_db, point);
 }
 
-void throw_expression_is_used_in_constant_context_but_is_not_constant(FileDB& file_db, FileDB::Point& point, Declaration* decl) {
+void throw_expression_is_used_in_constant_context_but_is_not_constant(FileDB& file_db, const FileDB::Point& point, Declaration* decl) {
   FileDB::Point::Print(CERR, file_db, point);
   CERR << ": " << RED_TEXT << "constant checking error" << NORMAL_TEXT << ": expression is used is a constant context";
   Declaration::PrintShort(CERR << " (for `", decl) << "`) but it is not constant" << std::endl;
-  print_line_of_source_code_point(file_db.files[point.file].source_code, point, point.byte_start);
+  print_line_of_source_code_point(file_db, point);
 }
 
-void throw_cyclic_dependency_between_static_variables_is_not_protected_by_usage_of_pointers(FileDB& file_db, FileDB::Point& point, Declaration* static_var_decl, Declaration* requested_static_var_decl) {
+void throw_cyclic_dependency_between_static_variables_is_not_protected_by_usage_of_pointers(FileDB& file_db, const FileDB::Point& point, Declaration* static_var_decl, Declaration* requested_static_var_decl) {
   FileDB::Point::Print(CERR, file_db, point);
   CERR << ": " << RED_TEXT << "constant checking error" << NORMAL_TEXT << ": cyclic dependency with static variable '";
   Declaration::PrintShort(CERR, requested_static_var_decl) << "'";
@@ -376,29 +566,51 @@ void throw_cyclic_dependency_between_static_variables_is_not_protected_by_usage_
   Declaration::PrintShort(CERR, static_var_decl);
   CERR << "' is not protected by usage of pointers" << std::endl;
 
-  print_line_of_source_code_point(file_db.files[point.file].source_code, point, point.byte_start);
+  print_line_of_source_code_point(file_db, point);
 }
 
-void throw_constant_expression_is_not_implemented(FileDB& file_db, FileDB::Point& point, Declaration* decl) {
+void throw_constant_expression_is_not_implemented(FileDB& file_db, const FileDB::Point& point, Declaration* decl) {
   FileDB::Point::Print(CERR, file_db, point);
   CERR << ": " << RED_TEXT << "constant checking error" << NORMAL_TEXT << ": expression used as constant";
   Declaration::PrintShort(CERR << " (for `", decl) << "`) but it is not implemented" << std::endl;
-  print_line_of_source_code_point(file_db.files[point.file].source_code, point, point.byte_start);
+  print_line_of_source_code_point(file_db, point);
+}
+
+void throw_integer_overflow_in_constant_expression(FileDB& file_db, const FileDB::Point& point, Declaration* decl) {
+  FileDB::Point::Print(CERR, file_db, point);
+  CERR << ": " << RED_TEXT << "constant checking error" << NORMAL_TEXT << ": integer overflow while folding a constant expression";
+  Declaration::PrintShort(CERR << " (for `", decl) << "`)" << std::endl;
+  print_line_of_source_code_point(file_db, point);
+}
+
+void throw_float_does_not_fit_integer_in_constant_expression(FileDB& file_db, const FileDB::Point& point, Declaration* decl) {
+  FileDB::Point::Print(CERR, file_db, point);
+  CERR << ": " << RED_TEXT << "constant checking error" << NORMAL_TEXT << ": float converted to an integer is not finite or out of its range";
+  Declaration::PrintShort(CERR << " (for `", decl) << "`)" << std::endl;
+  print_line_of_source_code_point(file_db, point);
 }
 
-void throw_was_not_able_to_deduce_binexp_types(FileDB& file_db, FileDB::Point& point, Declaration* decl, Expression* left, Expression* right) {
+void throw_was_not_able_to_deduce_binexp_types(FileDB& file_db, const FileDB::Point& point, Declaration* decl, Expression* left, Expression* right) {
   FileDB::Point::Print(CERR, file_db, point);
   CERR << ": " << RED_TEXT << "constant checking error" << NORMAL_TEXT << ": was not able to deduce the constant operand expression types";
   Declaration::PrintShort(CERR << " (for `", decl) << "`) involving '";
   Expression::Print(CERR, left) << "' (which is of type " << left->kind << ") and '";
   Expression::Print(CERR, right) << "' (which is of type " << right->kind << ")" << std::endl;
-  print_line_of_source_code_point(file_db.files[point.file].source_code, point, point.byte_start);
+  print_line_of_source_code_point(file_db, point);
 }
 
-void throw_was_not_able_to_deduce_monexp_types(FileDB& file_db, FileDB::Point& point, Declaration* decl, Expression* value) {
+void throw_was_not_able_to_deduce_monexp_types(FileDB& file_db, const FileDB::Point& point, Declaration* decl, Expression* value) {
   FileDB::Point::Print(CERR, file_db, point);
   CERR << ": " << RED_TEXT << "constant checking error" << NORMAL_TEXT << ": was not able to deduce the constant operand expression types";
   Declaration::PrintShort(CERR << " (for `", decl) << "`) involving '";
   Expression::Print(CERR, value) << "' (which is of type " << value->kind << ")" << std::endl;
-  print_line_of_source_code_point(file_db.files[point.file].source_code, point, point.byte_start);
+  print_line_of_source_code_point(file_db, point);
+}
+
+void throw_constant_evaluation_exceeded_its_budget(FileDB& file_db, const FileDB::Point& point, Declaration* function) {
+  FileDB::Point::Print(CERR, file_db, point);
+  CERR << ": " << RED_TEXT << "constant checking error" << NORMAL_TEXT << ": compile-time evaluation";
+  Declaration::PrintShort(CERR << " of `", function) << "` exceeded its budget of " << API::CONSTANT_EVALUATION_STEP_LIMIT << " steps";
+  CERR << " or " << API::CONSTANT_EVALUATION_DEPTH_LIMIT << " nested calls" << std::endl;
+  print_line_of_source_code_point(file_db, point);
 }
@@ -8,6 +8,8 @@
 
 #include <cstdio>
 #include <cstdlib>
+#include <cinttypes>
+#include <algorithm>
 #include <filesystem>
 #include <assert.h>
 #include <cstring>
@@ -27,7 +29,26 @@ void print_help() {
   std::cout << "" << std::endl;
   std::cout << "  -d                       Dumps debug information to stdout and to './tmp' directory." << std::endl;
   std::cout << "" << std::endl;
+  std::cout << "  -fstrict-aliasing        Assume that accesses through different types do not alias." << std::endl;
+  std::cout << "  -fno-strict-aliasing     Do not make any assumption based on types (default)." << std::endl;
+  std::cout << "  -fstrip-unreachable      Skip functions and statics not reachable from global ones or main (default)." << std::endl;
+  std::cout << "  -fno-strip-unreachable   Resolve, check and emit every function and static." << std::endl;
+  std::cout << "  -fstream-functions       After parsing and resolving every body, check and emit one function at a time, releasing it once emitted." << std::endl;
+  std::cout << "  -fno-stream-functions    Run each phase over the whole program (default)." << std::endl;
+  std::cout << "  -fwrapv                  Integer overflow wraps around (default)." << std::endl;
+  std::cout << "  -ftrapv                  Integer overflow traps at runtime." << std::endl;
+  std::cout << "  -fno-wrapv               Signed integer overflow is undefined behaviour." << std::endl;
+  std::cout << "  -ffast-math              Enable every fast-math flag and -fno-math-errno." << std::endl;
+  std::cout << "  -fassociative-math       Allow reassociation of floating point operations (reassoc)." << std::endl;
+  std::cout << "  -ffinite-math-only       Assume no NaNs and no infinities (nnan, ninf)." << std::endl;
+  std::cout << "  -fno-signed-zeros        Ignore the sign of zeros (nsz)." << std::endl;
+  std::cout << "  -freciprocal-math        Allow the use of reciprocals (arcp)." << std::endl;
+  std::cout << "  -fapprox-func            Allow approximated math functions (afn)." << std::endl;
+  std::cout << "  -ffp-contract=<mode>     Allow (fast) or forbid (on, off) fused floating point operations (contract)." << std::endl;
+  std::cout << "  -fno-math-errno          Assume that math functions never set errno." << std::endl;
+  std::cout << "" << std::endl;
   std::cout << "  -I<path>                 Add path to include directories." << std::endl;
+  std::cout << "  -j<jobs>                 Analyze function bodies on <jobs> threads (default: one per core)." << std::endl;
   std::cout << "  -Wg,<options>            Pass comma-separated <options> on to the generator." << std::endl;
   std::cout << "  -Wa,<options>            Pass comma-separated <options> on to the assembler." << std::endl;
   std::cout << "  -Wl,<options>            Pass comma-separated <options> on to the linker." << std::endl;
@@ -184,6 +205,48 @@ int main(int argc, char** args) {
       API::DEBUG_SEGFAULT_IDENTIFY_PHASE = true;
     } else if (arg == "-v" || arg == "--verbose") {
       API::ECHO_SYSTEM_COMMANDS = true;
+    } else if (arg == "-fstrict-aliasing") {
+      API::STRICT_ALIASING = true;
+    } else if (arg == "-fno-strict-aliasing") {
+      API::STRICT_ALIASING = false;
+    } else if (arg == "-fstream-functions") {
+      API::STREAM_FUNCTIONS = true;
+    } else if (arg == "-fno-stream-functions") {
+      API::STREAM_FUNCTIONS = false;
+    } else if (arg == "-fstrip-unreachable") {
+      API::STRIP_UNREACHABLE = true;
+    } else if (arg == "-fno-strip-unreachable") {
+      API::STRIP_UNREACHABLE = false;
+    } else if (arg == "-fwrapv") {
+      API::OVERFLOW_MODE = API::WRAP_OVERFLOW;
+    } else if (arg == "-ftrapv") {
+      API::OVERFLOW_MODE = API::TRAP_OVERFLOW;
+    } else if (arg == "-fno-wrapv") {
+      API::OVERFLOW_MODE = API::UNDEFINED_OVERFLOW;
+    } else if (arg == "-ffast-math") {
+      API::FAST_MATH_FLAGS = API::FAST_MATH_ALL;
+      API::SET_MATH_ERRNO = false;
+    } else if (arg == "-fno-fast-math") {
+      API::FAST_MATH_FLAGS = API::FAST_MATH_NONE;
+      API::SET_MATH_ERRNO = true;
+    } else if (arg == "-fassociative-math") {
+      API::FAST_MATH_FLAGS |= API::FAST_MATH_REASSOC;
+    } else if (arg == "-ffinite-math-only") {
+      API::FAST_MATH_FLAGS |= API::FAST_MATH_NNAN | API::FAST_MATH_NINF;
+    } else if (arg == "-fno-signed-zeros") {
+      API::FAST_MATH_FLAGS |= API::FAST_MATH_NSZ;
+    } else if (arg == "-freciprocal-math") {
+      API::FAST_MATH_FLAGS |= API::FAST_MATH_ARCP;
+    } else if (arg == "-fapprox-func") {
+      API::FAST_MATH_FLAGS |= API::FAST_MATH_AFN;
+    } else if (arg == "-ffp-contract=fast") {
+      API::FAST_MATH_FLAGS |= API::FAST_MATH_CONTRACT;
+    } else if (arg == "-ffp-contract=on" || arg == "-ffp-contract=off") {
+      API::FAST_MATH_FLAGS &= ~API::FAST_MATH_CONTRACT;
+    } else if (arg == "-fno-math-errno") {
+      API::SET_MATH_ERRNO = false;
+    } else if (arg == "-fmath-errno") {
+      API::SET_MATH_ERRNO = true;
     } else if (arg == "-h" || arg == "--help") {
       print_help();
       std::exit(0);
@@ -198,6 +261,9 @@ int main(int argc, char** args) {
     } else if (arg.starts_with("-I")) {
       std::string include_directory = read_next_arg(args, n_of_args, i, "-I");
       include_directories.push_back(include_directory);
+    } else if (arg.starts_with("-j")) {
+      std::string jobs = read_next_arg(args, n_of_args, i, "-j");
+      API::JOBS = std::max<std::uintmax_t>(1, std::strtoumax(jobs.c_str(), nullptr, 10));
     } else if (arg.starts_with("-Wg")) {
       std::string options = read_next_arg(args, n_of_args, i, "-Wg");
       generator_options.push_back(options);
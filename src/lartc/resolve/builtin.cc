@@ -0,0 +1,75 @@
+#include <lartc/resolve/builtin.hh>
+#include <cassert>
+
+bool find_builtin(const Symbol& symbol, builtin_t& builtin) {
+  if (symbol.identifiers.size() != 1)
+    return false;
+  const std::string& name = symbol.identifiers.front();
+  if (name == "__builtin_expect")
+    builtin = EXPECT_BUILTIN;
+  else if (name == "__builtin_prefetch")
+    builtin = PREFETCH_BUILTIN;
+  else if (name == "__builtin_assume")
+    builtin = ASSUME_BUILTIN;
+  else if (name == "__builtin_popcount")
+    builtin = POPCOUNT_BUILTIN;
+  else if (name == "__builtin_clz")
+    builtin = CLZ_BUILTIN;
+  else if (name == "__builtin_ctz")
+    builtin = CTZ_BUILTIN;
+  else if (name == "__builtin_rotl")
+    builtin = ROTL_BUILTIN;
+  else if (name == "__builtin_rotr")
+    builtin = ROTR_BUILTIN;
+  else if (name == "__builtin_fshl")
+    builtin = FSHL_BUILTIN;
+  else if (name == "__builtin_fshr")
+    builtin = FSHR_BUILTIN;
+  else if (name == "__builtin_memcpy")
+    builtin = MEMCPY_BUILTIN;
+  else if (name == "__builtin_memset")
+    builtin = MEMSET_BUILTIN;
+  else
+    return false;
+  return true;
+}
+
+std::ostream& operator<<(std::ostream& out, builtin_t builtin) {
+  switch (builtin) {
+    case EXPECT_BUILTIN: return out << "__builtin_expect";
+    case PREFETCH_BUILTIN: return out << "__builtin_prefetch";
+    case ASSUME_BUILTIN: return out << "__builtin_assume";
+    case POPCOUNT_BUILTIN: return out << "__builtin_popcount";
+    case CLZ_BUILTIN: return out << "__builtin_clz";
+    case CTZ_BUILTIN: return out << "__builtin_ctz";
+    case ROTL_BUILTIN: return out << "__builtin_rotl";
+    case ROTR_BUILTIN: return out << "__builtin_rotr";
+    case FSHL_BUILTIN: return out << "__builtin_fshl";
+    case FSHR_BUILTIN: return out << "__builtin_fshr";
+    case MEMCPY_BUILTIN: return out << "__builtin_memcpy";
+    case MEMSET_BUILTIN: return out << "__builtin_memset";
+  }
+  return out << "<builtin-t>";
+}
+
+std::uintmax_t get_builtin_arity(builtin_t builtin) {
+  switch (builtin) {
+    case ASSUME_BUILTIN:
+    case POPCOUNT_BUILTIN:
+    case CLZ_BUILTIN:
+    case CTZ_BUILTIN:
+      return 1;
+    case EXPECT_BUILTIN:
+    case ROTL_BUILTIN:
+    case ROTR_BUILTIN:
+      return 2;
+    case PREFETCH_BUILTIN:
+    case FSHL_BUILTIN:
+    case FSHR_BUILTIN:
+    case MEMCPY_BUILTIN:
+    case MEMSET_BUILTIN:
+      return 3;
+  }
+
+  assert(nullptr);
+}
@@ -1,11 +1,15 @@
 #include <lartc/resolve/resolve_symbols.hh>
 #include <lartc/external_errors.hh>
+#include <lartc/api/config.hh>
+#include <lartc/api/parallel.hh>
+#include <memory>
+#include <vector>
 #include <cassert>
 
 inline bool resolve_symbol_or_throw_error(FileDB& file_db, SymbolCache &symbol_cache, Declaration* context, Symbol& symbol) {
   Declaration* query = symbol_cache.get_or_find_declaration(context, symbol);
   if (query == nullptr) {
-    throw_name_resolution_error(file_db, file_db.symbol_points[&symbol], context, symbol);
+    throw_name_resolution_error(file_db, file_db.symbol_point(&symbol), context, symbol);
     return false;
   }
   return true;
@@ -48,6 +52,9 @@ bool resolve_symbols(FileDB& file_db, SymbolCache &symbol_cache, Declaration* co
     case type_t::ARRAY_TYPE:
       resolution_ok &= resolve_symbols(file_db, symbol_cache, context, type->subtype);
       break;
+    case type_t::VECTOR_TYPE:
+      resolution_ok &= resolve_symbols(file_db, symbol_cache, context, type->subtype);
+      break;
     case type_t::STRUCT_TYPE:
       resolution_ok &= resolve_symbols(file_db, symbol_cache,  context, type->fields);
       break;
@@ -68,60 +75,93 @@ bool resolve_symbols(FileDB& file_db, SymbolCache &symbol_cache, Declaration* co
   return resolution_ok;
 }
 
-bool resolve_symbols(FileDB& file_db, SymbolCache &symbol_cache, SymbolStack& symbol_stack, Declaration* context, Expression* expr) {
+// expressions do not open scopes, so they are resolved from an explicit stack in source order
+bool resolve_symbols(FileDB& file_db, SymbolCache &symbol_cache, SymbolStack& symbol_stack, Declaration* context, Expression* root) {
   bool resolution_ok = true;
+  std::vector<Expression*> stack = {root};
+  std::vector<Expression*> operands;
+  while (!stack.empty()) {
+    Expression* expr = stack.back();
+    stack.pop_back();
+    operands.clear();
 
-  switch (expr->kind) {
-    case expression_t::SYMBOL_EXPR:
-      resolution_ok &= resolve_symbol_or_throw_error(file_db, symbol_cache, symbol_stack, context, expr, expr->symbol);
-      break;
-    case expression_t::CALL_EXPR:
-      resolution_ok &= resolve_symbols(file_db, symbol_cache, symbol_stack, context, expr->callable);
-      for (Expression* arg : expr->arguments) {
-        resolution_ok &= resolve_symbols(file_db, symbol_cache, symbol_stack, context, arg);
-      }
-      break;
-    case expression_t::CAST_EXPR:
-      resolution_ok &= resolve_symbols(file_db, symbol_cache, context, expr->type);
-      resolution_ok &= resolve_symbols(file_db, symbol_cache, symbol_stack, context, expr->value);
-      break;
-    case expression_t::BITCAST_EXPR:
-      resolution_ok &= resolve_symbols(file_db, symbol_cache, context, expr->type);
-      resolution_ok &= resolve_symbols(file_db, symbol_cache, symbol_stack, context, expr->value);
-      break;
-    case expression_t::VANEXT_EXPR:
-      resolution_ok &= resolve_symbols(file_db, symbol_cache, context, expr->type);
-      break;
-    case expression_t::SIZEOF_EXPR:
-      resolution_ok &= resolve_symbols(file_db, symbol_cache, context, expr->type);
-      break;
-    case expression_t::BINARY_EXPR:
-      resolution_ok &= resolve_symbols(file_db, symbol_cache, symbol_stack, context, expr->left);
-      if (expr->operator_ != DOT_OP && expr->operator_ != ARR_OP) {
-        resolution_ok &= resolve_symbols(file_db, symbol_cache, symbol_stack, context, expr->right);
-      }
-      break;
-    case expression_t::ARRAY_ACCESS_EXPR:
-      resolution_ok &= resolve_symbols(file_db, symbol_cache, symbol_stack, context, expr->left);
-      resolution_ok &= resolve_symbols(file_db, symbol_cache, symbol_stack, context, expr->right);
-      break;
-    case expression_t::MONARY_EXPR:
-      resolution_ok &= resolve_symbols(file_db, symbol_cache, symbol_stack, context, expr->value);
-      break;
-    case expression_t::INTEGER_EXPR:
-      break;
-    case expression_t::DOUBLE_EXPR:
-      break;
-    case expression_t::NULLPTR_EXPR:
-      break;
-    case expression_t::BOOLEAN_EXPR:
-      break;
-    case expression_t::CHARACTER_EXPR:
-      break;
-    case expression_t::STRING_EXPR:
-      break;
-  }
+    switch (expr->kind) {
+      case expression_t::SYMBOL_EXPR:
+        resolution_ok &= resolve_symbol_or_throw_error(file_db, symbol_cache, symbol_stack, context, expr, expr->symbol);
+        break;
+      case expression_t::CALL_EXPR:
+        if (expr->callable->kind != expression_t::SYMBOL_EXPR
+         || symbol_cache.get_or_find_builtin(expr->callable, expr->callable->symbol) == nullptr) {
+          operands.push_back(expr->callable);
+        }
+        for (Expression* arg : expr->arguments) {
+          operands.push_back(arg);
+        }
+        break;
+      case expression_t::CAST_EXPR:
+        resolution_ok &= resolve_symbols(file_db, symbol_cache, context, expr->type);
+        operands.push_back(expr->value);
+        break;
+      case expression_t::BITCAST_EXPR:
+        resolution_ok &= resolve_symbols(file_db, symbol_cache, context, expr->type);
+        operands.push_back(expr->value);
+        break;
+      case expression_t::VANEXT_EXPR:
+        resolution_ok &= resolve_symbols(file_db, symbol_cache, context, expr->type);
+        break;
+      case expression_t::VECTOR_LOAD_EXPR:
+        resolution_ok &= resolve_symbols(file_db, symbol_cache, context, expr->type);
+        operands.push_back(expr->value);
+        break;
+      case expression_t::VECTOR_STORE_EXPR:
+        operands.push_back(expr->left);
+        operands.push_back(expr->right);
+        break;
+      case expression_t::VECTOR_SHUFFLE_EXPR:
+        operands.push_back(expr->left);
+        operands.push_back(expr->right);
+        for (Expression* lane : expr->arguments) {
+          operands.push_back(lane);
+        }
+        break;
+      case expression_t::AGGREGATE_LITERAL_EXPR:
+        resolution_ok &= resolve_symbols(file_db, symbol_cache, context, expr->type);
+        for (Expression* element : expr->arguments) {
+          operands.push_back(element);
+        }
+        break;
+      case expression_t::SIZEOF_EXPR:
+        resolution_ok &= resolve_symbols(file_db, symbol_cache, context, expr->type);
+        break;
+      case expression_t::BINARY_EXPR:
+        operands.push_back(expr->left);
+        if (expr->operator_ != DOT_OP && expr->operator_ != ARR_OP) {
+          operands.push_back(expr->right);
+        }
+        break;
+      case expression_t::ARRAY_ACCESS_EXPR:
+        operands.push_back(expr->left);
+        operands.push_back(expr->right);
+        break;
+      case expression_t::MONARY_EXPR:
+        operands.push_back(expr->value);
+        break;
+      case expression_t::INTEGER_EXPR:
+        break;
+      case expression_t::DOUBLE_EXPR:
+        break;
+      case expression_t::NULLPTR_EXPR:
+        break;
+      case expression_t::BOOLEAN_EXPR:
+        break;
+      case expression_t::CHARACTER_EXPR:
+        break;
+      case expression_t::STRING_EXPR:
+        break;
+    }
 
+    stack.insert(stack.end(), operands.rbegin(), operands.rend());
+  }
   return resolution_ok;
 }
 
@@ -179,7 +219,27 @@ bool resolve_symbols(FileDB& file_db, SymbolCache &symbol_cache, SymbolStack& sy
   return resolution_ok;
 }
 
-bool resolve_symbols(FileDB& file_db, SymbolCache& symbol_cache, Declaration* decl) {
+bool resolve_function_bodies(FileDB& file_db, SymbolCache& symbol_cache, const std::vector<Declaration*>& functions) {
+  // a body only reads the declaration tree, so each one is resolved into its own shard
+  std::unique_ptr<SymbolCache[]> shards (new SymbolCache[functions.size()]);
+  bool resolution_ok = API::run_in_parallel(functions.size(), [&](std::uintmax_t index) {
+    Declaration* decl = functions[index];
+    bool body_ok = true;
+    if (decl->body != nullptr) {
+      SymbolStack symbol_stack;
+      symbol_stack.open_scope();
+      body_ok &= resolve_symbols(file_db, shards[index], symbol_stack, decl, decl->body);
+      symbol_stack.close_scope();
+    }
+    return body_ok;
+  });
+  for (std::uintmax_t index = 0; index < functions.size(); ++index) {
+    SymbolCache::Merge(symbol_cache, shards[index]);
+  }
+  return resolution_ok;
+}
+
+bool resolve_declaration_symbols(FileDB& file_db, SymbolCache& symbol_cache, Declaration* decl, std::vector<Declaration*>& functions) {
   bool resolution_ok = true;
 
   switch (decl->kind) {
@@ -189,16 +249,12 @@ bool resolve_symbols(FileDB& file_db, SymbolCache& symbol_cache, Declaration* de
     case declaration_t::FUNCTION_DECL:
       resolution_ok &= resolve_symbols(file_db, symbol_cache, decl, decl->type);
       resolution_ok &= resolve_symbols(file_db, symbol_cache, decl, decl->parameters);
-      if (decl->body != nullptr) {
-        SymbolStack symbol_stack;
-        symbol_stack.open_scope();
-        resolution_ok &= resolve_symbols(file_db, symbol_cache, symbol_stack, decl, decl->body);
-        symbol_stack.close_scope();
-      }
+      if (decl->body != nullptr)
+        functions.push_back(decl);
       break;
     case declaration_t::MODULE_DECL:
       for (Declaration* child : decl->children) {
-        resolution_ok &= resolve_symbols(file_db, symbol_cache, child);
+        resolution_ok &= resolve_declaration_symbols(file_db, symbol_cache, child, functions);
       }
       break;
     case declaration_t::STATIC_VARIABLE_DECL:
@@ -215,3 +271,13 @@ bool resolve_symbols(FileDB& file_db, SymbolCache& symbol_cache, Declaration* de
   }
   return resolution_ok;
 }
+
+bool resolve_symbols(FileDB& file_db, SymbolCache& symbol_cache, Declaration* decl) {
+  std::vector<Declaration*> functions;
+  bool resolution_ok = resolve_declaration_symbols(file_db, symbol_cache, decl, functions);
+  // when stripping, bodies are resolved once they are reached
+  if (!API::STRIP_UNREACHABLE) {
+    resolution_ok &= resolve_function_bodies(file_db, symbol_cache, functions);
+  }
+  return resolution_ok;
+}
@@ -0,0 +1,76 @@
+#include <lartc/resolve/strip_unreachable.hh>
+#include <lartc/resolve/resolve_symbols.hh>
+#include <set>
+
+bool is_reachability_root(Declaration* decl) {
+  switch (decl->kind) {
+    case declaration_t::FUNCTION_DECL:
+      return decl->modifier != MODIFIER_NONE || (decl->name == "main" && decl->parent != nullptr && decl->parent->parent == nullptr);
+    case declaration_t::STATIC_VARIABLE_DECL:
+      return decl->modifier != MODIFIER_NONE;
+    case declaration_t::MODULE_DECL:
+    case declaration_t::TYPE_DECL:
+      return true;
+  }
+  return true;
+}
+
+void collect_reachability_roots(Declaration* decl, std::vector<Declaration*>& pending) {
+  if (is_reachability_root(decl)) {
+    pending.push_back(decl);
+  }
+  if (decl->kind == declaration_t::MODULE_DECL) {
+    for (Declaration* child : decl->children) {
+      collect_reachability_roots(child, pending);
+    }
+  }
+}
+
+void detach_unreachable(Declaration* decl, std::set<Declaration*>& reachable, std::vector<Declaration*>& stripped) {
+  std::vector<Declaration*> children;
+  for (Declaration* child : decl->children) {
+    if (reachable.contains(child)) {
+      if (child->kind == declaration_t::MODULE_DECL)
+        detach_unreachable(child, reachable, stripped);
+      children.push_back(child);
+    } else {
+      stripped.push_back(child);
+    }
+  }
+  decl->children = children;
+}
+
+bool strip_unreachable(FileDB& file_db, SymbolCache& symbol_cache, Declaration* decl_tree, std::vector<Declaration*>& stripped) {
+  bool resolution_ok = true;
+  std::vector<Declaration*> pending;
+  collect_reachability_roots(decl_tree, pending);
+
+  // every symbol a declaration references was cached under it while resolving,
+  // the bodies of a frontier are resolved together before its references are followed
+  std::set<Declaration*> reachable;
+  while (!pending.empty()) {
+    std::vector<Declaration*> frontier;
+    std::vector<Declaration*> functions;
+    for (Declaration* decl : pending) {
+      if (reachable.insert(decl).second) {
+        frontier.push_back(decl);
+        if (decl->kind == declaration_t::FUNCTION_DECL && decl->body != nullptr)
+          functions.push_back(decl);
+      }
+    }
+    pending.clear();
+    resolution_ok &= resolve_function_bodies(file_db, symbol_cache, functions);
+    for (Declaration* decl : frontier) {
+      auto it = symbol_cache.globals.find(decl);
+      if (it == symbol_cache.globals.end())
+        continue;
+      for (auto& solved : it->second) {
+        if (solved.second != nullptr && !reachable.contains(solved.second))
+          pending.push_back(solved.second);
+      }
+    }
+  }
+
+  detach_unreachable(decl_tree, reachable, stripped);
+  return resolution_ok;
+}
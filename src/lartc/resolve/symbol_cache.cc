@@ -1,4 +1,5 @@
 #include <lartc/resolve/symbol_cache.hh>
+#include <mutex>
 
 std::ostream& SymbolCache::Print(std::ostream& out, FileDB& file_db, SymbolCache& symbol_cache) {
   out << "# Symbol Cache" << std::endl << std::endl;
@@ -28,6 +29,12 @@ std::ostream& SymbolCache::Print(std::ostream& out, FileDB& file_db, SymbolCache
     out << solved.second->first << ": ";
     Type::Print(out, solved.second->second) << std::endl;
   }
+  out << std::endl;
+
+  out << "## Builtins" << std::endl << std::endl;
+  for (auto solved : symbol_cache.builtins) {
+    Expression::Print(out << " - ", solved.first) << " -> " << solved.second << std::endl;
+  }
   return out;
 }
 
@@ -83,11 +90,13 @@ Declaration* SymbolCache::get_or_find_declaration(Declaration* context, Symbol&
 
   query = find_by_going_up(context, symbol);
   // i want to signal that no definition is found from scope of context
+  std::unique_lock lock (globals_mutex);
   globals[context][symbol] = query;
   return query;
 }
 
 Declaration* SymbolCache::get_declaration(Declaration* context, Symbol& symbol) const {
+  std::shared_lock lock (globals_mutex);
   if (globals.contains(context)) {
     if (globals.at(context).contains(symbol)) {
       return globals.at(context).at(symbol);
@@ -142,3 +151,36 @@ std::pair<std::string, Type*>* SymbolCache::get_parameter(Expression* context) c
   }
   return nullptr;
 }
+
+const builtin_t* SymbolCache::get_or_find_builtin(Expression* expression, Symbol& symbol) {
+  const builtin_t* query = get_builtin(expression);
+  if (query != nullptr)
+    return query;
+
+  builtin_t builtin;
+  if (find_builtin(symbol, builtin)) {
+    builtins[expression] = builtin;
+    return &builtins.at(expression);
+  }
+  return nullptr;
+}
+
+const builtin_t* SymbolCache::get_builtin(Expression* context) const {
+  if (builtins.contains(context)) {
+    return &builtins.at(context);
+  }
+  return nullptr;
+}
+
+void SymbolCache::Merge(SymbolCache& symbol_cache, SymbolCache& shard) {
+  for (auto& item : shard.globals) {
+    symbol_cache.globals[item.first].merge(item.second);
+  }
+  symbol_cache.locals.merge(shard.locals);
+  symbol_cache.parameters.merge(shard.parameters);
+  symbol_cache.builtins.merge(shard.builtins);
+  shard.globals = {};
+  shard.locals = {};
+  shard.parameters = {};
+  shard.builtins = {};
+}
@@ -31,6 +31,10 @@ bool types_are_namely_equal(SymbolCache& symbol_cache, Declaration* contextA, Ty
       equals &= types_are_namely_equal(symbol_cache, contextA, A->subtype, contextB, B->subtype);
       equals &= A->size == B->size;
       break;
+    case type_t::VECTOR_TYPE:
+      equals &= types_are_namely_equal(symbol_cache, contextA, A->subtype, contextB, B->subtype);
+      equals &= A->size == B->size;
+      break;
     case type_t::VOID_TYPE:
       break;
     case type_t::DOUBLE_TYPE:
@@ -100,6 +104,10 @@ bool types_are_structurally_equal(SymbolCache& symbol_cache, Declaration* contex
       equals &= types_are_structurally_equal(symbol_cache, contextA, A->subtype, contextB, B->subtype);
       equals &= A->size == B->size;
       break;
+    case type_t::VECTOR_TYPE:
+      equals &= types_are_structurally_equal(symbol_cache, contextA, A->subtype, contextB, B->subtype);
+      equals &= A->size == B->size;
+      break;
     case type_t::VOID_TYPE:
       break;
     case type_t::DOUBLE_TYPE:
@@ -165,6 +173,10 @@ bool types_are_structurally_compatible(SymbolCache& symbol_cache, Declaration* c
       compatibles &= types_are_structurally_compatible(symbol_cache, contextSrc, Src->subtype, contextDst, Dst->subtype);
       compatibles &= Src->size == Dst->size;
       break;
+    case type_t::VECTOR_TYPE:
+      compatibles &= types_are_structurally_compatible(symbol_cache, contextSrc, Src->subtype, contextDst, Dst->subtype);
+      compatibles &= Src->size == Dst->size;
+      break;
     case type_t::VOID_TYPE:
       break;
     case type_t::DOUBLE_TYPE:
@@ -231,6 +243,8 @@ bool type_can_be_implicitly_casted_to(SymbolCache& symbol_cache, Declaration* co
       {
         if (src->kind == type_t::POINTER_TYPE) {
           implicitly_castable &= (src->subtype->kind == VOID_TYPE || dst->subtype->kind == VOID_TYPE || types_are_structurally_compatible(symbol_cache, context, src->subtype, context, dst->subtype));
+          // restrict can be dropped, but only an explicit cast can add it
+          implicitly_castable &= (src->is_restrict || !dst->is_restrict);
         } else {
           implicitly_castable = false;
         }
@@ -246,6 +260,16 @@ bool type_can_be_implicitly_casted_to(SymbolCache& symbol_cache, Declaration* co
         }
       }
       break;
+    case type_t::VECTOR_TYPE:
+      {
+        if (src->kind == type_t::VECTOR_TYPE) {
+          implicitly_castable &= types_are_structurally_compatible(symbol_cache, context_src, src->subtype, context_dst, dst->subtype);
+          implicitly_castable &= src->size == dst->size;
+        } else {
+          implicitly_castable = false;
+        }
+      }
+      break;
     case type_t::VOID_TYPE:
       {
         implicitly_castable &= (src->kind == dst->kind);
@@ -310,6 +334,10 @@ bool type_is_algebraically_manipulable(SymbolCache& symbol_cache, Declaration* c
     case type_t::ARRAY_TYPE:
       algebraically_manipulable = false;
       break;
+    case type_t::VECTOR_TYPE:
+      // element-wise
+      algebraically_manipulable = type_is_algebraically_manipulable(symbol_cache, context, type->subtype);
+      break;
     case type_t::VOID_TYPE:
       algebraically_manipulable = false;
       break;
@@ -348,6 +376,12 @@ bool types_are_algebraically_manipulable(SymbolCache& symbol_cache, Declaration*
     contextB = solved.second;
   }
 
+  if (A->kind == type_t::VECTOR_TYPE || B->kind == type_t::VECTOR_TYPE) {
+    // no implicit splat, both sides must be the same vector
+    return (types_are_structurally_equal(symbol_cache, contextA, A, contextB, B)
+            && type_is_algebraically_manipulable(symbol_cache, contextA, A));
+  }
+
   if (A->kind == type_t::POINTER_TYPE) {
     if (B->kind == type_t::POINTER_TYPE) {
       // cannot add two pointers regaredless of types
@@ -376,6 +410,10 @@ bool type_is_logically_manipulable(SymbolCache& symbol_cache, Declaration* conte
       break;
     case type_t::ARRAY_TYPE:
       break;
+    case type_t::VECTOR_TYPE:
+      // element-wise
+      logically_manipulable = type_is_logically_manipulable(symbol_cache, context, type->subtype);
+      break;
     case type_t::VOID_TYPE:
       logically_manipulable = false;
       break;
@@ -413,6 +451,12 @@ bool types_are_logically_manipulable(SymbolCache& symbol_cache, Declaration* con
     contextB = solved.second;
   }
 
+  if (A->kind == type_t::VECTOR_TYPE || B->kind == type_t::VECTOR_TYPE) {
+    // no implicit splat, both sides must be the same vector
+    return (types_are_structurally_equal(symbol_cache, contextA, A, contextB, B)
+            && type_is_logically_manipulable(symbol_cache, contextA, A));
+  }
+
   return (type_is_logically_manipulable(symbol_cache, contextA, A)
           && type_is_logically_manipulable(symbol_cache, contextB, B));
 }
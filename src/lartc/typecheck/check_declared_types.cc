@@ -17,6 +17,28 @@ std::pair<bool, std::uintmax_t> check_declared_types(FileDB& file_db, SymbolCach
         size = checked.second * type->size;
         break;
       }
+    case type_t::VECTOR_TYPE:
+      {
+        auto checked = check_declared_types(file_db, symbol_cache, size_cache, context, type->subtype);
+        declared_types_ok &= checked.first;
+        size = checked.second * type->size;
+
+        Declaration* element_decl = context;
+        Type* element_type = type->subtype;
+        while (declared_types_ok && element_type->kind == type_t::SYMBOL_TYPE) {
+          element_decl = symbol_cache.get_declaration(element_decl, element_type->symbol);
+          element_type = element_decl->type;
+        }
+        if (declared_types_ok
+         && element_type->kind != type_t::INTEGER_TYPE
+         && element_type->kind != type_t::DOUBLE_TYPE
+         && element_type->kind != type_t::BOOLEAN_TYPE
+         && element_type->kind != type_t::POINTER_TYPE) {
+          throw_vector_element_type_should_be_a_scalar(file_db, file_db.type_point(type), context, type->subtype);
+          declared_types_ok = false;
+        }
+        break;
+      }
     case type_t::VOID_TYPE:
       break;
     case type_t::DOUBLE_TYPE:
@@ -36,10 +58,10 @@ std::pair<bool, std::uintmax_t> check_declared_types(FileDB& file_db, SymbolCach
       {
         Declaration* decl = symbol_cache.get_declaration(context, type->symbol);
         if (decl->kind != declaration_t::TYPE_DECL) {
-          throw_a_type_definition_cannot_reference_a_non_type_declaration(file_db, file_db.symbol_points[&type->symbol], context, decl);
+          throw_a_type_definition_cannot_reference_a_non_type_declaration(file_db, file_db.symbol_point(&type->symbol), context, decl);
           declared_types_ok = false;
         } else if (size_cache.staging[decl]) {
-          throw_cyclic_dependency_between_types_is_not_protected_by_usage_of_pointers(file_db, file_db.symbol_points[&type->symbol], context, decl);
+          throw_cyclic_dependency_between_types_is_not_protected_by_usage_of_pointers(file_db, file_db.symbol_point(&type->symbol), context, decl);
           declared_types_ok = false;
         } else {
           if (!size_cache.sizes.contains(decl)) {
@@ -1,10 +1,15 @@
 #include <lartc/typecheck/check_types.hh>
 #include <lartc/typecheck/casting.hh>
+#include <lartc/constants/check_constants.hh>
 #include <lartc/internal_errors.hh>
 #include <lartc/external_errors.hh>
 #include <lartc/api/config.hh>
+#include <lartc/api/parallel.hh>
 #include <cassert>
 #include <iostream>
+#include <memory>
+#include <unordered_map>
+#include <vector>
 
 constexpr std::uintmax_t compute_minimum_size_for(std::intmax_t value) {
   if (value < 0) {
@@ -39,7 +44,10 @@ Type* decide_algebric_binop_type(SymbolCache& symbol_cache, Declaration* context
   }
 
   Type* type = nullptr;
-  if (left->kind == DOUBLE_TYPE && right->kind != DOUBLE_TYPE) {
+  if (left->kind == VECTOR_TYPE) {
+    // operands are the same vector, checked by types_are_algebraically_manipulable
+    type = Type::Clone(left);
+  } else if (left->kind == DOUBLE_TYPE && right->kind != DOUBLE_TYPE) {
     type = Type::New(DOUBLE_TYPE);
     type->size = left->size;
   } else if (left->kind != DOUBLE_TYPE && right->kind == DOUBLE_TYPE) {
@@ -72,7 +80,136 @@ Type* decide_algebric_binop_type(SymbolCache& symbol_cache, Declaration* context
   return type;
 }
 
-bool check_types(FileDB& file_db, SymbolCache& symbol_cache, TypeCache& type_cache, Declaration* context, Expression* expr) {
+bool check_types(FileDB& file_db, SymbolCache& symbol_cache, TypeCache& type_cache, Declaration* context, Expression* expr);
+
+// the constant static variable a place is stored inside of, if any
+Declaration* find_constant_static_of_place(SymbolCache& symbol_cache, TypeCache& type_cache, Declaration* context, Expression* place) {
+  switch (place->kind) {
+    case expression_t::SYMBOL_EXPR:
+      {
+        if (symbol_cache.get_statement(place) != nullptr || symbol_cache.get_parameter(place) != nullptr)
+          return nullptr;
+        Declaration* decl = symbol_cache.get_declaration(context, place->symbol);
+        if (decl != nullptr && decl->kind == declaration_t::STATIC_VARIABLE_DECL && decl->is_const)
+          return decl;
+        return nullptr;
+      }
+    case expression_t::BINARY_EXPR:
+      {
+        if (place->operator_ == DOT_OP)
+          return find_constant_static_of_place(symbol_cache, type_cache, context, place->left);
+        return nullptr;
+      }
+    case expression_t::ARRAY_ACCESS_EXPR:
+      {
+        // elements of arrays and vectors are stored inside of them, pointed elements are not
+        Type* left_type = type_cache.expression_types[place->left];
+        while (left_type != nullptr && left_type->kind == type_t::SYMBOL_TYPE)
+          left_type = resolve_symbol_type(symbol_cache, context, left_type).first;
+        if (left_type != nullptr && (left_type->kind == type_t::ARRAY_TYPE || left_type->kind == type_t::VECTOR_TYPE))
+          return find_constant_static_of_place(symbol_cache, type_cache, context, place->left);
+        return nullptr;
+      }
+    default:
+      return nullptr;
+  }
+}
+
+inline bool check_builtin_argument_kind(FileDB& file_db, SymbolCache& symbol_cache, TypeCache& type_cache, Declaration* context, Expression* call, builtin_t builtin, std::uintmax_t index, type_t kind, const char* description) {
+  Expression* argument = call->arguments.at(index);
+  Type* argument_type = type_cache.expression_types[argument];
+  while (argument_type->kind == type_t::SYMBOL_TYPE)
+    argument_type = resolve_symbol_type(symbol_cache, context, argument_type).first;
+
+  // bools are 1-bit integers
+  if (argument_type->kind == kind || (kind == type_t::INTEGER_TYPE && argument_type->kind == type_t::BOOLEAN_TYPE)) {
+    return true;
+  }
+  throw_builtin_argument_has_wrong_type(file_db, file_db.expression_point(argument), context, builtin, argument_type, description);
+  return false;
+}
+
+inline bool check_builtin_argument_literal(FileDB& file_db, Declaration* context, Expression* call, builtin_t builtin, std::uintmax_t index, std::intmax_t min, std::intmax_t max) {
+  Expression* argument = call->arguments.at(index);
+  if (argument->kind == expression_t::INTEGER_EXPR && argument->integer_literal >= min && argument->integer_literal <= max) {
+    return true;
+  }
+  throw_builtin_argument_should_be_an_integer_literal(file_db, file_db.expression_point(argument), context, builtin, min, max);
+  return false;
+}
+
+// whether each operand of the expressions being checked was well typed, operands are checked before their parent
+using OperandsOk = std::unordered_map<Expression*, bool>;
+
+bool check_builtin_call_types(FileDB& file_db, SymbolCache& symbol_cache, TypeCache& type_cache, Declaration* context, Expression* expr, builtin_t builtin, const OperandsOk& operands_ok) {
+  bool type_check_ok = true;
+  for (Expression* argument : expr->arguments) {
+    type_check_ok &= operands_ok.at(argument);
+  }
+
+  if (expr->arguments.size() != get_builtin_arity(builtin)) {
+    throw_wrong_builtin_argument_number(file_db, file_db.expression_point(expr), context, builtin);
+    // for debug purposes
+    Type* type = Type::New(type_t::VOID_TYPE);
+    type_cache.expression_types[expr] = type;
+    return false;
+  }
+
+  switch (builtin) {
+    case EXPECT_BUILTIN:
+      type_check_ok &= check_builtin_argument_kind(file_db, symbol_cache, type_cache, context, expr, builtin, 0, type_t::INTEGER_TYPE, "an integer");
+      type_check_ok &= check_builtin_argument_kind(file_db, symbol_cache, type_cache, context, expr, builtin, 1, type_t::INTEGER_TYPE, "an integer");
+      type_cache.expression_types[expr] = Type::Clone(type_cache.expression_types[expr->arguments.at(0)]);
+      break;
+    case PREFETCH_BUILTIN:
+      type_check_ok &= check_builtin_argument_kind(file_db, symbol_cache, type_cache, context, expr, builtin, 0, type_t::POINTER_TYPE, "a pointer");
+      // read (0) or write (1)
+      type_check_ok &= check_builtin_argument_literal(file_db, context, expr, builtin, 1, 0, 1);
+      // locality, from none (0) to keep in all caches (3)
+      type_check_ok &= check_builtin_argument_literal(file_db, context, expr, builtin, 2, 0, 3);
+      type_cache.expression_types[expr] = Type::New(type_t::VOID_TYPE);
+      break;
+    case ASSUME_BUILTIN:
+      type_check_ok &= check_builtin_argument_kind(file_db, symbol_cache, type_cache, context, expr, builtin, 0, type_t::BOOLEAN_TYPE, "a bool");
+      type_cache.expression_types[expr] = Type::New(type_t::VOID_TYPE);
+      break;
+    case POPCOUNT_BUILTIN:
+    case CLZ_BUILTIN:
+    case CTZ_BUILTIN:
+      type_check_ok &= check_builtin_argument_kind(file_db, symbol_cache, type_cache, context, expr, builtin, 0, type_t::INTEGER_TYPE, "an integer");
+      type_cache.expression_types[expr] = Type::Clone(type_cache.expression_types[expr->arguments.at(0)]);
+      break;
+    case ROTL_BUILTIN:
+    case ROTR_BUILTIN:
+      type_check_ok &= check_builtin_argument_kind(file_db, symbol_cache, type_cache, context, expr, builtin, 0, type_t::INTEGER_TYPE, "an integer");
+      type_check_ok &= check_builtin_argument_kind(file_db, symbol_cache, type_cache, context, expr, builtin, 1, type_t::INTEGER_TYPE, "an integer");
+      type_cache.expression_types[expr] = Type::Clone(type_cache.expression_types[expr->arguments.at(0)]);
+      break;
+    case FSHL_BUILTIN:
+    case FSHR_BUILTIN:
+      type_check_ok &= check_builtin_argument_kind(file_db, symbol_cache, type_cache, context, expr, builtin, 0, type_t::INTEGER_TYPE, "an integer");
+      type_check_ok &= check_builtin_argument_kind(file_db, symbol_cache, type_cache, context, expr, builtin, 1, type_t::INTEGER_TYPE, "an integer");
+      type_check_ok &= check_builtin_argument_kind(file_db, symbol_cache, type_cache, context, expr, builtin, 2, type_t::INTEGER_TYPE, "an integer");
+      type_cache.expression_types[expr] = Type::Clone(type_cache.expression_types[expr->arguments.at(0)]);
+      break;
+    case MEMCPY_BUILTIN:
+      type_check_ok &= check_builtin_argument_kind(file_db, symbol_cache, type_cache, context, expr, builtin, 0, type_t::POINTER_TYPE, "a pointer");
+      type_check_ok &= check_builtin_argument_kind(file_db, symbol_cache, type_cache, context, expr, builtin, 1, type_t::POINTER_TYPE, "a pointer");
+      type_check_ok &= check_builtin_argument_kind(file_db, symbol_cache, type_cache, context, expr, builtin, 2, type_t::INTEGER_TYPE, "an integer");
+      type_cache.expression_types[expr] = Type::New(type_t::VOID_TYPE);
+      break;
+    case MEMSET_BUILTIN:
+      type_check_ok &= check_builtin_argument_kind(file_db, symbol_cache, type_cache, context, expr, builtin, 0, type_t::POINTER_TYPE, "a pointer");
+      type_check_ok &= check_builtin_argument_kind(file_db, symbol_cache, type_cache, context, expr, builtin, 1, type_t::INTEGER_TYPE, "an integer");
+      type_check_ok &= check_builtin_argument_kind(file_db, symbol_cache, type_cache, context, expr, builtin, 2, type_t::INTEGER_TYPE, "an integer");
+      type_cache.expression_types[expr] = Type::New(type_t::VOID_TYPE);
+      break;
+  }
+  return type_check_ok;
+}
+
+// the first operand was checked by the caller, with first_operand_ok as its result
+bool check_single_expression(FileDB& file_db, SymbolCache& symbol_cache, TypeCache& type_cache, Declaration* context, Expression* expr, bool first_operand_ok, const OperandsOk& operands_ok) {
   bool type_check_ok = true;
   
   switch (expr->kind) {
@@ -105,7 +242,7 @@ bool check_types(FileDB& file_db, SymbolCache& symbol_cache, TypeCache& type_cac
                 Type* type = Type::Clone(query_decl->type);
                 type_cache.expression_types[expr] = type;
               } else {// = declaration_t::MODULE_DECL
-                throw_module_has_no_type_error(file_db, file_db.expression_points[expr], context, expr->symbol);
+                throw_module_has_no_type_error(file_db, file_db.expression_point(expr), context, expr->symbol);
                 type_check_ok = false;
                 // for debug
                 Type* type = Type::New(type_t::VOID_TYPE);
@@ -165,7 +302,11 @@ bool check_types(FileDB& file_db, SymbolCache& symbol_cache, TypeCache& type_cac
       break;
     case expression_t::CALL_EXPR:
       {
-        type_check_ok &= check_types(file_db, symbol_cache, type_cache, context, expr->callable);
+        if (const builtin_t* builtin = symbol_cache.get_builtin(expr->callable)) {
+          type_check_ok &= check_builtin_call_types(file_db, symbol_cache, type_cache, context, expr, *builtin, operands_ok);
+          break;
+        }
+        type_check_ok &= operands_ok.at(expr->callable);
         Type* callable_type = type_cache.expression_types[expr->callable];
         Declaration* callable_decl = context;
         while (callable_type->kind == SYMBOL_TYPE) {
@@ -177,18 +318,18 @@ bool check_types(FileDB& file_db, SymbolCache& symbol_cache, TypeCache& type_cac
            || (callable_type->parameters.size() <= expr->arguments.size() && callable_type->is_variadic)) {
             for (std::uintmax_t argument_index = 0; argument_index < expr->arguments.size(); ++argument_index) {
               Expression* argument = expr->arguments.at(argument_index);
-              type_check_ok &= check_types(file_db, symbol_cache, type_cache, context, argument);
+              type_check_ok &= operands_ok.at(argument);
               if (argument_index < callable_type->parameters.size()) {
                 Type* argument_type = type_cache.expression_types[argument];
                 Type* parameter_type = callable_type->parameters.at(argument_index).second;
                 if (!type_can_be_implicitly_casted_to(symbol_cache, context, argument_type, parameter_type)) {
-                  throw_type_is_not_implicitly_castable_to(file_db, file_db.expression_points[argument], context, argument_type, parameter_type);
+                  throw_type_is_not_implicitly_castable_to(file_db, file_db.expression_point(argument), context, argument_type, parameter_type);
                   type_check_ok = false;
                 }
               }
             }
           } else {
-            throw_wrong_parameter_number_error(file_db, file_db.expression_points[expr], context, callable_type);
+            throw_wrong_parameter_number_error(file_db, file_db.expression_point(expr), context, callable_type);
             type_check_ok = false;
           }
           type_cache.expression_types[expr] = Type::Clone(callable_type->subtype);
@@ -196,31 +337,31 @@ bool check_types(FileDB& file_db, SymbolCache& symbol_cache, TypeCache& type_cac
           // for debug purposes
           Type* type = Type::New(type_t::VOID_TYPE);
           type_cache.expression_types[expr] = type;
-          throw_type_is_not_callable_error(file_db, file_db.expression_points[expr], context, callable_type);
+          throw_type_is_not_callable_error(file_db, file_db.expression_point(expr), context, callable_type);
           type_check_ok = false;
         }
       }
       break;
     case expression_t::ARRAY_ACCESS_EXPR:
       {
-        type_check_ok &= check_types(file_db, symbol_cache, type_cache, context, expr->left);
+        type_check_ok &= first_operand_ok;
         Type* left_type = type_cache.expression_types[expr->left];
         while (left_type->kind == type_t::SYMBOL_TYPE)
           left_type = resolve_symbol_type(symbol_cache, context, left_type).first;
 
-        type_check_ok &= check_types(file_db, symbol_cache, type_cache, context, expr->right);
+        type_check_ok &= operands_ok.at(expr->right);
         Type* right_type = type_cache.expression_types[expr->right];
         while (right_type->kind == type_t::SYMBOL_TYPE)
           right_type = resolve_symbol_type(symbol_cache, context, right_type).first;
 
-        if (left_type->kind != type_t::ARRAY_TYPE && left_type->kind != type_t::POINTER_TYPE) {
-            throw_left_operand_of_array_access_should_be_a_pointer_or_an_array(file_db, file_db.expression_points[expr], context, left_type);
+        if (left_type->kind != type_t::ARRAY_TYPE && left_type->kind != type_t::POINTER_TYPE && left_type->kind != type_t::VECTOR_TYPE) {
+            throw_left_operand_of_array_access_should_be_a_pointer_or_an_array(file_db, file_db.expression_point(expr), context, left_type);
             type_check_ok = false;
             Type* type = Type::New(type_t::VOID_TYPE);
             type_cache.expression_types[expr] = type;
         }
         if (right_type->kind != type_t::INTEGER_TYPE) {
-            throw_right_operand_of_array_access_should_be_an_integer(file_db, file_db.expression_points[expr], context, right_type);
+            throw_right_operand_of_array_access_should_be_an_integer(file_db, file_db.expression_point(expr), context, right_type);
             type_check_ok = false;
             Type* type = Type::New(type_t::VOID_TYPE);
             type_cache.expression_types[expr] = type;
@@ -237,13 +378,13 @@ bool check_types(FileDB& file_db, SymbolCache& symbol_cache, TypeCache& type_cac
       }
     case expression_t::BINARY_EXPR:
       {
-        type_check_ok &= check_types(file_db, symbol_cache, type_cache, context, expr->left);
+        type_check_ok &= first_operand_ok;
         Type* left_type = type_cache.expression_types[expr->left];
         Type* original_left_type = left_type;
 
         if (expr->operator_ == ARR_OP) {
           if (expr->right->kind != expression_t::SYMBOL_EXPR) {
-            throw_right_operand_of_arrow_operator_should_be_a_symbol(file_db, file_db.expression_points[expr], context);
+            throw_right_operand_of_arrow_operator_should_be_a_symbol(file_db, file_db.expression_point(expr), context);
             type_check_ok = false;
             Type* type = Type::New(type_t::VOID_TYPE);
             type_cache.expression_types[expr] = type;
@@ -252,7 +393,7 @@ bool check_types(FileDB& file_db, SymbolCache& symbol_cache, TypeCache& type_cac
               left_type = resolve_symbol_type(symbol_cache, context, left_type).first;
             if (left_type->kind != type_t::POINTER_TYPE) {
               Type::Print(std::clog << "DEBUG: ", original_left_type) << std::endl;
-              throw_left_operand_of_arrow_operator_should_be_a_pointer(file_db, file_db.expression_points[expr], context, left_type);
+              throw_left_operand_of_arrow_operator_should_be_a_pointer(file_db, file_db.expression_point(expr), context, left_type);
               type_check_ok = false;
               Type* type = Type::New(type_t::VOID_TYPE);
               type_cache.expression_types[expr] = type;
@@ -261,14 +402,14 @@ bool check_types(FileDB& file_db, SymbolCache& symbol_cache, TypeCache& type_cac
               if (left_type->kind == type_t::SYMBOL_TYPE)
                 left_type = resolve_symbol_type(symbol_cache, context, left_type).first;
               if (left_type->kind != type_t::STRUCT_TYPE) {
-                throw_pointed_left_operand_of_arrow_operator_should_be_a_struct(file_db, file_db.expression_points[expr], context, left_type);
+                throw_pointed_left_operand_of_arrow_operator_should_be_a_struct(file_db, file_db.expression_point(expr), context, left_type);
                 type_check_ok = false;
                 Type* type = Type::New(type_t::VOID_TYPE);
                 type_cache.expression_types[expr] = type;
               } else {
                 Type* field_type = Type::ExtractField(left_type, expr->right->symbol);
                 if (field_type == nullptr) {
-                  throw_struct_has_not_named_field(file_db, file_db.expression_points[expr], context, left_type, expr->right->symbol);
+                  throw_struct_has_not_named_field(file_db, file_db.expression_point(expr), context, left_type, expr->right->symbol);
                   type_check_ok = false;
                   Type* type = Type::New(type_t::VOID_TYPE);
                   type_cache.expression_types[expr] = type;
@@ -281,7 +422,7 @@ bool check_types(FileDB& file_db, SymbolCache& symbol_cache, TypeCache& type_cac
           }
         } else if (expr->operator_ == DOT_OP) {
           if (expr->right->kind != expression_t::SYMBOL_EXPR) {
-            throw_right_operand_of_dot_operator_should_be_a_symbol(file_db, file_db.expression_points[expr], context);
+            throw_right_operand_of_dot_operator_should_be_a_symbol(file_db, file_db.expression_point(expr), context);
             type_check_ok = false;
             Type* type = Type::New(type_t::VOID_TYPE);
             type_cache.expression_types[expr] = type;
@@ -289,14 +430,14 @@ bool check_types(FileDB& file_db, SymbolCache& symbol_cache, TypeCache& type_cac
             if (left_type->kind == type_t::SYMBOL_TYPE)
               left_type = resolve_symbol_type(symbol_cache, context, left_type).first;
             if (left_type->kind != type_t::STRUCT_TYPE) {
-              throw_left_operand_of_dot_operator_should_be_a_struct(file_db, file_db.expression_points[expr], context, left_type);
+              throw_left_operand_of_dot_operator_should_be_a_struct(file_db, file_db.expression_point(expr), context, left_type);
               type_check_ok = false;
               Type* type = Type::New(type_t::VOID_TYPE);
               type_cache.expression_types[expr] = type;
             } else {
               Type* field_type = Type::ExtractField(left_type, expr->right->symbol);
               if (field_type == nullptr) {
-                throw_struct_has_not_named_field(file_db, file_db.expression_points[expr], context, left_type, expr->right->symbol);
+                throw_struct_has_not_named_field(file_db, file_db.expression_point(expr), context, left_type, expr->right->symbol);
                 type_check_ok = false;
                 Type* type = Type::New(type_t::VOID_TYPE);
                 type_cache.expression_types[expr] = type;
@@ -307,36 +448,51 @@ bool check_types(FileDB& file_db, SymbolCache& symbol_cache, TypeCache& type_cac
             }
           }
         } else if (expr->operator_ == ASS_OP) {
-          type_check_ok &= check_types(file_db, symbol_cache, type_cache, context, expr->right);
+          type_check_ok &= operands_ok.at(expr->right);
           Type* right_type = type_cache.expression_types[expr->right];
 
           if (!type_can_be_implicitly_casted_to(symbol_cache, context, right_type, left_type)) {
-            throw_type_is_not_implicitly_castable_to(file_db, file_db.expression_points[expr], context, right_type, left_type);
+            throw_type_is_not_implicitly_castable_to(file_db, file_db.expression_point(expr), context, right_type, left_type);
+            type_check_ok = false;
+          }
+          if (Declaration* constant = find_constant_static_of_place(symbol_cache, type_cache, context, expr->left)) {
+            throw_constant_static_variable_cannot_be_assigned(file_db, file_db.expression_point(expr), context, constant);
             type_check_ok = false;
           }
           Type* type = Type::Clone(left_type);
           type_cache.expression_types[expr] = type;
         } else if (is_algebraic_operator(expr->operator_)) {
-          type_check_ok &= check_types(file_db, symbol_cache, type_cache, context, expr->right);
+          type_check_ok &= operands_ok.at(expr->right);
           Type* right_type = type_cache.expression_types[expr->right];
 
           if (types_are_algebraically_manipulable(symbol_cache, context, left_type, right_type)) {
             type_cache.expression_types[expr] = decide_algebric_binop_type(symbol_cache, context, left_type, right_type);
           } else {
-            throw_types_cannot_be_algebraically_manipulated_error(file_db, file_db.expression_points[expr], context, left_type, right_type);
+            throw_types_cannot_be_algebraically_manipulated_error(file_db, file_db.expression_point(expr), context, left_type, right_type);
             type_check_ok = false;
             Type* type = Type::New(type_t::VOID_TYPE);
             type_cache.expression_types[expr] = type;
           }
         } else if (is_logical_operator(expr->operator_)) {
-          type_check_ok &= check_types(file_db, symbol_cache, type_cache, context, expr->right);
+          type_check_ok &= operands_ok.at(expr->right);
           Type* right_type = type_cache.expression_types[expr->right];
 
           if (types_are_logically_manipulable(symbol_cache, context, left_type, right_type)) {
-            Type* type = Type::New(type_t::BOOLEAN_TYPE);
-            type_cache.expression_types[expr] = type;
+            Type* resolved_left_type = left_type;
+            while (resolved_left_type->kind == type_t::SYMBOL_TYPE)
+              resolved_left_type = resolve_symbol_type(symbol_cache, context, resolved_left_type).first;
+            if (resolved_left_type->kind == type_t::VECTOR_TYPE) {
+              // element-wise, produces a mask
+              Type* type = Type::New(type_t::VECTOR_TYPE);
+              type->size = resolved_left_type->size;
+              type->subtype = Type::New(type_t::BOOLEAN_TYPE);
+              type_cache.expression_types[expr] = type;
+            } else {
+              Type* type = Type::New(type_t::BOOLEAN_TYPE);
+              type_cache.expression_types[expr] = type;
+            }
           } else {
-            throw_types_cannot_be_logically_manipulated_error(file_db, file_db.expression_points[expr], context, left_type, right_type);
+            throw_types_cannot_be_logically_manipulated_error(file_db, file_db.expression_point(expr), context, left_type, right_type);
             type_check_ok = false;
             Type* type = Type::New(type_t::VOID_TYPE);
             type_cache.expression_types[expr] = type;
@@ -348,7 +504,7 @@ bool check_types(FileDB& file_db, SymbolCache& symbol_cache, TypeCache& type_cac
       break;
     case expression_t::MONARY_EXPR:
       {
-        type_check_ok &= check_types(file_db, symbol_cache, type_cache, context, expr->value);
+        type_check_ok &= first_operand_ok;
         Type* value_type = type_cache.expression_types[expr->value];
         while (value_type->kind == type_t::SYMBOL_TYPE) {
           value_type = resolve_symbol_type(symbol_cache, context, value_type).first;
@@ -361,7 +517,7 @@ bool check_types(FileDB& file_db, SymbolCache& symbol_cache, TypeCache& type_cac
                 Type* type = Type::Clone(value_type->subtype);
                 type_cache.expression_types[expr] = type;
               } else {
-                throw_type_is_not_dereferenceable_error(file_db, file_db.expression_points[expr], context, value_type);
+                throw_type_is_not_dereferenceable_error(file_db, file_db.expression_point(expr), context, value_type);
                 type_check_ok = false;
                 Type* type = Type::New(type_t::VOID_TYPE);
                 type_cache.expression_types[expr] = type;
@@ -370,6 +526,23 @@ bool check_types(FileDB& file_db, SymbolCache& symbol_cache, TypeCache& type_cac
             break;
           case operator_t::AND_OP: // &
             {
+              // pointers are writable, a constant static is emitted read-only
+              if (Declaration* constant = find_constant_static_of_place(symbol_cache, type_cache, context, expr->value)) {
+                throw_constant_static_variable_cannot_be_addressed(file_db, file_db.expression_point(expr), context, constant);
+                type_check_ok = false;
+              }
+              if (expr->value->kind == expression_t::ARRAY_ACCESS_EXPR) {
+                Type* array_type = type_cache.expression_types[expr->value->left];
+                while (array_type->kind == type_t::SYMBOL_TYPE)
+                  array_type = resolve_symbol_type(symbol_cache, context, array_type).first;
+                Type* lane_type = array_type->subtype;
+                while (lane_type != nullptr && lane_type->kind == type_t::SYMBOL_TYPE)
+                  lane_type = resolve_symbol_type(symbol_cache, context, lane_type).first;
+                if (array_type->kind == type_t::VECTOR_TYPE && lane_type->kind == type_t::BOOLEAN_TYPE) {
+                  throw_lane_of_boolean_vector_is_not_addressable(file_db, file_db.expression_point(expr), context);
+                  type_check_ok = false;
+                }
+              }
               Type* type = Type::New(type_t::POINTER_TYPE);
               type->subtype = Type::Clone(value_type);
               type_cache.expression_types[expr] = type;
@@ -382,7 +555,7 @@ bool check_types(FileDB& file_db, SymbolCache& symbol_cache, TypeCache& type_cac
                   Type* type = Type::Clone(value_type);
                   type_cache.expression_types[expr] = type;
                 } else {
-                  throw_type_cannot_be_algebraically_manipulated_error(file_db, file_db.expression_points[expr], context, value_type);
+                  throw_type_cannot_be_algebraically_manipulated_error(file_db, file_db.expression_point(expr), context, value_type);
                   type_check_ok = false;
                   Type* type = Type::New(type_t::VOID_TYPE);
                   type_cache.expression_types[expr] = type;
@@ -392,7 +565,7 @@ bool check_types(FileDB& file_db, SymbolCache& symbol_cache, TypeCache& type_cac
                   Type* type = Type::New(type_t::BOOLEAN_TYPE);
                   type_cache.expression_types[expr] = type;
                 } else {
-                  throw_type_cannot_be_logically_manipulated_error(file_db, file_db.expression_points[expr], context, value_type);
+                  throw_type_cannot_be_logically_manipulated_error(file_db, file_db.expression_point(expr), context, value_type);
                   type_check_ok = false;
                   Type* type = Type::New(type_t::VOID_TYPE);
                   type_cache.expression_types[expr] = type;
@@ -415,7 +588,7 @@ bool check_types(FileDB& file_db, SymbolCache& symbol_cache, TypeCache& type_cac
       break;
     case expression_t::CAST_EXPR:
       {
-        type_check_ok &= check_types(file_db, symbol_cache, type_cache, context, expr->value);
+        type_check_ok &= first_operand_ok;
         // Type* value_type = type_cache.expression_types[expr->value];
         // Type* casted_type = expr->type;
         // TODO: check if value_type can be explicitly casted to casted_type
@@ -424,7 +597,7 @@ bool check_types(FileDB& file_db, SymbolCache& symbol_cache, TypeCache& type_cac
       break;
     case expression_t::BITCAST_EXPR:
       {
-        type_check_ok &= check_types(file_db, symbol_cache, type_cache, context, expr->value);
+        type_check_ok &= first_operand_ok;
         // Type* value_type = type_cache.expression_types[expr->value];
         // Type* casted_type = expr->type;
         // by definition, every type can always be explicitly bit-casted to another type
@@ -436,10 +609,214 @@ bool check_types(FileDB& file_db, SymbolCache& symbol_cache, TypeCache& type_cac
         type_cache.expression_types[expr] = Type::Clone(expr->type);
       }
       break;
+    case expression_t::VECTOR_LOAD_EXPR:
+      {
+        type_check_ok &= first_operand_ok;
+        Type* pointer_type = type_cache.expression_types[expr->value];
+        while (pointer_type->kind == type_t::SYMBOL_TYPE)
+          pointer_type = resolve_symbol_type(symbol_cache, context, pointer_type).first;
+        Type* vector_type = expr->type;
+        while (vector_type->kind == type_t::SYMBOL_TYPE)
+          vector_type = resolve_symbol_type(symbol_cache, context, vector_type).first;
+
+        if (pointer_type->kind != type_t::POINTER_TYPE) {
+          throw_type_is_not_dereferenceable_error(file_db, file_db.expression_point(expr), context, pointer_type);
+          type_check_ok = false;
+        }
+        if (vector_type->kind != type_t::VECTOR_TYPE) {
+          throw_operand_should_be_a_vector(file_db, file_db.expression_point(expr), context, vector_type);
+          type_check_ok = false;
+        } else if (pointer_type->kind == type_t::POINTER_TYPE && !types_are_structurally_equal(symbol_cache, context, pointer_type->subtype, context, vector_type->subtype)) {
+          throw_vector_pointer_should_point_to_the_element_type(file_db, file_db.expression_point(expr->value), context, pointer_type, vector_type->subtype);
+          type_check_ok = false;
+        }
+        type_cache.expression_types[expr] = Type::Clone(expr->type);
+      }
+      break;
+    case expression_t::VECTOR_STORE_EXPR:
+      {
+        type_check_ok &= first_operand_ok;
+        Type* pointer_type = type_cache.expression_types[expr->left];
+        while (pointer_type->kind == type_t::SYMBOL_TYPE)
+          pointer_type = resolve_symbol_type(symbol_cache, context, pointer_type).first;
+
+        type_check_ok &= operands_ok.at(expr->right);
+        Type* vector_type = type_cache.expression_types[expr->right];
+        while (vector_type->kind == type_t::SYMBOL_TYPE)
+          vector_type = resolve_symbol_type(symbol_cache, context, vector_type).first;
+
+        if (pointer_type->kind != type_t::POINTER_TYPE) {
+          throw_type_is_not_dereferenceable_error(file_db, file_db.expression_point(expr), context, pointer_type);
+          type_check_ok = false;
+        }
+        if (vector_type->kind != type_t::VECTOR_TYPE) {
+          throw_operand_should_be_a_vector(file_db, file_db.expression_point(expr), context, vector_type);
+          type_check_ok = false;
+        } else if (pointer_type->kind == type_t::POINTER_TYPE && !types_are_structurally_equal(symbol_cache, context, pointer_type->subtype, context, vector_type->subtype)) {
+          throw_vector_pointer_should_point_to_the_element_type(file_db, file_db.expression_point(expr->left), context, pointer_type, vector_type->subtype);
+          type_check_ok = false;
+        }
+        Type* type = Type::New(type_t::VOID_TYPE);
+        type_cache.expression_types[expr] = type;
+      }
+      break;
+    case expression_t::VECTOR_SHUFFLE_EXPR:
+      {
+        type_check_ok &= first_operand_ok;
+        Type* left_type = type_cache.expression_types[expr->left];
+        while (left_type->kind == type_t::SYMBOL_TYPE)
+          left_type = resolve_symbol_type(symbol_cache, context, left_type).first;
+
+        type_check_ok &= operands_ok.at(expr->right);
+        Type* right_type = type_cache.expression_types[expr->right];
+        while (right_type->kind == type_t::SYMBOL_TYPE)
+          right_type = resolve_symbol_type(symbol_cache, context, right_type).first;
+
+        if (left_type->kind != type_t::VECTOR_TYPE) {
+          throw_operand_should_be_a_vector(file_db, file_db.expression_point(expr->left), context, left_type);
+          type_check_ok = false;
+          Type* type = Type::New(type_t::VOID_TYPE);
+          type_cache.expression_types[expr] = type;
+        } else if (!types_are_structurally_equal(symbol_cache, context, left_type, context, right_type)) {
+          throw_vector_operands_should_have_the_same_type(file_db, file_db.expression_point(expr), context, left_type, right_type);
+          type_check_ok = false;
+          Type* type = Type::New(type_t::VOID_TYPE);
+          type_cache.expression_types[expr] = type;
+        } else if (expr->arguments.empty()) {
+          throw_shuffle_mask_should_not_be_empty(file_db, file_db.expression_point(expr), context);
+          type_check_ok = false;
+          Type* type = Type::New(type_t::VOID_TYPE);
+          type_cache.expression_types[expr] = type;
+        } else {
+          // lanes of both operands are addressable
+          std::uintmax_t lanes = left_type->size * 2;
+          for (Expression* lane : expr->arguments) {
+            if (lane->kind != expression_t::INTEGER_EXPR || lane->integer_literal < 0 || (std::uintmax_t)lane->integer_literal >= lanes) {
+              throw_shuffle_mask_should_contain_constant_lane_indexes(file_db, file_db.expression_point(lane), context, lanes);
+              type_check_ok = false;
+            }
+          }
+          Type* type = Type::New(type_t::VECTOR_TYPE);
+          type->size = expr->arguments.size();
+          type->subtype = Type::Clone(left_type->subtype);
+          type_cache.expression_types[expr] = type;
+        }
+      }
+      break;
+    case expression_t::AGGREGATE_LITERAL_EXPR:
+      {
+        Type* aggregate_type = expr->type;
+        while (aggregate_type->kind == type_t::SYMBOL_TYPE)
+          aggregate_type = resolve_symbol_type(symbol_cache, context, aggregate_type).first;
+
+        std::uintmax_t capacity = 0;
+        bool is_aggregate = true;
+        if (aggregate_type->kind == type_t::ARRAY_TYPE) {
+          capacity = aggregate_type->size;
+        } else if (aggregate_type->kind == type_t::STRUCT_TYPE) {
+          capacity = aggregate_type->fields.size();
+        } else {
+          throw_aggregate_literal_type_should_be_an_array_or_a_struct(file_db, file_db.expression_point(expr), context, expr->type);
+          type_check_ok = false;
+          is_aggregate = false;
+        }
+        if (expr->arguments.size() > capacity && is_aggregate) {
+          throw_aggregate_literal_has_too_many_elements(file_db, file_db.expression_point(expr), context, expr->type, capacity);
+          type_check_ok = false;
+        }
+        for (std::uintmax_t index = 0; index < expr->arguments.size(); ++index) {
+          Expression* element = expr->arguments[index];
+          type_check_ok &= operands_ok.at(element);
+          if (index >= capacity)
+            continue;
+          Type* element_type = type_cache.expression_types[element];
+          Type* slot_type = aggregate_type->kind == type_t::ARRAY_TYPE ? aggregate_type->subtype : aggregate_type->fields[index].second;
+          if (!type_can_be_implicitly_casted_to(symbol_cache, context, element_type, slot_type)) {
+            throw_type_is_not_implicitly_castable_to(file_db, file_db.expression_point(element), context, element_type, slot_type);
+            type_check_ok = false;
+          }
+        }
+        type_cache.expression_types[expr] = Type::Clone(expr->type);
+      }
+      break;
+  }
+  // folding is decided in the same post-order visit, while the operands are still at hand
+  if (type_check_ok && context->kind == declaration_t::FUNCTION_DECL) {
+    mark_foldable_in_body(symbol_cache, type_cache, context, expr);
   }
   return type_check_ok;
 }
 
+// operand checked before anything else in the expression, nullptr when there is none
+Expression* find_first_operand(Expression* expr) {
+  switch (expr->kind) {
+    case expression_t::MONARY_EXPR:
+    case expression_t::CAST_EXPR:
+    case expression_t::BITCAST_EXPR:
+    case expression_t::VECTOR_LOAD_EXPR:
+      return expr->value;
+    case expression_t::VECTOR_STORE_EXPR:
+    case expression_t::VECTOR_SHUFFLE_EXPR:
+    case expression_t::ARRAY_ACCESS_EXPR:
+    case expression_t::BINARY_EXPR:
+      return expr->left;
+    default:
+      return nullptr;
+  }
+}
+
+// operands a node types through check_types, in source order
+void collect_checked_operands(SymbolCache& symbol_cache, Expression* expr, std::vector<Expression*>& operands) {
+  if (Expression* first = find_first_operand(expr))
+    operands.push_back(first);
+  switch (expr->kind) {
+    case expression_t::VECTOR_STORE_EXPR:
+    case expression_t::VECTOR_SHUFFLE_EXPR:
+    case expression_t::ARRAY_ACCESS_EXPR:
+      operands.push_back(expr->right);
+      break;
+    case expression_t::BINARY_EXPR:
+      // fields after . and -> are names, not operands
+      if (expr->operator_ != DOT_OP && expr->operator_ != ARR_OP)
+        operands.push_back(expr->right);
+      break;
+    case expression_t::CALL_EXPR:
+      if (!symbol_cache.get_builtin(expr->callable))
+        operands.push_back(expr->callable);
+      operands.insert(operands.end(), expr->arguments.begin(), expr->arguments.end());
+      break;
+    case expression_t::AGGREGATE_LITERAL_EXPR:
+      operands.insert(operands.end(), expr->arguments.begin(), expr->arguments.end());
+      break;
+    default:
+      break;
+  }
+}
+
+// operands are typed bottom-up from an explicit stack, so nesting on either side is bounded by memory and not by stack size
+bool check_types(FileDB& file_db, SymbolCache& symbol_cache, TypeCache& type_cache, Declaration* context, Expression* expr) {
+  OperandsOk operands_ok;
+  std::vector<std::pair<Expression*, bool>> stack = {{expr, false}};
+  std::vector<Expression*> operands;
+  while (!stack.empty()) {
+    auto [node, operands_checked] = stack.back();
+    stack.pop_back();
+    if (operands_checked) {
+      Expression* first = find_first_operand(node);
+      bool first_operand_ok = first == nullptr || operands_ok.at(first);
+      operands_ok[node] = check_single_expression(file_db, symbol_cache, type_cache, context, node, first_operand_ok, operands_ok);
+      continue;
+    }
+    stack.push_back({node, true});
+    operands.clear();
+    collect_checked_operands(symbol_cache, node, operands);
+    for (auto it = operands.rbegin(); it != operands.rend(); ++it) {
+      stack.push_back({*it, false});
+    }
+  }
+  return operands_ok.at(expr);
+}
+
 bool check_types(FileDB& file_db, SymbolCache& symbol_cache, TypeCache& type_cache, Declaration* context, Statement* stmt) {
   bool type_check_ok = true;
 
@@ -460,12 +837,12 @@ bool check_types(FileDB& file_db, SymbolCache& symbol_cache, TypeCache& type_cac
           right_type = Type::New(type_t::VOID_TYPE);
         }
         if (!type_can_be_implicitly_casted_to(symbol_cache, context, right_type, return_type)) {
-          FileDB::Point& point = file_db.return_points[stmt];
+          FileDB::Point point = file_db.return_point(stmt);
           if (stmt->expr != nullptr) {
-            point = file_db.expression_points[stmt->expr];
+            point = file_db.expression_point(stmt->expr);
           }
 
-          throw_type_is_not_implicitly_castable_to(file_db, file_db.return_points[stmt], context, right_type, return_type);
+          throw_type_is_not_implicitly_castable_to(file_db, point, context, right_type, return_type);
           type_check_ok = false;
         }
         if (stmt->expr == nullptr) {
@@ -506,18 +883,18 @@ bool check_types(FileDB& file_db, SymbolCache& symbol_cache, TypeCache& type_cac
   return type_check_ok;
 }
 
-bool check_types(FileDB& file_db, SymbolCache& symbol_cache, TypeCache& type_cache, Declaration* decl) {
+bool check_declaration_types(FileDB& file_db, SymbolCache& symbol_cache, TypeCache& type_cache, Declaration* decl, std::vector<Declaration*>& functions) {
   bool type_check_ok = true;
 
   switch (decl->kind) {
     case declaration_t::FUNCTION_DECL:
       if (decl->body != nullptr) {
-        type_check_ok &= check_types(file_db, symbol_cache, type_cache, decl, decl->body);
+        functions.push_back(decl);
       }
       break;
     case declaration_t::MODULE_DECL:
       for (Declaration* child : decl->children) {
-        type_check_ok &= check_types(file_db, symbol_cache, type_cache, child);
+        type_check_ok &= check_declaration_types(file_db, symbol_cache, type_cache, child, functions);
       }
       break;
     case declaration_t::TYPE_DECL:
@@ -531,3 +908,35 @@ bool check_types(FileDB& file_db, SymbolCache& symbol_cache, TypeCache& type_cac
 
   return type_check_ok;
 }
+
+bool check_types(FileDB& file_db, SymbolCache& symbol_cache, TypeCache& type_cache, Declaration* decl) {
+  std::vector<Declaration*> functions;
+  bool type_check_ok = check_declaration_types(file_db, symbol_cache, type_cache, decl, functions);
+  // bodies are checked as they flow through the pipeline
+  if (API::STREAM_FUNCTIONS) {
+    return type_check_ok;
+  }
+
+  // a body only types its own expressions, so each one is checked into its own shard
+  std::unique_ptr<TypeCache[]> shards (new TypeCache[functions.size()]);
+  type_check_ok &= API::run_in_parallel(functions.size(), [&](std::uintmax_t index) {
+    return check_types(file_db, symbol_cache, shards[index], functions[index], functions[index]->body);
+  });
+  for (std::uintmax_t index = 0; index < functions.size(); ++index) {
+    TypeCache::Merge(type_cache, shards[index]);
+  }
+  return type_check_ok;
+}
+
+bool check_function_types(FileDB& file_db, SymbolCache& symbol_cache, TypeCache& type_cache, Declaration* function) {
+  auto it = type_cache.checked_functions.find(function);
+  if (it != type_cache.checked_functions.end()) {
+    return it->second;
+  }
+  bool type_check_ok = true;
+  if (function->body != nullptr) {
+    type_check_ok &= check_types(file_db, symbol_cache, type_cache, function, function->body);
+  }
+  type_cache.checked_functions[function] = type_check_ok;
+  return type_check_ok;
+}
@@ -14,4 +14,12 @@ void TypeCache::Delete(TypeCache& type_cache) {
     Type::Delete(item.second);
   }
   type_cache.expression_types = {};
+  type_cache.foldable = {};
+}
+
+void TypeCache::Merge(TypeCache& type_cache, TypeCache& shard) {
+  type_cache.expression_types.merge(shard.expression_types);
+  type_cache.foldable.merge(shard.foldable);
+  // types whose expression was already typed are left in shard
+  TypeCache::Delete(shard);
 }